@@ -50,6 +50,7 @@ LOCAL_SRC_FILES:= linux/src/api/MultiProc.c \
                   linux/src/api/gates/GateMP.c \
                   linux/src/api/gates/GateMutex.c \
                   linux/src/api/gates/GateHWSpinlock.c \
+                  linux/src/api/gates/GateProcess.c \
                   linux/src/heaps/HeapStd.c
 
 LOCAL_SHARED_LIBRARIES := \
@@ -162,6 +163,7 @@ LOCAL_MODULE_TAGS:= optional
 LOCAL_VENDOR_MODULE := true
 
 LOCAL_SRC_FILES:= linux/src/daemon/lad.c \
+                  linux/src/daemon/ladlog.c \
                   linux/src/daemon/Ipc_daemon.c \
                   linux/src/daemon/MessageQ_daemon.c \
                   linux/src/daemon/MultiProc_daemon.c \
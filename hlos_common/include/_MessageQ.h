@@ -170,6 +170,21 @@ Void MessageQ_setQueueOwner(MessageQ_Handle handle, Int pid);
 
 Void MessageQ_cleanupOwner(Int pid);
 
+/* Lease a block of count queue indexes to process pid. */
+Int MessageQ_lease(UInt16 count, Int pid, MessageQ_QueueId * baseId);
+
+/* Release all queue indexes leased to process pid. */
+Void MessageQ_releaseLeases(Int pid);
+
+/* Add/remove the name of a queue created on a leased index. */
+Int MessageQ_register(String name, MessageQ_QueueId queueId, Int pid);
+
+Int MessageQ_unregister(MessageQ_QueueId queueId, Int pid);
+
+/* Report size of the queue table, slots in use and slots leased out. */
+Void MessageQ_getIndexStats(UInt32 * numQueues, UInt32 * numUsed,
+        UInt32 * numLeased);
+
 Void MessageQ_msgInit(MessageQ_Msg msg);
 
 Void _MessageQ_setNumReservedEntries(UInt n);
@@ -59,6 +59,50 @@ extern "C" {
  */
 #define NAME_SERVER_RPMSG_ADDR 0
 
+/* Longest instance name reported by _NameServer_getInstanceStats() */
+#define NameServer_STATSNAMELEN 32
+
+/* =============================================================================
+ * Structures & Enums
+ * =============================================================================
+ */
+
+/*!
+ *  @brief      Size of one local NameServer instance
+ */
+typedef struct NameServer_InstanceStats {
+    Char    name[NameServer_STATSNAMELEN];
+    /*!< Instance name, truncated */
+    UInt32  numEntries;
+    /*!< Entries in the instance */
+    UInt32  tableSize;
+    /*!< Slots allocated in its hash table */
+} NameServer_InstanceStats;
+
+/*!
+ *  @brief      Remote lookups sent to one processor
+ *
+ *  Times are in nanoseconds and only cover queries that were sent.
+ */
+typedef struct NameServer_RemoteStats {
+    UInt32  queries;
+    /*!< Requests sent */
+    UInt32  found;
+    /*!< Replies with a value */
+    UInt32  notFound;
+    /*!< Replies without a value */
+    UInt32  timeouts;
+    /*!< Requests that got no reply in time */
+    UInt32  errors;
+    /*!< Requests that could not be sent */
+    UInt32  cacheHits;
+    /*!< Lookups answered by the negative cache, not sent */
+    UInt64  totalTime;
+    /*!< Sum of query latencies */
+    UInt64  maxTime;
+    /*!< Longest query latency */
+} NameServer_RemoteStats;
+
 /* =============================================================================
  * APIs
  * =============================================================================
@@ -95,6 +139,35 @@ Int NameServer_attach(UInt16 procId);
 /** @endcond INTERNAL */
 Int NameServer_detach(UInt16 procId);
 
+/** @cond INTERNAL */
+/*!
+ *  @brief      Set the lifetime (msec) of cached remote lookup misses
+ *
+ *  A value of 0 disables the negative lookup cache.  Only lookups the
+ *  remote processor answered with "not found" are cached.  A miss is
+ *  dropped when the remote processor announces that it added the name,
+ *  after @c msec, and on NameServer_attach()/detach() of the remote
+ *  processor.
+ */
+/** @endcond INTERNAL */
+Void _NameServer_setNegCacheTimeout(UInt msec);
+
+/** @cond INTERNAL */
+/*!
+ *  @brief      Get the size of the index'th local instance
+ *
+ *  @retval     NameServer_E_NOTFOUND   index is past the last instance
+ */
+/** @endcond INTERNAL */
+Int _NameServer_getInstanceStats(UInt index, NameServer_InstanceStats *stats);
+
+/** @cond INTERNAL */
+/*!
+ *  @brief      Get the remote lookup statistics for procId
+ */
+/** @endcond INTERNAL */
+Int _NameServer_getRemoteStats(UInt16 procId, NameServer_RemoteStats *stats);
+
 #if defined (__cplusplus)
 }
 #endif
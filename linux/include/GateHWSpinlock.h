@@ -152,6 +152,29 @@ typedef struct GateHWSpinlock_Object * GateHWSpinlock_Handle;
 /* Q_PREEMPTING */
 #define GateHWSem_Q_PREEMPTING (2)
 
+/*!
+ *  @brief  Lock registers are the hardware spinlock module, reached through
+ *          /dev/hwspinlock or mapped from /dev/mem.
+ */
+#define GateHWSpinlock_Backend_HW       0
+
+/*!
+ *  @brief  Lock registers are emulated by words in the shared memory file
+ *          GateHWSpinlock_SHMNAME, so GateMP can run on a plain host.
+ */
+#define GateHWSpinlock_Backend_SHM      1
+
+/*!
+ *  @brief  Name of the shared memory file of GateHWSpinlock_Backend_SHM.
+ */
+#define GateHWSpinlock_SHMNAME          "/tiipc_GateHWSpinlock"
+
+/*!
+ *  @brief  Number of hold time histogram buckets.  Bucket n counts hold
+ *          times below 2^n usec, the last bucket everything longer.
+ */
+#define GateHWSpinlock_STATSBUCKETS     16
+
 
 /* =============================================================================
  * Structures & Enums
@@ -169,8 +192,55 @@ typedef struct GateHWSpinlock_Config {
     /* Device-specific size for HW Semaphore subsystem */
     UInt32               offset;
     /* Device-specific size for HW Semaphore subsystem */
+    UInt32               backend;
+    /* GateHWSpinlock_Backend_HW or GateHWSpinlock_Backend_SHM.  The SHM
+     * backend ignores baseAddr, its file is size bytes long and the lock
+     * words start at offset, like the hardware mapping. */
 } GateHWSpinlock_Config;
 
+/*!
+ *  @brief  How a GateHWSpinlock waits for a lock held by someone else.
+ *
+ *  Failed lock attempts are first separated by a busy wait that starts at
+ *  spinMin and doubles up to spinMax relax loops, then by up to
+ *  yieldCount calls to sched_yield(), and from then on by sleeps of
+ *  sleepUsec.  This keeps a waiting core from flooding the interconnect
+ *  with lock register reads.
+ */
+typedef struct GateHWSpinlock_Backoff {
+    UInt32 spinMin;
+    /* Relax loops after the first failed attempt */
+    UInt32 spinMax;
+    /* Upper bound of the busy wait */
+    UInt32 yieldCount;
+    /* Attempts separated by sched_yield() after spinning */
+    UInt32 sleepUsec;
+    /* Sleep between attempts after yielding */
+} GateHWSpinlock_Backoff;
+
+/*!
+ *  @brief  Contention statistics of a GateHWSpinlock instance, as seen
+ *          by the calling process.  Times are in nsec.
+ */
+typedef struct GateHWSpinlock_Stats {
+    UInt32 numEnters;
+    /* Times the lock was acquired (nested enters are not counted) */
+    UInt32 numContended;
+    /* Acquisitions that found the lock taken at first */
+    UInt64 numSpins;
+    /* Failed lock attempts */
+    UInt32 numYields;
+    /* sched_yield() calls while backing off */
+    UInt32 numSleeps;
+    /* Sleeps while backing off */
+    UInt64 totalHoldTime;
+    /* Time the lock was held, summed over all acquisitions */
+    UInt64 maxHoldTime;
+    /* Longest time the lock was held */
+    UInt32 holdHist[GateHWSpinlock_STATSBUCKETS];
+    /* Hold times, log2 usec buckets */
+} GateHWSpinlock_Stats;
+
 /*!
  *  @brief  Structure defining config parameters for the GateHWSpinlock
  *          instances.
@@ -180,6 +250,7 @@ typedef struct GateHWSpinlock_Params {
     Bool   openFlag;
     UInt16 regionId;
     Ptr    sharedAddr;
+    GateHWSpinlock_Backoff backoff;
 } GateHWSpinlock_Params;
 
 
@@ -237,6 +308,24 @@ GateHWSpinlock_enter  (GateHWSpinlock_Handle handle);
 Int
 GateHWSpinlock_leave  (GateHWSpinlock_Handle handle, IArg   key);
 
+/* Function to enter the GateHWSpinlock instance only if it is free */
+Int
+GateHWSpinlock_tryEnter (GateHWSpinlock_Handle handle, IArg * key);
+
+/* Function to change how an instance backs off when the lock is taken */
+Int
+GateHWSpinlock_setBackoff (GateHWSpinlock_Handle handle,
+                           const GateHWSpinlock_Backoff * backoff);
+
+/* Function to get the contention statistics of an instance */
+Int
+GateHWSpinlock_getStats (GateHWSpinlock_Handle handle,
+                         GateHWSpinlock_Stats * stats);
+
+/* Function to clear the contention statistics of an instance */
+Int
+GateHWSpinlock_resetStats (GateHWSpinlock_Handle handle);
+
 /*!
  *  @brief      Function to return the number of instances configured in the
  *              module.
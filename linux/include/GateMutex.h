@@ -123,6 +123,9 @@ GateMutex_create (const GateMutex_Params * params, Error_Block *eb);
 /* Function to delete a Gate Mutex */
 Int GateMutex_delete (GateMutex_Handle * gmHandle);
 
+/* Function to enter a Gate Mutex only if no other thread holds it */
+Int GateMutex_tryEnter (GateMutex_Handle gmHandle, IArg * key);
+
 
 #if defined (__cplusplus)
 }
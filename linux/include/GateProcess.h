@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== GateProcess.h ========
+ *
+ *  Gate shared by the processes of one processor.  The gate is a robust
+ *  pthread mutex in a named POSIX shared memory segment, so Linux
+ *  processes can serialize without going through a hardware spinlock.
+ *  The segment name is removed when the last instance using it is
+ *  deleted.
+ *
+ */
+
+#ifndef GATEPROCESS_H_0x72D1
+#define GATEPROCESS_H_0x72D1
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+
+/* =============================================================================
+ *  Status codes
+ * =============================================================================
+ */
+/*!
+ *  @def    GateProcess_E_INVALIDARG
+ *  @brief  Argument passed to a function is invalid.
+ */
+#define GateProcess_E_INVALIDARG     -1
+
+/*!
+ *  @def    GateProcess_E_MEMORY
+ *  @brief  Memory allocation failed.
+ */
+#define GateProcess_E_MEMORY         -2
+
+/*!
+ *  @def    GateProcess_E_BUSY
+ *  @brief  The gate is held by another thread.
+ */
+#define GateProcess_E_BUSY           -3
+
+/*!
+ *  @def    GateProcess_E_FAIL
+ *  @brief  Generic failure.
+ */
+#define GateProcess_E_FAIL           -4
+
+/*!
+ *  @def    GateProcess_E_NOTFOUND
+ *  @brief  The shared memory segment to open does not exist.
+ */
+#define GateProcess_E_NOTFOUND       -5
+
+/*!
+ *  @def    GateProcess_S_SUCCESS
+ *  @brief  Operation successful.
+ */
+#define GateProcess_S_SUCCESS        0
+
+
+/* =============================================================================
+ *  Macros and types
+ * =============================================================================
+ */
+/*! @brief  Max length of a GateProcess segment name */
+#define GateProcess_MAXNAMELEN       32
+
+/*!
+ *  @brief  How long an opener waits for the creator to initialize the
+ *          segment, in msec
+ */
+#define GateProcess_READYMSEC        1000
+
+/*! @brief  Object for Gate Process */
+typedef struct GateProcess_Object GateProcess_Object;
+
+/*! @brief  Handle for Gate Process */
+typedef struct GateProcess_Object * GateProcess_Handle;
+
+/*! @brief  Parameters for GateProcess creation */
+typedef struct GateProcess_Params {
+    String  name;
+    /*!< Name of the shared memory segment, must start with '/' */
+    Bool    openFlag;
+    /*!< Only open an existing segment, don't create it */
+    Bool    unlink;
+    /*!< Remove the segment name when this instance is deleted, even if
+     *   other instances still use it.  Otherwise the last user removes it.
+     */
+} GateProcess_Params;
+
+/* =============================================================================
+ *  APIs
+ * =============================================================================
+ */
+/* Initialize the parameter structure */
+Void GateProcess_Params_init(GateProcess_Params *params);
+
+/* Function to create or open a GateProcess */
+GateProcess_Handle GateProcess_create(const GateProcess_Params *params);
+
+/* Function to delete a GateProcess, the last user removes the segment */
+Int GateProcess_delete(GateProcess_Handle *handle);
+
+/* Function to enter a GateProcess only if it is free or already ours */
+Int GateProcess_tryEnter(GateProcess_Handle handle, IArg *key);
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+#endif /* GATEPROCESS_H_0x72D1 */
@@ -75,6 +75,12 @@ typedef struct GateMP_Object_tag {
 
     UInt                    resourceId;
     /*!< Resource id of GateMP proxy */
+
+    struct GateMP_RWState * rw;
+    /*!< Reader/writer state, NULL for gates with remote protection */
+
+    struct GateMP_Prof *    prof;
+    /*!< Contention statistics, NULL unless profiling is enabled */
 } GateMP_Object;
 
 /* Internal variable to enable/disable tracing throughout GateMP */
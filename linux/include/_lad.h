@@ -43,6 +43,7 @@ extern "C" {
 #include <ti/ipc/MessageQ.h>
 #include <_MessageQ.h>
 #include <ti/ipc/NameServer.h>
+#include <_NameServer.h>
 #include <ti/ipc/MultiProc.h>
 #include <_MultiProc.h>
 #include <stdio.h>
@@ -53,68 +54,29 @@ extern "C" {
 #include <sys/time.h>
 #include <ti/ipc/namesrv/_NameServerRemoteRpmsg.h>
 
-extern Bool logFile;
-extern FILE *logPtr;
-extern struct timeval start_tv;
+#include <_ladlog.h>
 
 /*
  * Macros for writing to log file.
  *
- * For the timestamp prefix, subtract the start time (which is established
- * when the logFile is opened) so that the massive "since the epoch" value
- * is not displayed.  For this, subtract only the timeval.tv_sec (seconds)
- * value so we don't have to worry about the "borrow" that results when
- * start_tv.tv_usec > tv.tv_usec.
+ * These only append a binary record to the in-memory log ring (see
+ * _ladlog.h); the record is timestamped and formatted off the command
+ * path, by the log writer thread or by lad_logdecode.
  */
 #define LOG0(a)  \
-    if (logFile == TRUE) { \
-        struct timeval tv; \
-        gettimeofday(&tv, NULL); \
-        fprintf(logPtr, "[%d.%06d] " a, \
-                (unsigned int)(tv.tv_sec - start_tv.tv_sec), \
-                (unsigned int)tv.tv_usec); \
-        fflush(logPtr); \
-    }
+    _LAD_LOG((a), a, 0, 0, 0, 0)
 
 #define LOG1(a, b)  \
-    if (logFile == TRUE) { \
-        struct timeval tv; \
-        gettimeofday(&tv, NULL); \
-        fprintf(logPtr, "[%d.%06d] " a, \
-                (unsigned int)(tv.tv_sec - start_tv.tv_sec), \
-                (unsigned int)tv.tv_usec, b); \
-        fflush(logPtr); \
-    }
+    _LAD_LOG((a, b), a, b, 0, 0, 0)
 
 #define LOG2(a, b, c)  \
-    if (logFile == TRUE) { \
-        struct timeval tv; \
-        gettimeofday(&tv, NULL); \
-        fprintf(logPtr, "[%d.%06d] " a, \
-                (unsigned int)(tv.tv_sec - start_tv.tv_sec), \
-                (unsigned int)tv.tv_usec, b, c); \
-        fflush(logPtr); \
-    }
+    _LAD_LOG((a, b, c), a, b, c, 0, 0)
 
 #define LOG3(a, b, c, d)  \
-    if (logFile == TRUE) { \
-        struct timeval tv; \
-        gettimeofday(&tv, NULL); \
-        fprintf(logPtr, "[%d.%06d] " a, \
-                (unsigned int)(tv.tv_sec - start_tv.tv_sec), \
-                (unsigned int)tv.tv_usec, b, c, d); \
-        fflush(logPtr); \
-    }
+    _LAD_LOG((a, b, c, d), a, b, c, d, 0)
 
 #define LOG4(a, b, c, d, e)  \
-    if (logFile == TRUE) { \
-        struct timeval tv; \
-        gettimeofday(&tv, NULL); \
-        fprintf(logPtr, "[%d.%06d] " a, \
-                (unsigned int)(tv.tv_sec - start_tv.tv_sec), \
-                (unsigned int)tv.tv_usec, b, c, d, e); \
-        fflush(logPtr); \
-    }
+    _LAD_LOG((a, b, c, d, e), a, b, c, d, e)
 
 /* macros for generating verbose output: */
 #define PRINTVERBOSE0(a)  \
@@ -142,7 +104,7 @@ extern struct timeval start_tv;
 #endif
 
 #define LAD_RESPONSEFIFOPATH    LAD_WORKINGDIR
-#define LAD_PROTOCOLVERSION     "03000000"    /*  MMSSRRRR */
+#define LAD_PROTOCOLVERSION     "03030000"    /*  MMSSRRRR */
 
 #define LAD_MAXNUMCLIENTS  32      /* max simultaneous clients */
 #define LAD_CONNECTTIMEOUT 5.0  /* LAD connect response timeout (sec) */
@@ -157,10 +119,33 @@ extern struct timeval start_tv;
 #define LAD_RESPONSELENGTH      sizeof(union LAD_ResponseObj)
 
 #define LAD_MESSAGEQCREATEMAXNAMELEN 32
+#define LAD_MESSAGEQLEASESIZE   16   /* queue indexes leased per request */
 
 #define LAD_MAXENTRYNAMELEN  MAXNAMEINCHAR /* max for LAD NameServer name */
 #define LAD_MAXENTRYVALUELEN 32  /* size limit for LAD NameServer value */
 
+#define LAD_STATSBUCKETS     16  /* log2(usec) buckets in LAD_TimeStats */
+
+/* LAD_GETSTATS sections; index selects the command/client/instance/proc */
+typedef enum {
+    LAD_STATS_SUMMARY = 0,
+    LAD_STATS_COMMAND,
+    LAD_STATS_CLIENT,
+    LAD_STATS_NAMESERVER,
+    LAD_STATS_REMOTE
+} LAD_StatsSection;
+
+/*
+ * Time distribution in nsec.  hist[n] counts samples below 2^n usec, the
+ * last bucket also takes everything longer.
+ */
+typedef struct {
+    UInt32 count;
+    UInt64 totalTime;
+    UInt64 maxTime;
+    UInt32 hist[LAD_STATSBUCKETS];
+} LAD_TimeStats;
+
 typedef enum {
     LAD_CONNECT = 0,
     LAD_DISCONNECT,
@@ -196,12 +181,17 @@ typedef enum {
     LAD_GATEMP_RELEASERESOURCE,
     LAD_GATEMP_ISSETUP,
     LAD_GATEHWSPINLOCK_GETCONFIG,
+    LAD_MESSAGEQ_LEASE,
+    LAD_MESSAGEQ_REGISTER,      /* no response */
+    LAD_MESSAGEQ_UNREGISTER,    /* no response */
+    LAD_GETSTATS,
     LAD_EXIT
 } _LAD_Command;
 
 struct LAD_CommandObj {
     Int cmd;
     Int clientId;
+    UInt64 sendTime;    /* CLOCK_MONOTONIC nsec, set by LAD_putCommand */
     union {
         struct {
             Int pid;
@@ -278,6 +268,16 @@ struct LAD_CommandObj {
         struct {
             Void *serverHandle;
         } messageQDelete;
+        struct {
+            UInt16 count;
+        } messageQLease;
+        struct {
+            Char name[LAD_MESSAGEQCREATEMAXNAMELEN];
+            MessageQ_QueueId queueId;
+        } messageQRegister;
+        struct {
+            MessageQ_QueueId queueId;
+        } messageQUnregister;
         struct {
             GateMP_RemoteProtect type;
         } gateMPGetNumResources;
@@ -291,6 +291,10 @@ struct LAD_CommandObj {
         struct {
             Bool result;
         } gateMPIsSetup;
+        struct {
+            Int section;
+            Int index;
+        } getStats;
     } args;
 };
 
@@ -316,11 +320,22 @@ union LAD_ResponseObj {
        Int status;
        NameServer_Handle nameServerHandle;
     } setup;
+    struct {
+       Int status;
+       NameServer_Handle nameServerHandle;
+       MessageQ_QueueId baseId;
+       UInt16 count;
+    } messageQSetup;
     struct {
        Int status;
        Int queueId;
        Void *serverHandle;
     } messageQCreate;
+    struct {
+       Int status;
+       MessageQ_QueueId baseId;
+       UInt16 count;
+    } messageQLease;
     struct {
        Int status;
     } messageQAnnounce;
@@ -362,6 +377,38 @@ union LAD_ResponseObj {
        Int status;
        GateHWSpinlock_Config cfgParams;
     } gateHWSpinlockGetConfig;
+    struct {
+       Int status;
+       Int section;
+       Int index;
+       union {
+           struct {
+               UInt64 upTime;           /* nsec since LAD started */
+               UInt64 numCommands;
+               LAD_TimeStats queueWait; /* LAD_putCommand() to dispatch */
+               UInt32 numClients;
+               UInt32 numQueues;        /* MessageQ table size */
+               UInt32 numQueuesUsed;
+               UInt32 numQueuesLeased;
+           } summary;
+           struct {
+               Int cmd;
+               LAD_TimeStats service;   /* dispatch to response sent */
+           } command;
+           struct {
+               Int pid;
+               Bool connected;
+               UInt64 connectTime;      /* nsec since LAD started */
+               UInt64 lastTime;
+               UInt64 numCommands;
+           } client;
+           NameServer_InstanceStats nameServer;
+           struct {
+               UInt16 procId;
+               NameServer_RemoteStats stats;
+           } remote;
+       } u;
+    } stats;
     Ipc_Config ipcConfig;
     NameServer_Params params;
     NameServer_Handle handle;
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/** ============================================================================
+ *  @file   _ladlog.h
+ *
+ *  @brief  In-memory binary log ring used by the LAD LOGn macros.
+ *
+ *  Each LOGn call site owns a static LAD_LogSite holding its format
+ *  string.  Logging a message copies the site id, a timestamp and the
+ *  raw arguments into a fixed size record in a lock-free ring; no
+ *  formatting or I/O is done on the caller's thread.  A background
+ *  thread renders the records into the log file given with 'lad -l',
+ *  and SIGUSR1 dumps the raw ring to LAD_LOGDUMPFILE for lad_logdecode.
+ *  ============================================================================
+ */
+
+#ifndef _LADLOG_H
+#define _LADLOG_H
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define LAD_LOGMAXARGS      4       /* args per record (LOG4) */
+#define LAD_LOGSTRLEN       72      /* bytes for copies of %s args */
+#define LAD_LOGRINGSIZE     4096    /* records in the ring, power of 2 */
+#define LAD_LOGMAXSITES     1024    /* distinct LOGn call sites */
+#define LAD_LOGNULLSTR      0xFFFF  /* %s arg was a NULL pointer */
+#define LAD_LOGFLUSHMSEC    50      /* log file writer period */
+
+#define LAD_LOGMAGIC        "LADLOG1"
+#define LAD_LOGDUMPFILE     "ladlog.bin"   /* in LAD_WORKINGDIR */
+
+/* One LOGn call site.  id is assigned on first use. */
+typedef struct LAD_LogSite {
+    const char *fmt;
+    UInt16      id;
+    UInt16      strMask;            /* bit n set: arg n is a %s */
+} LAD_LogSite;
+
+/*
+ *  A log record.  seq is the ring ticket + 1 once the record is complete
+ *  and 0 while it is being written, so readers can detect torn records.
+ *  For %s args, args[n] is the offset of the copied string in str.
+ */
+typedef struct LAD_LogRecord {
+    UInt64      seq;
+    UInt64      time;               /* nsec since LAD_logStart() */
+    UInt16      site;
+    UInt16      pad[3];
+    UInt64      args[LAD_LOGMAXARGS];
+    Char        str[LAD_LOGSTRLEN];
+} LAD_LogRecord;
+
+/*
+ *  Dump file layout: LAD_LogDumpHeader, then numSites times a UInt16 site
+ *  id, a UInt16 format length and the format bytes, then numRecords
+ *  LAD_LogRecords, oldest first.
+ */
+typedef struct LAD_LogDumpHeader {
+    Char        magic[8];
+    UInt32      numSites;
+    UInt32      numRecords;
+    UInt64      dropped;
+} LAD_LogDumpHeader;
+
+/* Set when logging is enabled, checked by the LOGn macros */
+extern Bool logFile;
+
+/* Text log file, or NULL when logging only to memory */
+extern FILE *logPtr;
+
+/* Start the ring and the writer thread; call after daemonizing */
+Int LAD_logStart(Void);
+
+/* Stop the writer thread after draining the ring to logPtr */
+Void LAD_logStop(Void);
+
+/* Write the ring contents to path in the dump file format */
+Int LAD_logDump(const char *path);
+
+/* Append one record; use the LOGn macros instead */
+Void LAD_logWrite(LAD_LogSite *site, UInt64 a0, UInt64 a1, UInt64 a2,
+        UInt64 a3);
+
+/* Render one record as text, the way the LOGn macros used to print it */
+Void LAD_logRender(FILE *out, const char *fmt, UInt16 strMask,
+        const LAD_LogRecord *rec);
+
+/* Compute the %s argument mask of a format */
+UInt16 LAD_logStrMask(const char *fmt);
+
+/*
+ *  Never called.  The LOGn macros pass it their format and arguments in
+ *  dead code, so the compiler still checks them like printf() arguments.
+ */
+static inline void _LAD_logCheck(const char *fmt, ...)
+        __attribute__((format(printf, 1, 2)));
+static inline void _LAD_logCheck(const char *fmt, ...)
+{
+}
+
+#define _LAD_LOGARG(x) ((UInt64)(uintptr_t)(x))
+
+/* 'check' is the parenthesized LOGn argument list, see _LAD_logCheck() */
+#define _LAD_LOG(check, a, b, c, d, e) \
+    if (logFile == TRUE) { \
+        static LAD_LogSite _site = { a, 0, 0 }; \
+        if (0) { \
+            _LAD_logCheck check; \
+        } \
+        LAD_logWrite(&_site, _LAD_LOGARG(b), _LAD_LOGARG(c), \
+                _LAD_LOGARG(d), _LAD_LOGARG(e)); \
+    }
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+#endif /* _LADLOG_H */
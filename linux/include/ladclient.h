@@ -122,6 +122,7 @@ extern LAD_Status LAD_disconnect(LAD_ClientHandle handle);
 extern LAD_ClientHandle LAD_findHandle(Void);
 extern LAD_Status LAD_getResponse(LAD_ClientHandle handle, union LAD_ResponseObj *rsp);
 extern LAD_Status LAD_putCommand(struct LAD_CommandObj *cmd);
+extern LAD_Status LAD_postCommand(struct LAD_CommandObj *cmd);
 
 #ifdef __cplusplus
 }
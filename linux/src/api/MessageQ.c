@@ -111,6 +111,13 @@ typedef struct {
     MessageQ_QueueIndex queueIndex;
 } MessageQ_Params_Version2;
 
+typedef struct {
+    Int __version;
+    Void *synchronizer;
+    MessageQ_QueueIndex queueIndex;
+    Bool syncRegister;
+} MessageQ_Params_Version3;
+
 /* structure for MessageQ module state */
 typedef struct MessageQ_ModuleObject {
     MessageQ_Handle           *queues;
@@ -125,6 +132,12 @@ typedef struct MessageQ_ModuleObject {
     MessageQ_PutHookFxn       putHookFxn;
     Ptr                      *heaps;
     Int                       numHeaps;
+    UInt16                   *freeIndex;
+    /* stack of queue indexes leased from LAD but not in use */
+    Int                       numFree;
+    Int                       maxFree;
+    UInt16                    procId;
+    /* processor id of the leased queue indexes */
 } MessageQ_ModuleObject;
 
 typedef struct MessageQ_CIRCLEQ_ENTRY {
@@ -142,6 +155,8 @@ typedef struct MessageQ_Object_tag {
     int                          unblocked;
     void                         *serverHandle;
     sem_t                        synchronizer;
+    Bool                         leased;
+    Bool                         named;
 } MessageQ_Object;
 
 /* traces in this file are controlled via _MessageQ_verbose */
@@ -164,7 +179,10 @@ static MessageQ_ModuleObject MessageQ_state =
     .seqNumGate = PTHREAD_MUTEX_INITIALIZER,
     .putHookFxn = NULL,
     .heaps      = NULL,
-    .numHeaps   = 0
+    .numHeaps   = 0,
+    .freeIndex  = NULL,
+    .numFree    = 0,
+    .maxFree    = 0
 };
 
 /*!
@@ -175,6 +193,10 @@ static MessageQ_ModuleObject MessageQ_state =
 MessageQ_ModuleObject *MessageQ_module = &MessageQ_state;
 
 Void _MessageQ_grow(UInt16 queueIndex);
+static Void _MessageQ_addLease(MessageQ_QueueId baseId, UInt16 count);
+static Int _MessageQ_lease(LAD_ClientHandle handle);
+static Void _MessageQ_sendName(LAD_ClientHandle handle, String name,
+        MessageQ_QueueId queueId);
 
 /* =============================================================================
  * APIS
@@ -367,16 +389,23 @@ Int MessageQ_setup(const MessageQ_Config *cfg)
         status = MessageQ_E_FAIL;
         goto exit;
     }
-    status = rsp.setup.status;
+    status = rsp.messageQSetup.status;
 
     PRINTVERBOSE2("MessageQ_setup: LAD response for client %d, status=%d\n",
             handle, status)
 
     MessageQ_module->seqNum = 0;
-    MessageQ_module->nameServer = rsp.setup.nameServerHandle;
+    MessageQ_module->nameServer = rsp.messageQSetup.nameServerHandle;
     MessageQ_module->numQueues = cfg->maxRuntimeEntries;
     MessageQ_module->queues = calloc(cfg->maxRuntimeEntries,
             sizeof(MessageQ_Handle));
+    MessageQ_module->numFree = 0;
+
+    /* LAD hands out the first block of queue indexes with the setup */
+    if (rsp.messageQSetup.count > 0) {
+        _MessageQ_addLease(rsp.messageQSetup.baseId,
+                rsp.messageQSetup.count);
+    }
     MessageQ_module->numHeaps = cfg->numHeaps;
     MessageQ_module->heaps = calloc(cfg->numHeaps, sizeof(Ptr));
 
@@ -429,6 +458,12 @@ Int MessageQ_destroy(void)
     free(MessageQ_module->heaps);
     MessageQ_module->heaps = NULL;
 
+    /* LAD reclaims our leased queue indexes on LAD_MESSAGEQ_DESTROY */
+    free(MessageQ_module->freeIndex);
+    MessageQ_module->freeIndex = NULL;
+    MessageQ_module->numFree = 0;
+    MessageQ_module->maxFree = 0;
+
     handle = LAD_findHandle();
     if (handle == LAD_MAXNUMCLIENTS) {
         PRINTVERBOSE1("MessageQ_destroy: can't find connection to daemon "
@@ -479,6 +514,7 @@ Void MessageQ_Params_init(MessageQ_Params *params)
 Void MessageQ_Params_init__S(MessageQ_Params *params, Int version)
 {
     MessageQ_Params_Version2 *params2;
+    MessageQ_Params_Version3 *params3;
 
     switch (version) {
 
@@ -489,6 +525,14 @@ Void MessageQ_Params_init__S(MessageQ_Params *params, Int version)
             params2->queueIndex = MessageQ_ANY;
             break;
 
+        case MessageQ_Params_VERSION_3:
+            params3 = (MessageQ_Params_Version3 *)params;
+            params3->__version = MessageQ_Params_VERSION_3;
+            params3->synchronizer = NULL;
+            params3->queueIndex = MessageQ_ANY;
+            params3->syncRegister = FALSE;
+            break;
+
         default:
             assert(FALSE);
             break;
@@ -513,6 +557,9 @@ MessageQ_Handle MessageQ_create(String name, const MessageQ_Params *pp)
     struct LAD_CommandObj cmd;
     union LAD_ResponseObj rsp;
     MessageQ_Params ps;
+    MessageQ_QueueId      queueId;
+    void                 *serverHandle = NULL;
+    Bool                  leased = FALSE;
 
     MessageQ_Params_init__S(&ps, MessageQ_Params_VERSION);
 
@@ -530,6 +577,12 @@ MessageQ_Handle MessageQ_create(String name, const MessageQ_Params *pp)
             ps.synchronizer = ((MessageQ_Params_Version2 *)pp)->synchronizer;
             ps.queueIndex = ((MessageQ_Params_Version2 *)pp)->queueIndex;
         }
+        else if (pp->__version == MessageQ_Params_VERSION_3) {
+            ps.__version = ((MessageQ_Params_Version3 *)pp)->__version;
+            ps.synchronizer = ((MessageQ_Params_Version3 *)pp)->synchronizer;
+            ps.queueIndex = ((MessageQ_Params_Version3 *)pp)->queueIndex;
+            ps.syncRegister = ((MessageQ_Params_Version3 *)pp)->syncRegister;
+        }
         else {
             assert(FALSE);
         }
@@ -544,6 +597,39 @@ MessageQ_Handle MessageQ_create(String name, const MessageQ_Params *pp)
         return NULL;
     }
 
+    /*
+     *  Dynamic queues take an index from the block LAD leased to us,
+     *  only reserved queue indexes need LAD to allocate the slot.  A
+     *  leased queue's name is registered without waiting for LAD, so a
+     *  name that must be checked now goes the synchronous way too.
+     */
+    if ((ps.queueIndex == MessageQ_ANY) &&
+            ((name == NULL) || !ps.syncRegister)) {
+        pthread_mutex_lock(&MessageQ_module->gate);
+
+        if (MessageQ_module->numFree == 0) {
+            _MessageQ_lease(handle);
+        }
+
+        if (MessageQ_module->numFree > 0) {
+            queueIndex =
+                MessageQ_module->freeIndex[--MessageQ_module->numFree];
+            leased = TRUE;
+        }
+
+        pthread_mutex_unlock(&MessageQ_module->gate);
+
+        if (!leased) {
+            PRINTVERBOSE0("MessageQ_create: no queue index available\n")
+            return NULL;
+        }
+
+        queueId = ((UInt32)MessageQ_module->procId << 16) |
+                (queueIndex + MessageQ_PORTOFFSET);
+
+        goto create;
+    }
+
     cmd.cmd = LAD_MESSAGEQ_CREATE;
     cmd.clientId = handle;
 
@@ -581,6 +667,10 @@ MessageQ_Handle MessageQ_create(String name, const MessageQ_Params *pp)
        return NULL;
     }
 
+    queueId = rsp.messageQCreate.queueId;
+    serverHandle = rsp.messageQCreate.serverHandle;
+
+create:
     /* Create the generic obj */
     obj = (MessageQ_Object *)calloc(1, sizeof (MessageQ_Object));
 
@@ -588,8 +678,9 @@ MessageQ_Handle MessageQ_create(String name, const MessageQ_Params *pp)
     memcpy(&obj->params, &ps, sizeof(ps));
 
 
-    obj->queue = rsp.messageQCreate.queueId;
-    obj->serverHandle = rsp.messageQCreate.serverHandle;
+    obj->queue = queueId;
+    obj->serverHandle = serverHandle;
+    obj->leased = leased;
     pthread_mutex_init(&obj->msgListGate, NULL);
     CIRCLEQ_INIT(&obj->msgList);
     if (sem_init(&obj->synchronizer, 0, 0) < 0) {
@@ -602,7 +693,7 @@ MessageQ_Handle MessageQ_create(String name, const MessageQ_Params *pp)
     }
 
     /* lad returns the queue port # (queueIndex + PORT_OFFSET) */
-    queueIndex = MessageQ_getQueueIndex(rsp.messageQCreate.queueId);
+    queueIndex = MessageQ_getQueueIndex(obj->queue);
 
     PRINTVERBOSE2("MessageQ_create: creating endpoints for '%s' "
             "queueIndex %d\n", (name == NULL) ? "NULL" : name , queueIndex)
@@ -651,6 +742,20 @@ MessageQ_Handle MessageQ_create(String name, const MessageQ_Params *pp)
 
     pthread_mutex_unlock(&MessageQ_module->gate);
 
+    /*
+     *  A leased queue only needs its name published. LAD does not answer,
+     *  but any later command from this process is queued behind it, so the
+     *  name is visible before anyone we talk to can look it up.
+     */
+    if (obj->leased) {
+        if (name != NULL) {
+            _MessageQ_sendName(handle, name, obj->queue);
+            obj->named = TRUE;
+        }
+
+        goto exit;
+    }
+
     /* send announce message to LAD, indicating we are ready to receive msgs */
     cmd.cmd = LAD_MESSAGEQ_ANNOUNCE;
     cmd.clientId = handle;
@@ -721,25 +826,35 @@ Int MessageQ_delete(MessageQ_Handle *handlePtr)
 
     obj = (MessageQ_Object *)(*handlePtr);
 
-    cmd.cmd = LAD_MESSAGEQ_DELETE;
-    cmd.clientId = handle;
-    cmd.args.messageQDelete.serverHandle = obj->serverHandle;
-
-    if ((status = LAD_putCommand(&cmd)) != LAD_SUCCESS) {
-        PRINTVERBOSE1(
-          "MessageQ_delete: sending LAD command failed, status=%d\n", status)
-        return MessageQ_E_FAIL;
+    if (obj->leased) {
+        /* withdraw the name, the index stays leased to us */
+        if (obj->named) {
+            _MessageQ_sendName(handle, NULL, obj->queue);
+        }
     }
+    else {
+        cmd.cmd = LAD_MESSAGEQ_DELETE;
+        cmd.clientId = handle;
+        cmd.args.messageQDelete.serverHandle = obj->serverHandle;
+
+        if ((status = LAD_putCommand(&cmd)) != LAD_SUCCESS) {
+            PRINTVERBOSE1(
+              "MessageQ_delete: sending LAD command failed, status=%d\n",
+              status)
+            return MessageQ_E_FAIL;
+        }
 
-    if ((status = LAD_getResponse(handle, &rsp)) != LAD_SUCCESS) {
-        PRINTVERBOSE1("MessageQ_delete: no LAD response, status=%d\n", status)
-        return MessageQ_E_FAIL;
-    }
-    status = rsp.messageQDelete.status;
+        if ((status = LAD_getResponse(handle, &rsp)) != LAD_SUCCESS) {
+            PRINTVERBOSE1("MessageQ_delete: no LAD response, status=%d\n",
+                    status)
+            return MessageQ_E_FAIL;
+        }
+        status = rsp.messageQDelete.status;
 
-    PRINTVERBOSE2(
-      "MessageQ_delete: got LAD response for client %d, status=%d\n",
-      handle, status)
+        PRINTVERBOSE2(
+          "MessageQ_delete: got LAD response for client %d, status=%d\n",
+          handle, status)
+    }
 
     pthread_mutex_lock(&MessageQ_module->gate);
 
@@ -776,6 +891,11 @@ Int MessageQ_delete(MessageQ_Handle *handlePtr)
     queueIndex = MessageQ_getQueueIndex(obj->queue);
     MessageQ_module->queues[queueIndex] = NULL;
 
+    /* return a leased index to the free stack for the next create */
+    if (obj->leased) {
+        MessageQ_module->freeIndex[MessageQ_module->numFree++] = queueIndex;
+    }
+
     pthread_mutex_unlock(&MessageQ_module->gate);
 
     free(obj);
@@ -1137,6 +1257,29 @@ MessageQ_Msg MessageQ_alloc(UInt16 heapId, UInt32 size)
     return (msg);
 }
 
+/*
+ *  Allocate num messages, all or none.  The heaps here have no batch
+ *  allocation, so they are allocated one at a time.
+ */
+Int MessageQ_allocN(UInt16 heapId, UInt32 size, MessageQ_Msg msgs[],
+        UInt num)
+{
+    UInt i;
+
+    for (i = 0; i < num; i++) {
+        msgs[i] = MessageQ_alloc(heapId, size);
+
+        if (msgs[i] == NULL) {
+            while (i > 0) {
+                MessageQ_free(msgs[--i]);
+            }
+            return (MessageQ_E_MEMORY);
+        }
+    }
+
+    return (MessageQ_S_SUCCESS);
+}
+
 /*
  *  Frees the message back to the heap that was used to allocate it.
  */
@@ -1374,6 +1517,116 @@ Void _MessageQ_grow(UInt16 queueIndex)
     return;
 }
 
+/*
+ *  ======== _MessageQ_addLease ========
+ *  Push a block of leased queue indexes onto the free stack.
+ *
+ *  Caller must hold MessageQ_module->gate. Indexes are pushed in reverse
+ *  so the lowest one is handed out first.
+ */
+static Void _MessageQ_addLease(MessageQ_QueueId baseId, UInt16 count)
+{
+    UInt16 *freeIndex;
+    UInt16 base;
+    Int i;
+
+    if (MessageQ_module->numFree + count > MessageQ_module->maxFree) {
+        freeIndex = realloc(MessageQ_module->freeIndex,
+                (MessageQ_module->maxFree + count) * sizeof(UInt16));
+
+        if (freeIndex == NULL) {
+            PRINTVERBOSE0("_MessageQ_addLease: no memory\n")
+            return;
+        }
+
+        MessageQ_module->freeIndex = freeIndex;
+        MessageQ_module->maxFree += count;
+    }
+
+    MessageQ_module->procId = MessageQ_getProcId(baseId);
+    base = MessageQ_getQueueIndex(baseId);
+
+    for (i = count - 1; i >= 0; i--) {
+        MessageQ_module->freeIndex[MessageQ_module->numFree++] = base + i;
+    }
+
+    PRINTVERBOSE2("_MessageQ_addLease: leased %d queue indexes at %d\n",
+            count, base)
+}
+
+/*
+ *  ======== _MessageQ_lease ========
+ *  Ask LAD for another block of queue indexes.
+ *
+ *  Caller must hold MessageQ_module->gate.
+ */
+static Int _MessageQ_lease(LAD_ClientHandle handle)
+{
+    Int status;
+    struct LAD_CommandObj cmd;
+    union LAD_ResponseObj rsp;
+
+    cmd.cmd = LAD_MESSAGEQ_LEASE;
+    cmd.clientId = handle;
+    cmd.args.messageQLease.count = LAD_MESSAGEQLEASESIZE;
+
+    if ((status = LAD_putCommand(&cmd)) != LAD_SUCCESS) {
+        PRINTVERBOSE1(
+          "_MessageQ_lease: sending LAD command failed, status=%d\n", status)
+        return MessageQ_E_FAIL;
+    }
+
+    if ((status = LAD_getResponse(handle, &rsp)) != LAD_SUCCESS) {
+        PRINTVERBOSE1("_MessageQ_lease: no LAD response, status=%d\n", status)
+        return MessageQ_E_FAIL;
+    }
+    status = rsp.messageQLease.status;
+
+    PRINTVERBOSE2(
+      "_MessageQ_lease: got LAD response for client %d, status=%d\n",
+      handle, status)
+
+    if (status >= 0) {
+        _MessageQ_addLease(rsp.messageQLease.baseId, rsp.messageQLease.count);
+    }
+
+    return (status);
+}
+
+/*
+ *  ======== _MessageQ_sendName ========
+ *  Publish (name != NULL) or withdraw the name of a leased queue.
+ *
+ *  LAD does not respond to these commands, so a failure (e.g. a name
+ *  already in use) is only reported in the LAD log.
+ */
+static Void _MessageQ_sendName(LAD_ClientHandle handle, String name,
+        MessageQ_QueueId queueId)
+{
+    Int status;
+    struct LAD_CommandObj cmd;
+
+    cmd.clientId = handle;
+
+    if (name != NULL) {
+        cmd.cmd = LAD_MESSAGEQ_REGISTER;
+        strncpy(cmd.args.messageQRegister.name, name,
+                LAD_MESSAGEQCREATEMAXNAMELEN - 1);
+        cmd.args.messageQRegister.name[LAD_MESSAGEQCREATEMAXNAMELEN - 1] =
+                '\0';
+        cmd.args.messageQRegister.queueId = queueId;
+    }
+    else {
+        cmd.cmd = LAD_MESSAGEQ_UNREGISTER;
+        cmd.args.messageQUnregister.queueId = queueId;
+    }
+
+    if ((status = LAD_postCommand(&cmd)) != LAD_SUCCESS) {
+        PRINTVERBOSE2("_MessageQ_sendName: sending LAD command %d failed, "
+                "status=%d\n", cmd.cmd, status)
+    }
+}
+
 /*
  *  ======== MessageQ_bind ========
  *  Bind all existing message queues to the given processor
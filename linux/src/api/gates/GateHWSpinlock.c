@@ -51,6 +51,7 @@
  */
 typedef UInt32            Error_Block;
 #include <GateMutex.h>
+#include <GateProcess.h>
 
 /* Socket Utils */
 #include <_lad.h>
@@ -59,14 +60,30 @@ typedef UInt32            Error_Block;
 /* Linux headers */
 #include <assert.h>
 #include <fcntl.h>
+#include <sched.h>
 #include <string.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <time.h>
 
 #include <linux/hwspinlock_user.h>
 
+/* =============================================================================
+ * Macros
+ * =============================================================================
+ */
+/* Tell the core we are busy waiting, without touching the interconnect */
+#if defined(__arm__) || defined(__aarch64__)
+#define GateHWSpinlock_RELAX()  __asm__ __volatile__("yield" ::: "memory")
+#elif defined(__i386__) || defined(__x86_64__)
+#define GateHWSpinlock_RELAX()  __asm__ __volatile__("pause" ::: "memory")
+#else
+#define GateHWSpinlock_RELAX()  __asm__ __volatile__("" ::: "memory")
+#endif
+
 /* =============================================================================
  * Structures & Enums
  * =============================================================================
@@ -77,6 +94,7 @@ typedef struct {
     UInt32 *                        baseAddr;   /* base addr lock registers */
     GateMutex_Handle                gmHandle;   /* handle to gate mutex */
     Bool                            useHwlockDrv; /* use the hwspinlock driver */
+    Bool                            useShm;     /* emulate locks in shm */
 } GateHWSpinlock_Module_State;
 
 /* GateHWSpinlock instance object */
@@ -86,6 +104,9 @@ struct GateHWSpinlock_Object {
     UInt                        nested;
     IGateProvider_Handle        localGate;
     int                         token;  /* HWSpinlock token */
+    GateHWSpinlock_Backoff      backoff;
+    GateHWSpinlock_Stats        stats;  /* protected by localGate */
+    UInt64                      enterTime; /* when the lock was acquired */
 };
 
 
@@ -101,6 +122,7 @@ static GateHWSpinlock_Module_State GateHWSpinlock_state =
     .baseAddr = NULL,
     .gmHandle = NULL,
     .useHwlockDrv = false,
+    .useShm = false,
 };
 
 static GateHWSpinlock_Module_State *Mod = &GateHWSpinlock_state;
@@ -110,13 +132,61 @@ static GateHWSpinlock_Params GateHWSpinlock_defInstParams =
     .resourceId = 0,
     .openFlag   = FALSE,
     .regionId   = 0,
-    .sharedAddr = NULL
+    .sharedAddr = NULL,
+    .backoff    = {
+        .spinMin    = 16,
+        .spinMax    = 4096,
+        .yieldCount = 8,
+        .sleepUsec  = 100
+    }
 };
 
 /* traces in this file are controlled via _GateHWSpinlock_verbose */
 Bool _GateHWSpinlock_verbose = FALSE;
 #define verbose _GateHWSpinlock_verbose
 
+/* =============================================================================
+ * Internal functions
+ * =============================================================================
+ */
+static inline UInt64 GateHWSpinlock_getTime(Void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((UInt64)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+/*
+ *  Wait before the next lock attempt.  *delay is the current busy wait,
+ *  *yields the sched_yield() calls made so far for this acquisition.
+ */
+static Void GateHWSpinlock_backoff(GateHWSpinlock_Object *obj, UInt32 *delay,
+    UInt32 *yields, GateHWSpinlock_Stats *stats)
+{
+    struct timespec ts;
+    UInt32 i;
+
+    if (*delay <= obj->backoff.spinMax) {
+        for (i = 0; i < *delay; i++) {
+            GateHWSpinlock_RELAX();
+        }
+        *delay = (*delay == 0) ? 1 : (*delay << 1);
+    }
+    else if (*yields < obj->backoff.yieldCount) {
+        sched_yield();
+        (*yields)++;
+        stats->numYields++;
+    }
+    else {
+        ts.tv_sec = obj->backoff.sleepUsec / 1000000;
+        ts.tv_nsec = (obj->backoff.sleepUsec % 1000000) * 1000;
+        nanosleep(&ts, NULL);
+        stats->numSleeps++;
+    }
+}
+
 /* =============================================================================
  * APIS
  * =============================================================================
@@ -176,16 +246,23 @@ Void GateHWSpinlock_getConfig (GateHWSpinlock_Config * cfgParams)
 Int32 GateHWSpinlock_start(Void)
 {
     Int32               status = GateHWSpinlock_S_SUCCESS;
-    UInt32              dst;
+    Char *              dst;
     int                 flags;
 
-    /* Fall back to /dev/mem if hwspinlock_user driver is not supported */
-    Mod->fd = open("/dev/hwspinlock", O_RDWR);
-    if (Mod->fd < 0) {
-        Mod->fd = open ("/dev/mem", O_RDWR | O_SYNC);
+    if (_GateHWSpinlock_cfgParams.backend == GateHWSpinlock_Backend_SHM) {
+        /* LAD creates the file of emulated lock registers */
+        Mod->useShm = true;
+        Mod->fd = shm_open(GateHWSpinlock_SHMNAME, O_RDWR, 0);
     }
     else {
-        Mod->useHwlockDrv = true;
+        /* Fall back to /dev/mem if hwspinlock_user driver is not supported */
+        Mod->fd = open("/dev/hwspinlock", O_RDWR);
+        if (Mod->fd < 0) {
+            Mod->fd = open ("/dev/mem", O_RDWR | O_SYNC);
+        }
+        else {
+            Mod->useHwlockDrv = true;
+        }
     }
 
     if (Mod->fd < 0){
@@ -202,12 +279,12 @@ Int32 GateHWSpinlock_start(Void)
 
         /* map the hardware lock registers into the local address space */
         if (status == GateHWSpinlock_S_SUCCESS) {
-            dst = (UInt32)mmap(NULL, _GateHWSpinlock_cfgParams.size,
+            dst = (Char *)mmap(NULL, _GateHWSpinlock_cfgParams.size,
                                (PROT_READ | PROT_WRITE),
-                               (MAP_SHARED), Mod->fd,
+                               (MAP_SHARED), Mod->fd, Mod->useShm ? 0 :
                                (off_t)_GateHWSpinlock_cfgParams.baseAddr);
 
-            if (dst == (UInt32)MAP_FAILED) {
+            if (dst == (Char *)MAP_FAILED) {
                 PRINTVERBOSE0("GateHWSpinlock_start: Memory map failed")
                     status = GateHWSpinlock_E_OSFAILURE;
                 close(Mod->fd);
@@ -248,9 +325,11 @@ Int GateHWSpinlock_stop(Void)
 
     /* release lock register mapping */
     if (!Mod->useHwlockDrv && (Mod->baseAddr != NULL)) {
-        munmap((void *)_GateHWSpinlock_cfgParams.baseAddr,
+        munmap((Char *)Mod->baseAddr - _GateHWSpinlock_cfgParams.offset,
            _GateHWSpinlock_cfgParams.size);
+        Mod->baseAddr = NULL;
     }
+    Mod->useShm = false;
 
     /* close the spinlock device file */
     if (Mod->fd >= 0) {
@@ -281,7 +360,8 @@ GateHWSpinlock_Handle GateHWSpinlock_create(GateMP_LocalProtect
 {
     GateHWSpinlock_Object * obj = (GateHWSpinlock_Object *)calloc(1,
         sizeof (GateHWSpinlock_Object));
-    (Void)localProtect;
+    GateProcess_Params gpParams;
+    Char name[GateProcess_MAXNAMELEN];
 
     if (!obj) {
         PRINTVERBOSE0("GateHWSpinlock_create: memory allocation failure")
@@ -289,10 +369,32 @@ GateHWSpinlock_Handle GateHWSpinlock_create(GateMP_LocalProtect
     }
 
     IGateProvider_ObjectInitializer(obj, GateHWSpinlock);
-    /* TODO: handle more local protection types */
-    obj->localGate = (IGateProvider_Handle)Mod->gmHandle;
+
+    /*
+     *  With process protection, the Linux processes using this lock first
+     *  serialize on a process gate shared by all of them, so only one of
+     *  them at a time competes with the remote cores for the hardware
+     *  spinlock.  Other protection levels use the module's GateMutex.
+     */
+    obj->localGate = NULL;
+    if (localProtect == GateMP_LocalProtect_PROCESS) {
+        GateProcess_Params_init(&gpParams);
+        snprintf(name, sizeof(name), "/tiipc_GateHWSpinlock.%u",
+            params->resourceId);
+        gpParams.name = name;
+        obj->localGate = (IGateProvider_Handle)GateProcess_create(&gpParams);
+
+        if (obj->localGate == NULL) {
+            PRINTVERBOSE1("GateHWSpinlock_create: process gate for lock %d "
+                "unavailable, using thread protection\n", params->resourceId)
+        }
+    }
+    if (obj->localGate == NULL) {
+        obj->localGate = (IGateProvider_Handle)Mod->gmHandle;
+    }
     obj->lockNum = params->resourceId;
     obj->nested = 0;
+    obj->backoff = params->backoff;
 
     return (GateHWSpinlock_Handle)obj;
 }
@@ -314,6 +416,10 @@ Int GateHWSpinlock_delete (GateHWSpinlock_Handle * handle)
 
     obj = (GateHWSpinlock_Object *)(*handle);
 
+    if (obj->localGate != (IGateProvider_Handle)Mod->gmHandle) {
+        GateProcess_delete((GateProcess_Handle *)&obj->localGate);
+    }
+
     free(obj);
     *handle = NULL;
 
@@ -330,6 +436,9 @@ IArg GateHWSpinlock_enter(GateHWSpinlock_Object *obj)
         .id = obj->lockNum,
         .timeout = 10,
     };
+    GateHWSpinlock_Stats waitStats;
+    UInt32 delay;
+    UInt32 yields = 0;
     IArg key;
     Bool locked;
 
@@ -341,11 +450,23 @@ IArg GateHWSpinlock_enter(GateHWSpinlock_Object *obj)
         return(key);
     }
 
+    /*
+     *  The local gate is released while backing off, so the wait is
+     *  counted locally and added to obj->stats once the lock is held.
+     */
+    memset(&waitStats, 0, sizeof(waitStats));
+    delay = obj->backoff.spinMin;
+
     /* enter the spinlock */
     while (1) {
         if (Mod->useHwlockDrv) {
             locked = !ioctl(Mod->fd, HWSPINLOCK_USER_LOCK, &data);
         }
+        else if (Mod->useShm) {
+            /* same test-and-set semantics as the lock register */
+            locked = (__atomic_exchange_n(&baseAddr[obj->lockNum], 1,
+                __ATOMIC_ACQUIRE) == 0);
+        }
         else {
             /* read the spinlock, returns non-zero when we get it */
             locked = (baseAddr[obj->lockNum] == 0);
@@ -355,15 +476,83 @@ IArg GateHWSpinlock_enter(GateHWSpinlock_Object *obj)
             break;
         }
 
+        waitStats.numSpins++;
+
         obj->nested--;
         IGateProvider_leave(obj->localGate, key);
+        GateHWSpinlock_backoff(obj, &delay, &yields, &waitStats);
         key = IGateProvider_enter(obj->localGate);
         obj->nested++; /* re-nest the gate */
     }
 
+    obj->stats.numEnters++;
+    if (waitStats.numSpins != 0) {
+        obj->stats.numContended++;
+        obj->stats.numSpins += waitStats.numSpins;
+        obj->stats.numYields += waitStats.numYields;
+        obj->stats.numSleeps += waitStats.numSleeps;
+    }
+    obj->enterTime = GateHWSpinlock_getTime();
+
     return (key);
 }
 
+/*
+ *  Enter a GateHWSpinlock instance if neither the local gate nor the lock
+ *  is held by someone else, without waiting
+ */
+Int GateHWSpinlock_tryEnter(GateHWSpinlock_Object *obj, IArg *key)
+{
+    volatile UInt32 *baseAddr = Mod->baseAddr;
+    struct hwspinlock_user_lock data = {
+        .id = obj->lockNum,
+        .timeout = 0,
+    };
+    Int status;
+    Bool locked;
+
+    if (obj->localGate != (IGateProvider_Handle)Mod->gmHandle) {
+        status = GateProcess_tryEnter((GateProcess_Handle)obj->localGate,
+            key);
+    }
+    else {
+        status = GateMutex_tryEnter((GateMutex_Handle)obj->localGate, key);
+    }
+
+    if (status < 0) {
+        return (GateHWSpinlock_E_BUSY);
+    }
+
+    obj->nested++;
+    if (obj->nested > 1) {
+        return (GateHWSpinlock_S_SUCCESS);
+    }
+
+    if (Mod->useHwlockDrv) {
+        /* a zero timeout makes the driver try the lock once */
+        locked = !ioctl(Mod->fd, HWSPINLOCK_USER_LOCK, &data);
+    }
+    else if (Mod->useShm) {
+        locked = (__atomic_exchange_n(&baseAddr[obj->lockNum], 1,
+            __ATOMIC_ACQUIRE) == 0);
+    }
+    else {
+        locked = (baseAddr[obj->lockNum] == 0);
+    }
+
+    if (!locked) {
+        obj->nested--;
+        obj->stats.numSpins++;
+        IGateProvider_leave(obj->localGate, *key);
+        return (GateHWSpinlock_E_BUSY);
+    }
+
+    obj->stats.numEnters++;
+    obj->enterTime = GateHWSpinlock_getTime();
+
+    return (GateHWSpinlock_S_SUCCESS);
+}
+
 /*
  *  Leave a GateHWSpinlock instance
  */
@@ -374,13 +563,31 @@ Int GateHWSpinlock_leave(GateHWSpinlock_Object *obj, IArg key)
         .id = obj->lockNum,
     };
 
+    UInt64 holdTime;
+    UInt64 usec;
+    Int bucket = 0;
+
     obj->nested--;
 
     /* release the spinlock if not nested */
     if (obj->nested == 0) {
+        holdTime = GateHWSpinlock_getTime() - obj->enterTime;
+        for (usec = holdTime / 1000; (usec != 0) &&
+            (bucket < GateHWSpinlock_STATSBUCKETS - 1); usec >>= 1) {
+            bucket++;
+        }
+        obj->stats.holdHist[bucket]++;
+        obj->stats.totalHoldTime += holdTime;
+        if (holdTime > obj->stats.maxHoldTime) {
+            obj->stats.maxHoldTime = holdTime;
+        }
+
         if (Mod->useHwlockDrv) {
             ioctl(Mod->fd, HWSPINLOCK_USER_UNLOCK, &data);
         }
+        else if (Mod->useShm) {
+            __atomic_store_n(&baseAddr[obj->lockNum], 0, __ATOMIC_RELEASE);
+        }
         else {
             baseAddr[obj->lockNum] = 0;
         }
@@ -390,3 +597,62 @@ Int GateHWSpinlock_leave(GateHWSpinlock_Object *obj, IArg key)
 
     return GateHWSpinlock_S_SUCCESS;
 }
+
+/*
+ *  Change how an instance backs off when the lock is taken
+ */
+Int GateHWSpinlock_setBackoff(GateHWSpinlock_Handle handle,
+    const GateHWSpinlock_Backoff *backoff)
+{
+    GateHWSpinlock_Object *obj = (GateHWSpinlock_Object *)handle;
+    IArg key;
+
+    if ((obj == NULL) || (backoff == NULL)) {
+        return GateHWSpinlock_E_INVALIDARG;
+    }
+
+    key = IGateProvider_enter(obj->localGate);
+    obj->backoff = *backoff;
+    IGateProvider_leave(obj->localGate, key);
+
+    return GateHWSpinlock_S_SUCCESS;
+}
+
+/*
+ *  Get the contention statistics of an instance
+ */
+Int GateHWSpinlock_getStats(GateHWSpinlock_Handle handle,
+    GateHWSpinlock_Stats *stats)
+{
+    GateHWSpinlock_Object *obj = (GateHWSpinlock_Object *)handle;
+    IArg key;
+
+    if ((obj == NULL) || (stats == NULL)) {
+        return GateHWSpinlock_E_INVALIDARG;
+    }
+
+    key = IGateProvider_enter(obj->localGate);
+    *stats = obj->stats;
+    IGateProvider_leave(obj->localGate, key);
+
+    return GateHWSpinlock_S_SUCCESS;
+}
+
+/*
+ *  Clear the contention statistics of an instance
+ */
+Int GateHWSpinlock_resetStats(GateHWSpinlock_Handle handle)
+{
+    GateHWSpinlock_Object *obj = (GateHWSpinlock_Object *)handle;
+    IArg key;
+
+    if (obj == NULL) {
+        return GateHWSpinlock_E_INVALIDARG;
+    }
+
+    key = IGateProvider_enter(obj->localGate);
+    memset(&obj->stats, 0, sizeof(obj->stats));
+    IGateProvider_leave(obj->localGate, key);
+
+    return GateHWSpinlock_S_SUCCESS;
+}
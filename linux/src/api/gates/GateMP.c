@@ -34,11 +34,19 @@
  */
 #include <ti/ipc/Std.h>
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include <pthread.h>
 #include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include <ti/ipc/GateMP.h>
 #include <ti/ipc/NameServer.h>
@@ -46,6 +54,10 @@
 
 #include <GateMP_config.h>
 
+typedef UInt32            Error_Block;
+#include <GateMutex.h>
+#include <GateProcess.h>
+
 #include <_GateMP.h>
 
 /* Socket Protocol Family */
@@ -74,8 +86,48 @@ typedef struct {
     /* Remote system gates */
     Int                 numRemoteSystem;
     /* Number of remote system gates */
+    UInt32              numProcessGates;
+    /* Serial number of the last process gate created here */
+    Bool                profile;
+    /* Collect contention statistics of new instances */
+    String              profPath;
+    /* Where SIGUSR2 dumps the statistics, NULL for stderr */
+    struct GateMP_Prof *profList;
+    /* Instances with statistics, for the dump */
+    pthread_mutex_t     profLock;
+    /* Protects profList */
+    Int                 profPipe[2];
+    /* SIGUSR2 handler to dump thread */
+    pthread_t           profThread;
+    /* Writes the dumps */
+    struct sigaction    profOldAction;
+    /* SIGUSR2 action to restore in GateMP_stop */
 } GateMP_ModuleObject;
 
+/* Reader/writer state of a gate without remote protection */
+typedef struct GateMP_RWState {
+    UInt32              readers;    /* between enterRead and leaveRead */
+    UInt32              writer;     /* a writer is waiting or writing */
+} GateMP_RWState;
+
+/* Acquisitions between call site samples, power of 2 */
+#define GateMP_PROFSAMPLE       16
+
+/* Waits at least this long count as contended */
+#define GateMP_PROFCONTENDNSEC  1000
+
+#define GateMP_PROFNAMELEN      32
+
+/* Per-process profiling state of a GateMP instance */
+typedef struct GateMP_Prof {
+    struct GateMP_Prof *next;
+    Char                name[GateMP_PROFNAMELEN];
+    pthread_t           owner;      /* holding thread, 0 when free */
+    UInt32              depth;      /* nesting of the owner */
+    UInt64              enterTime;  /* when the owner acquired the gate */
+    GateMP_Stats        stats;
+} GateMP_Prof;
+
 /* traces in this file are controlled via _GateMP_verbose */
 Bool _GateMP_verbose = FALSE;
 #define verbose _GateMP_verbose
@@ -89,6 +141,7 @@ typedef struct {
     GateMP_RemoteProtect remoteProtect; /* Remote protection level */
     UInt32 resourceId;                  /* resource id */
     Bool openFlag;                      /* Is this open or create? */
+    UInt32 creatorPid;                  /* creator of a process gate */
 } _GateMP_Params;
 
 static Int GateMP_getNumResources(GateMP_RemoteProtect type);
@@ -98,6 +151,15 @@ static GateMP_Handle _GateMP_create (const _GateMP_Params * params);
 static Int GateMP_Instance_init(GateMP_Object *obj,
     const _GateMP_Params *params);
 static Void GateMP_Instance_finalize(GateMP_Object *obj, Int status);
+static IGateProvider_Handle GateMP_createLocalGate(GateMP_Object *obj,
+    UInt32 pid, UInt32 serial, Bool openFlag);
+static GateMP_RWState *GateMP_createRWState(GateMP_Object *obj,
+    UInt32 pid, UInt32 serial, Bool openFlag);
+static Void GateMP_deleteRWState(GateMP_Object *obj);
+static Int GateMP_profStart(String path);
+static Void GateMP_profStop(Void);
+static Void GateMP_profCreate(GateMP_Object *obj, String name);
+static Void GateMP_profDelete(GateMP_Object *obj);
 
 /* -----------------------------------------------------------------------------
  * Globals
@@ -109,6 +171,11 @@ static GateMP_ModuleObject GateMP_state =
     .defaultGate        = NULL,
     .nameServer         = NULL,
     .mutex              = PTHREAD_MUTEX_INITIALIZER,
+    .numProcessGates    = 0,
+    .profile            = FALSE,
+    .profList           = NULL,
+    .profLock           = PTHREAD_MUTEX_INITIALIZER,
+    .profPipe           = { -1, -1 },
 //    .gateMutex          = NULL,
 //    .gateProcess        = NULL
 };
@@ -266,6 +333,13 @@ Int GateMP_start(Void)
         }
     }
 
+    /* collect contention statistics if asked to, see GateMP_getStats() */
+    if ((status == GateMP_S_SUCCESS) && (getenv("GATEMP_PROFILE") != NULL)) {
+        if (GateMP_profStart(getenv("GATEMP_PROFILE")) < 0) {
+            PRINTVERBOSE0("GateMP_start: profiling not available\n")
+        }
+    }
+
     if (status == GateMP_S_SUCCESS) {
         /* Open default gate */
         status = GateMP_open("_GateMP_TI_dGate", &GateMP_module->defaultGate);
@@ -298,6 +372,8 @@ Int GateMP_stop(Void)
         GateMP_module->defaultGate = NULL;
     }
 
+    GateMP_profStop();
+
     /* free system gate array */
     if (GateMP_module->remoteSystemGates != NULL) {
         free(GateMP_module->remoteSystemGates);
@@ -354,6 +430,7 @@ static GateMP_Handle _GateMP_create(const _GateMP_Params *params)
             free(obj);
         }
         else {
+            GateMP_profCreate(obj, params->name);
             handle = (GateMP_Handle)obj;
         }
     }
@@ -417,7 +494,8 @@ Int GateMP_open(String name, GateMP_Handle *handle)
                     another processor")
                 status = GateMP_E_FAIL;
             }
-            else if (nsValue[0] != (UInt32)getpid()) {
+            else if ((nsValue[0] != (UInt32)getpid()) &&
+                (GETLOCAL(mask) != GateMP_LocalProtect_PROCESS)) {
                 /* error: trying to open another process's private gate */
                 *handle = NULL;
                 PRINTVERBOSE0("GateMP_open: cannot open private gate from \
@@ -433,6 +511,21 @@ Int GateMP_open(String name, GateMP_Handle *handle)
             if (creatorProcId != MultiProc_self()) {
                 status = GateMP_E_FAIL;
             }
+            else if (GETLOCAL(mask) == GateMP_LocalProtect_PROCESS) {
+                /* map the creator's gate segment into this process */
+                params.name = NULL;
+                params.openFlag = TRUE;
+                params.sharedAddr = NULL;
+                params.resourceId = arg;
+                params.creatorPid = nsValue[0];
+                params.localProtect = GateMP_LocalProtect_PROCESS;
+                params.remoteProtect = GateMP_RemoteProtect_NONE;
+
+                *handle = _GateMP_create(&params);
+                if (*handle == NULL) {
+                    status = GateMP_E_FAIL;
+                }
+            }
             else {
                 *handle = (GateMP_Handle)arg;
                 obj = (GateMP_Object *)(*handle);
@@ -502,6 +595,12 @@ Int GateMP_open(String name, GateMP_Handle *handle)
         }
     }
 
+    /* gates created by others are only known here by name */
+    if ((status == GateMP_S_SUCCESS) && ((*handle)->prof != NULL) &&
+        ((*handle)->prof->name[0] == '\0')) {
+        strncpy((*handle)->prof->name, name, GateMP_PROFNAMELEN - 1);
+    }
+
     return status;
 }
 
@@ -735,6 +834,7 @@ Int GateMP_delete(GateMP_Handle *handlePtr)
         status =  GateMP_E_INVALIDARG;
     }
     else {
+        GateMP_profDelete((GateMP_Object *)(*handlePtr));
         GateMP_Instance_finalize((GateMP_Object *)(*handlePtr), 0);
         free(*handlePtr);
         *handlePtr = NULL;
@@ -751,7 +851,7 @@ static Int GateMP_Instance_init(GateMP_Object *obj,
 
     obj->resourceId = (UInt)-1;
 
-    /* TODO: create/open the local gate instance */
+    /* the local gate of remote gates is created by the proxy */
     obj->localGate = NULL;
 
     /* open GateMP instance */
@@ -763,6 +863,26 @@ static Int GateMP_Instance_init(GateMP_Object *obj,
         obj->numOpens      = 1;
 
         obj->objType       = Ipc_ObjType_OPENDYNAMIC;
+
+        /* only process gates can be opened locally */
+        if (obj->remoteProtect == GateMP_RemoteProtect_NONE) {
+            obj->localGate = GateMP_createLocalGate(obj, params->creatorPid,
+                params->resourceId, TRUE);
+            obj->gateHandle = obj->localGate;
+            obj->arg = params->resourceId;
+            if (obj->localGate == NULL) {
+                return (GateMP_E_FAIL);
+            }
+
+            obj->rw = GateMP_createRWState(obj, params->creatorPid,
+                params->resourceId, TRUE);
+            if (obj->rw == NULL) {
+                GateProcess_delete((GateProcess_Handle *)&obj->localGate);
+                return (GateMP_E_FAIL);
+            }
+
+            return (GateMP_S_SUCCESS);
+        }
     }
 
     /* create GateMP instance */
@@ -773,12 +893,39 @@ static Int GateMP_Instance_init(GateMP_Object *obj,
         obj->numOpens      = 0;
 
         if (obj->remoteProtect == GateMP_RemoteProtect_NONE) {
-            /* TODO: create a local gate */
+            /*
+             *  A process gate is named by the creator's pid and a serial
+             *  number, which other processes look up in the NameServer
+             *  to open it.  Other gates are private to this process.
+             */
+            if (obj->localProtect == GateMP_LocalProtect_PROCESS) {
+                pthread_mutex_lock(&GateMP_module->mutex);
+                obj->arg = ++GateMP_module->numProcessGates;
+                pthread_mutex_unlock(&GateMP_module->mutex);
+            }
+            else {
+                obj->arg = (Bits32)obj;
+            }
+
+            obj->localGate = GateMP_createLocalGate(obj, getpid(), obj->arg,
+                FALSE);
+            if (obj->localGate == NULL) {
+                PRINTVERBOSE0("GateMP_Instance_init: local gate create "
+                    "failed\n")
+                return (GateMP_E_FAIL);
+            }
             obj->gateHandle = obj->localGate;
 
+            obj->rw = GateMP_createRWState(obj, getpid(), obj->arg, FALSE);
+            if (obj->rw == NULL) {
+                PRINTVERBOSE0("GateMP_Instance_init: reader/writer state "
+                    "create failed\n")
+                GateMP_Instance_finalize(obj, GateMP_E_FAIL);
+                return (GateMP_E_FAIL);
+            }
+
             /* create a local gate allocating from the local heap */
             obj->objType = Ipc_ObjType_LOCAL;
-            obj->arg = (Bits32)obj;
             obj->mask = SETMASK(obj->remoteProtect, obj->localProtect);
             obj->creatorProcId = MultiProc_self();
 
@@ -786,7 +933,7 @@ static Int GateMP_Instance_init(GateMP_Object *obj,
                 /*  nsv[0]       : creator process id
                  *  nsv[1](31:16): creator procId
                  *  nsv[1](15:0) : 0 = local gate, 1 = remote gate
-                 *  nsv[2]       : local gate object
+                 *  nsv[2]       : local gate object, or process gate serial
                  *  nsv[3]       : protection mask
                  */
                 nsValue[0] = getpid();
@@ -797,6 +944,7 @@ static Int GateMP_Instance_init(GateMP_Object *obj,
                         params->name, &nsValue, sizeof(nsValue));
                 if (obj->nsKey == NULL) {
                     PRINTVERBOSE0("GateMP_Instance_init: NameServer_add failed")
+                    GateMP_Instance_finalize(obj, GateMP_E_FAIL);
                     return (GateMP_E_FAIL);
                 }
             }
@@ -907,7 +1055,17 @@ static Void GateMP_Instance_finalize(GateMP_Object *obj, Int status)
             break;
 
         case GateMP_RemoteProtect_NONE:
-            /*  nothing else to finalize */
+            GateMP_deleteRWState(obj);
+            if (obj->localGate == NULL) {
+                /* nothing else to finalize */
+            }
+            else if (obj->localProtect == GateMP_LocalProtect_PROCESS) {
+                GateProcess_delete((GateProcess_Handle *)&obj->localGate);
+            }
+            else {
+                GateMutex_delete((GateMutex_Handle *)&obj->localGate);
+            }
+            obj->gateHandle = NULL;
             return;
 
         default:
@@ -929,12 +1087,392 @@ static Void GateMP_Instance_finalize(GateMP_Object *obj, Int status)
 
 }
 
+/*
+ *  ======== GateMP_createLocalGate ========
+ *  Create the gate of a GateMP without remote protection.  Process gates
+ *  live in a shared memory segment named after the creator, which
+ *  removes the name when it deletes the GateMP.  Everything else
+ *  only needs a mutex.
+ */
+static IGateProvider_Handle GateMP_createLocalGate(GateMP_Object *obj,
+    UInt32 pid, UInt32 serial, Bool openFlag)
+{
+    GateProcess_Params params;
+    Char name[GateProcess_MAXNAMELEN];
+
+    if (obj->localProtect != GateMP_LocalProtect_PROCESS) {
+        return ((IGateProvider_Handle)GateMutex_create(NULL, NULL));
+    }
+
+    snprintf(name, sizeof(name), "/tiipc_GateMP.%u.%u", pid, serial);
+
+    GateProcess_Params_init(&params);
+    params.name = name;
+    params.openFlag = openFlag;
+    params.unlink = !openFlag;
+
+    return ((IGateProvider_Handle)GateProcess_create(&params));
+}
+
+/*
+ *  ======== GateMP_rwStateName ========
+ *  Process gates keep their reader/writer state next to the gate, in a
+ *  shared memory segment named after the creator.
+ */
+static Void GateMP_rwStateName(Char *name, SizeT len, UInt32 pid,
+    UInt32 serial)
+{
+    snprintf(name, len, "/tiipc_GateMP.%u.%u.rw", pid, serial);
+}
+
+/*
+ *  ======== GateMP_createRWState ========
+ */
+static GateMP_RWState *GateMP_createRWState(GateMP_Object *obj,
+    UInt32 pid, UInt32 serial, Bool openFlag)
+{
+    GateMP_RWState *rw;
+    Char name[48];
+    Int fd;
+
+    if (obj->localProtect != GateMP_LocalProtect_PROCESS) {
+        return ((GateMP_RWState *)calloc(1, sizeof(GateMP_RWState)));
+    }
+
+    GateMP_rwStateName(name, sizeof(name), pid, serial);
+
+    fd = shm_open(name, openFlag ? O_RDWR : (O_RDWR | O_CREAT | O_TRUNC),
+        0666);
+    if (fd < 0) {
+        PRINTVERBOSE2("GateMP_createRWState: shm_open(%s) failed, errno=%d\n",
+            name, errno)
+        return (NULL);
+    }
+
+    /* a new file reads as zeros: no readers, no writer */
+    if (!openFlag) {
+        fchmod(fd, 0666);
+        if (ftruncate(fd, sizeof(GateMP_RWState)) < 0) {
+            close(fd);
+            shm_unlink(name);
+            return (NULL);
+        }
+    }
+
+    rw = (GateMP_RWState *)mmap(NULL, sizeof(GateMP_RWState),
+        PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (rw == MAP_FAILED) {
+        if (!openFlag) {
+            shm_unlink(name);
+        }
+        return (NULL);
+    }
+
+    return (rw);
+}
+
+/*
+ *  ======== GateMP_deleteRWState ========
+ */
+static Void GateMP_deleteRWState(GateMP_Object *obj)
+{
+    Char name[48];
+
+    if (obj->rw == NULL) {
+        return;
+    }
+
+    if (obj->localProtect != GateMP_LocalProtect_PROCESS) {
+        free(obj->rw);
+    }
+    else {
+        munmap(obj->rw, sizeof(GateMP_RWState));
+        if (obj->objType != Ipc_ObjType_OPENDYNAMIC) {
+            GateMP_rwStateName(name, sizeof(name), getpid(), obj->arg);
+            shm_unlink(name);
+        }
+    }
+
+    obj->rw = NULL;
+}
+
+/*
+ *  ======== GateMP_backoff ========
+ *  Sleeps for *sleepNsec and doubles it up to 1 ms, the same backoff
+ *  GateMP_enterTimeout uses.  A plain sched_yield() returns right away
+ *  when nothing else is runnable and burns a core for the whole wait.
+ */
+static inline Void GateMP_backoff(UInt64 *sleepNsec)
+{
+    struct timespec ts;
+
+    ts.tv_sec = 0;
+    ts.tv_nsec = *sleepNsec;
+    nanosleep(&ts, NULL);
+
+    if (*sleepNsec < 1000000) {
+        *sleepNsec <<= 1;
+    }
+}
+
+/*
+ *  ======== GateMP_enterRead ========
+ *  The reader/writer state is only touched while holding the gate.
+ *  Waiters give the gate up between looks, so the threads they wait for
+ *  can get in to count themselves out.
+ */
+Int GateMP_enterRead(GateMP_Handle handle, IArg *key)
+{
+    GateMP_Object *obj = (GateMP_Object *)handle;
+    UInt64 sleepNsec = 1000;
+    IArg gateKey;
+
+    /* the reader count of remote gates is in memory the host can't see */
+    if (obj->rw == NULL) {
+        return (GateMP_E_NOTSUPPORTED);
+    }
+
+    gateKey = IGateProvider_enter(obj->gateHandle);
+    while (obj->rw->writer != 0) {
+        IGateProvider_leave(obj->gateHandle, gateKey);
+        GateMP_backoff(&sleepNsec);
+        gateKey = IGateProvider_enter(obj->gateHandle);
+    }
+    obj->rw->readers++;
+    IGateProvider_leave(obj->gateHandle, gateKey);
+
+    *key = 0;
+
+    return (GateMP_S_SUCCESS);
+}
+
+/*
+ *  ======== GateMP_leaveRead ========
+ */
+Void GateMP_leaveRead(GateMP_Handle handle, IArg key)
+{
+    GateMP_Object *obj = (GateMP_Object *)handle;
+
+    key = IGateProvider_enter(obj->gateHandle);
+    obj->rw->readers--;
+    IGateProvider_leave(obj->gateHandle, key);
+}
+
+/*
+ *  ======== GateMP_enterWrite ========
+ *  Waits for an earlier writer, then sets writer so no new readers get
+ *  in, and waits for the readers to drain.  Returns holding the gate.
+ */
+Int GateMP_enterWrite(GateMP_Handle handle, IArg *key)
+{
+    GateMP_Object *obj = (GateMP_Object *)handle;
+    UInt64 sleepNsec = 1000;
+
+    if (obj->rw == NULL) {
+        return (GateMP_E_NOTSUPPORTED);
+    }
+
+    *key = IGateProvider_enter(obj->gateHandle);
+    while (obj->rw->writer != 0) {
+        IGateProvider_leave(obj->gateHandle, *key);
+        GateMP_backoff(&sleepNsec);
+        *key = IGateProvider_enter(obj->gateHandle);
+    }
+
+    obj->rw->writer = 1;
+    sleepNsec = 1000;
+
+    while (obj->rw->readers != 0) {
+        IGateProvider_leave(obj->gateHandle, *key);
+        GateMP_backoff(&sleepNsec);
+        *key = IGateProvider_enter(obj->gateHandle);
+    }
+
+    return (GateMP_S_SUCCESS);
+}
+
+/*
+ *  ======== GateMP_leaveWrite ========
+ */
+Void GateMP_leaveWrite(GateMP_Handle handle, IArg key)
+{
+    GateMP_Object *obj = (GateMP_Object *)handle;
+
+    obj->rw->writer = 0;
+    IGateProvider_leave(obj->gateHandle, key);
+}
+
+static inline UInt64 GateMP_getTime(Void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((UInt64)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+/*
+ *  ======== GateMP_profBucket ========
+ *  Histogram bucket of a time in nsec, log2 usec.
+ */
+static inline Int GateMP_profBucket(UInt64 nsec)
+{
+    UInt64 usec;
+    Int bucket = 0;
+
+    for (usec = nsec / 1000; (usec != 0) &&
+        (bucket < GateMP_STATSBUCKETS - 1); usec >>= 1) {
+        bucket++;
+    }
+
+    return (bucket);
+}
+
+/*
+ *  ======== GateMP_profSample ========
+ *  Count a sampled acquisition against its call site.  When the table is
+ *  full, the site with the fewest samples is replaced and the newcomer
+ *  inherits its count, so frequent callers can't be pushed out by a
+ *  stream of rare ones.
+ */
+static Void GateMP_profSample(GateMP_Prof *prof, Ptr addr, UInt64 wait)
+{
+    GateMP_CallSite *site = &prof->stats.sites[0];
+    Int i;
+
+    for (i = 0; i < GateMP_STATSSITES; i++) {
+        if (prof->stats.sites[i].addr == addr) {
+            site = &prof->stats.sites[i];
+            break;
+        }
+        if (prof->stats.sites[i].samples < site->samples) {
+            site = &prof->stats.sites[i];
+        }
+    }
+
+    if (site->addr != addr) {
+        site->addr = addr;
+        site->waitTime = 0;
+    }
+    site->samples++;
+    site->waitTime += wait;
+}
+
+/*
+ *  ======== GateMP_profIsOwner ========
+ *  The owner is cleared before the gate is released, so a thread can
+ *  only find itself in owner while it holds the gate.
+ */
+static inline Bool GateMP_profIsOwner(GateMP_Prof *prof)
+{
+    return (pthread_equal(__atomic_load_n(&prof->owner, __ATOMIC_RELAXED),
+        pthread_self()));
+}
+
+/*
+ *  ======== GateMP_profNested ========
+ */
+static Void GateMP_profNested(GateMP_Prof *prof)
+{
+    prof->stats.numNested++;
+    if (++prof->depth > prof->stats.maxDepth) {
+        prof->stats.maxDepth = prof->depth;
+    }
+}
+
+/*
+ *  ======== GateMP_profAcquired ========
+ *  Account for an acquisition that started waiting at start.  The
+ *  statistics are updated while holding the gate, so they need no lock
+ *  of their own.
+ */
+static Void GateMP_profAcquired(GateMP_Prof *prof, Ptr caller, UInt64 start)
+{
+    UInt64 wait;
+
+    prof->enterTime = GateMP_getTime();
+
+    __atomic_store_n(&prof->owner, pthread_self(), __ATOMIC_RELAXED);
+    prof->depth = 1;
+    if (prof->stats.maxDepth == 0) {
+        prof->stats.maxDepth = 1;
+    }
+
+    wait = prof->enterTime - start;
+    prof->stats.numEnters++;
+    if (wait >= GateMP_PROFCONTENDNSEC) {
+        prof->stats.numContended++;
+    }
+    prof->stats.waitHist[GateMP_profBucket(wait)]++;
+    prof->stats.totalWaitTime += wait;
+    if (wait > prof->stats.maxWaitTime) {
+        prof->stats.maxWaitTime = wait;
+    }
+
+    if ((prof->stats.numEnters & (GateMP_PROFSAMPLE - 1)) == 0) {
+        GateMP_profSample(prof, caller, wait);
+    }
+}
+
+/*
+ *  ======== GateMP_profEnter ========
+ *  GateMP_enter() with profiling.
+ */
+static IArg GateMP_profEnter(GateMP_Object *obj, Ptr caller)
+{
+    UInt64 start;
+    IArg key;
+
+    if (GateMP_profIsOwner(obj->prof)) {
+        key = IGateProvider_enter(obj->gateHandle);
+        GateMP_profNested(obj->prof);
+        return (key);
+    }
+
+    start = GateMP_getTime();
+    key = IGateProvider_enter(obj->gateHandle);
+    GateMP_profAcquired(obj->prof, caller, start);
+
+    return (key);
+}
+
+/*
+ *  ======== GateMP_profLeave ========
+ */
+static Void GateMP_profLeave(GateMP_Object *obj)
+{
+    GateMP_Prof *prof = obj->prof;
+    UInt64 hold;
+
+    if (prof->depth > 1) {
+        prof->depth--;
+        return;
+    }
+
+    hold = GateMP_getTime() - prof->enterTime;
+    prof->stats.holdHist[GateMP_profBucket(hold)]++;
+    prof->stats.totalHoldTime += hold;
+    if (hold > prof->stats.maxHoldTime) {
+        prof->stats.maxHoldTime = hold;
+    }
+
+    prof->depth = 0;
+    __atomic_store_n(&prof->owner, (pthread_t)0, __ATOMIC_RELAXED);
+}
+
 IArg GateMP_enter(GateMP_Handle handle)
 {
     GateMP_Object * obj;
     IArg            key;
 
     obj = (GateMP_Object *)handle;
+
+    if (obj->prof != NULL) {
+        return (GateMP_profEnter(obj, __builtin_return_address(0)));
+    }
+
     key = IGateProvider_enter(obj->gateHandle);
 
     return(key);
@@ -945,5 +1483,407 @@ Void GateMP_leave(GateMP_Handle handle, IArg key)
     GateMP_Object *obj;
 
     obj = (GateMP_Object *)handle;
+
+    if (obj->prof != NULL) {
+        GateMP_profLeave(obj);
+    }
+
     IGateProvider_leave(obj->gateHandle, key);
 }
+
+/*
+ *  ======== GateMP_tryLock ========
+ *  One attempt to enter the gate of an instance.
+ */
+static Int GateMP_tryLock(GateMP_Object *obj, IArg *key)
+{
+    Int status;
+
+    if (obj->remoteProtect != GateMP_RemoteProtect_NONE) {
+        status = GateHWSpinlock_tryEnter(
+            (GateHWSpinlock_Handle)obj->gateHandle, key);
+    }
+    else if (obj->localProtect == GateMP_LocalProtect_PROCESS) {
+        status = GateProcess_tryEnter((GateProcess_Handle)obj->gateHandle,
+            key);
+    }
+    else {
+        status = GateMutex_tryEnter((GateMutex_Handle)obj->gateHandle, key);
+    }
+
+    return ((status < 0) ? GateMP_E_BUSY : GateMP_S_SUCCESS);
+}
+
+/*
+ *  ======== GateMP_tryEnter ========
+ */
+Int GateMP_tryEnter(GateMP_Handle handle, IArg *key)
+{
+    GateMP_Object *obj = (GateMP_Object *)handle;
+    UInt64 start = 0;
+    Int status;
+
+    if ((obj->prof != NULL) && GateMP_profIsOwner(obj->prof)) {
+        status = GateMP_tryLock(obj, key);
+        if (status == GateMP_S_SUCCESS) {
+            GateMP_profNested(obj->prof);
+        }
+        return (status);
+    }
+
+    if (obj->prof != NULL) {
+        start = GateMP_getTime();
+    }
+
+    status = GateMP_tryLock(obj, key);
+
+    if ((status == GateMP_S_SUCCESS) && (obj->prof != NULL)) {
+        GateMP_profAcquired(obj->prof, __builtin_return_address(0), start);
+    }
+
+    return (status);
+}
+
+/*
+ *  ======== GateMP_enterTimeout ========
+ *  Retries the gate with sleeps that double from 1 usec up to 1 msec,
+ *  but never past the deadline, so the gate may be taken up to a sleep
+ *  after it was released.
+ */
+Int GateMP_enterTimeout(GateMP_Handle handle, UInt timeout, IArg *key)
+{
+    GateMP_Object *obj = (GateMP_Object *)handle;
+    struct timespec ts;
+    UInt64 start;
+    UInt64 deadline;
+    UInt64 now;
+    UInt64 sleepNsec = 1000;
+    Int status;
+
+    if ((obj->prof != NULL) && GateMP_profIsOwner(obj->prof)) {
+        status = GateMP_tryLock(obj, key);
+        if (status == GateMP_S_SUCCESS) {
+            GateMP_profNested(obj->prof);
+        }
+        return (status);
+    }
+
+    start = GateMP_getTime();
+    deadline = start + (UInt64)timeout * 1000;
+
+    while ((status = GateMP_tryLock(obj, key)) == GateMP_E_BUSY) {
+        now = GateMP_getTime();
+        if (now >= deadline) {
+            return (GateMP_E_TIMEOUT);
+        }
+
+        if (sleepNsec > deadline - now) {
+            sleepNsec = deadline - now;
+        }
+        ts.tv_sec = 0;
+        ts.tv_nsec = sleepNsec;
+        nanosleep(&ts, NULL);
+
+        if (sleepNsec < 1000000) {
+            sleepNsec <<= 1;
+        }
+    }
+
+    if (obj->prof != NULL) {
+        GateMP_profAcquired(obj->prof, __builtin_return_address(0), start);
+    }
+
+    return (status);
+}
+
+/*
+ *  ======== GateMP_getStats ========
+ */
+Int GateMP_getStats(GateMP_Handle handle, GateMP_Stats *stats)
+{
+    GateMP_Object *obj = (GateMP_Object *)handle;
+    GateMP_CallSite site;
+    IArg key;
+    Int i;
+    Int j;
+
+    if ((obj == NULL) || (stats == NULL)) {
+        return (GateMP_E_INVALIDARG);
+    }
+
+    if (obj->prof == NULL) {
+        return (GateMP_E_INVALIDSTATE);
+    }
+
+    /* bypass GateMP_enter(), reading the stats must not change them */
+    key = IGateProvider_enter(obj->gateHandle);
+    memcpy(stats, &obj->prof->stats, sizeof(GateMP_Stats));
+    IGateProvider_leave(obj->gateHandle, key);
+
+    /* most samples first */
+    for (i = 1; i < GateMP_STATSSITES; i++) {
+        site = stats->sites[i];
+        for (j = i; (j > 0) && (stats->sites[j - 1].samples < site.samples);
+            j--) {
+            stats->sites[j] = stats->sites[j - 1];
+        }
+        stats->sites[j] = site;
+    }
+
+    return (GateMP_S_SUCCESS);
+}
+
+/*
+ *  ======== GateMP_resetStats ========
+ */
+Int GateMP_resetStats(GateMP_Handle handle)
+{
+    GateMP_Object *obj = (GateMP_Object *)handle;
+    IArg key;
+
+    if (obj == NULL) {
+        return (GateMP_E_INVALIDARG);
+    }
+
+    if (obj->prof == NULL) {
+        return (GateMP_E_INVALIDSTATE);
+    }
+
+    key = IGateProvider_enter(obj->gateHandle);
+    memset(&obj->prof->stats, 0, sizeof(GateMP_Stats));
+    IGateProvider_leave(obj->gateHandle, key);
+
+    return (GateMP_S_SUCCESS);
+}
+
+/*
+ *  ======== GateMP_profCreate ========
+ *  Start collecting statistics of a new instance object.
+ */
+static Void GateMP_profCreate(GateMP_Object *obj, String name)
+{
+    GateMP_Prof *prof;
+
+    if (!GateMP_module->profile) {
+        return;
+    }
+
+    prof = (GateMP_Prof *)calloc(1, sizeof(GateMP_Prof));
+    if (prof == NULL) {
+        PRINTVERBOSE0("GateMP_profCreate: memory allocation failed\n")
+        return;
+    }
+
+    if (name != NULL) {
+        strncpy(prof->name, name, GateMP_PROFNAMELEN - 1);
+    }
+
+    pthread_mutex_lock(&GateMP_module->profLock);
+    prof->next = GateMP_module->profList;
+    GateMP_module->profList = prof;
+    pthread_mutex_unlock(&GateMP_module->profLock);
+
+    obj->prof = prof;
+}
+
+/*
+ *  ======== GateMP_profDelete ========
+ */
+static Void GateMP_profDelete(GateMP_Object *obj)
+{
+    GateMP_Prof **link;
+
+    if (obj->prof == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&GateMP_module->profLock);
+    for (link = &GateMP_module->profList; *link != NULL;
+        link = &(*link)->next) {
+        if (*link == obj->prof) {
+            *link = obj->prof->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&GateMP_module->profLock);
+
+    free(obj->prof);
+    obj->prof = NULL;
+}
+
+/*
+ *  ======== GateMP_profPrintHist ========
+ */
+static Void GateMP_profPrintHist(FILE *out, const char *label,
+    const UInt32 *hist)
+{
+    Int i;
+
+    fprintf(out, "    %s histogram (usec:count):", label);
+    for (i = 0; i < GateMP_STATSBUCKETS; i++) {
+        if (hist[i] == 0) {
+            continue;
+        }
+        if (i == GateMP_STATSBUCKETS - 1) {
+            fprintf(out, " >=%u:%u", 1u << (i - 1), hist[i]);
+        }
+        else {
+            fprintf(out, " <%u:%u", 1u << i, hist[i]);
+        }
+    }
+    fprintf(out, "\n");
+}
+
+/*
+ *  ======== GateMP_profDump ========
+ *  Print the statistics of all instances.  The gates are not entered, a
+ *  dump must not hang on a gate held by a stuck thread, so the numbers
+ *  of busy gates may be slightly inconsistent.
+ */
+static Void GateMP_profDump(FILE *out)
+{
+    GateMP_Prof *prof;
+    GateMP_Stats stats;
+    Int i;
+
+    fprintf(out, "GateMP statistics of pid %d\n", getpid());
+
+    pthread_mutex_lock(&GateMP_module->profLock);
+
+    for (prof = GateMP_module->profList; prof != NULL; prof = prof->next) {
+        memcpy(&stats, &prof->stats, sizeof(GateMP_Stats));
+
+        fprintf(out, "  %s: %u enters, %u contended, %u nested "
+            "(max depth %u)\n", prof->name[0] ? prof->name : "(unnamed)",
+            stats.numEnters, stats.numContended, stats.numNested,
+            stats.maxDepth);
+        if (stats.numEnters == 0) {
+            continue;
+        }
+        fprintf(out, "    wait usec: mean %.1f max %.1f, "
+            "hold usec: mean %.1f max %.1f\n",
+            stats.totalWaitTime / 1000.0 / stats.numEnters,
+            stats.maxWaitTime / 1000.0,
+            stats.totalHoldTime / 1000.0 / stats.numEnters,
+            stats.maxHoldTime / 1000.0);
+        GateMP_profPrintHist(out, "wait", stats.waitHist);
+        GateMP_profPrintHist(out, "hold", stats.holdHist);
+        for (i = 0; i < GateMP_STATSSITES; i++) {
+            if (stats.sites[i].samples == 0) {
+                continue;
+            }
+            fprintf(out, "    caller %p: %u samples, mean wait %.1f usec\n",
+                stats.sites[i].addr, stats.sites[i].samples,
+                stats.sites[i].waitTime / 1000.0 / stats.sites[i].samples);
+        }
+    }
+
+    pthread_mutex_unlock(&GateMP_module->profLock);
+
+    fflush(out);
+}
+
+/*
+ *  ======== GateMP_profSignal ========
+ *  SIGUSR2 handler, only does what is async-signal-safe.
+ */
+static void GateMP_profSignal(int sig)
+{
+    Int saved = errno;
+    Char c = 0;
+    (Void)sig;
+
+    if (write(GateMP_module->profPipe[1], &c, 1) < 0) {
+        /* a dump is already pending */
+    }
+
+    errno = saved;
+}
+
+/*
+ *  ======== GateMP_profThreadFxn ========
+ *  Write a dump for each SIGUSR2, until GateMP_profStop() closes the pipe.
+ */
+static void *GateMP_profThreadFxn(void *arg)
+{
+    FILE *out;
+    Char c;
+    ssize_t n;
+    (Void)arg;
+
+    for (;;) {
+        n = read(GateMP_module->profPipe[0], &c, 1);
+        if ((n < 0) && (errno == EINTR)) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+
+        if (GateMP_module->profPath == NULL) {
+            GateMP_profDump(stderr);
+        }
+        else if ((out = fopen(GateMP_module->profPath, "a")) != NULL) {
+            GateMP_profDump(out);
+            fclose(out);
+        }
+    }
+
+    return (NULL);
+}
+
+/*
+ *  ======== GateMP_profStart ========
+ *  Enable profiling of the instances created or opened from now on, and
+ *  dump their statistics on SIGUSR2.
+ */
+static Int GateMP_profStart(String path)
+{
+    struct sigaction action;
+
+    GateMP_module->profPath = (path[0] == '/') ? path : NULL;
+
+    if (pipe(GateMP_module->profPipe) < 0) {
+        return (GateMP_E_OSFAILURE);
+    }
+
+    /* never let the signal handler block */
+    fcntl(GateMP_module->profPipe[1], F_SETFL, O_NONBLOCK);
+
+    if (pthread_create(&GateMP_module->profThread, NULL,
+        GateMP_profThreadFxn, NULL) != 0) {
+        close(GateMP_module->profPipe[0]);
+        close(GateMP_module->profPipe[1]);
+        GateMP_module->profPipe[0] = GateMP_module->profPipe[1] = -1;
+        return (GateMP_E_OSFAILURE);
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = GateMP_profSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGUSR2, &action, &GateMP_module->profOldAction);
+
+    GateMP_module->profile = TRUE;
+
+    return (GateMP_S_SUCCESS);
+}
+
+/*
+ *  ======== GateMP_profStop ========
+ */
+static Void GateMP_profStop(Void)
+{
+    if (GateMP_module->profPipe[1] == -1) {
+        return;
+    }
+
+    GateMP_module->profile = FALSE;
+    sigaction(SIGUSR2, &GateMP_module->profOldAction, NULL);
+
+    /* end of file stops the dump thread */
+    close(GateMP_module->profPipe[1]);
+    pthread_join(GateMP_module->profThread, NULL);
+    close(GateMP_module->profPipe[0]);
+    GateMP_module->profPipe[0] = GateMP_module->profPipe[1] = -1;
+}
@@ -132,6 +132,18 @@ IArg GateMutex_enter (GateMutex_Handle gmHandle)
     return (IArg)ret;
 }
 
+Int GateMutex_tryEnter (GateMutex_Handle gmHandle, IArg * key)
+{
+    GateMutex_Object * obj = (GateMutex_Object *)gmHandle;
+    int ret;
+
+    ret = pthread_mutex_trylock(&(obj->mutex));
+    *key = (IArg)0;
+
+    /* the mutex is recursive, so this only fails for other threads */
+    return ((ret == 0) ? GateMutex_S_SUCCESS : GateMutex_E_BUSY);
+}
+
 Void GateMutex_leave (GateMutex_Handle gmHandle, IArg key)
 {
     GateMutex_Object * obj = (GateMutex_Object *)gmHandle;
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== GateProcess.c ========
+ *
+ *  The gate is a robust, recursive, process shared pthread mutex in a
+ *  named POSIX shared memory segment.  An uncontended enter is a single
+ *  atomic operation in the C library, and a process dying inside the gate
+ *  hands it to the next waiter with EOWNERDEAD instead of locking out the
+ *  others for good.
+ *
+ *  The segment counts the instances mapping it.  The last one to be
+ *  deleted (or one created with the unlink parameter) removes the name
+ *  while holding the gate, and marks the segment removed so a process that
+ *  opened the name just before retries with a fresh segment.
+ *
+ *  Android's C library has neither shm_open() nor robust mutexes.  There
+ *  the segment is a file in LAD's working directory, which every IPC
+ *  process already uses, and a process dying inside the gate locks out
+ *  the others.
+ */
+
+
+/* Standard headers */
+#include <ti/ipc/Std.h>
+
+/* Linux headers */
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <IGateProvider.h>
+#include <GateProcess.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+
+/* -----------------------------------------------------------------------------
+ *  Structs & Enums
+ * -----------------------------------------------------------------------------
+ */
+/* layout of the shared memory segment */
+typedef struct {
+    pthread_mutex_t mutex;      /* the gate */
+    UInt32 ready;               /* set by the creator once mutex is usable */
+    UInt32 users;               /* instances mapping the segment */
+    UInt32 removed;             /* the name was unlinked, open it again */
+} GateProcess_Shared;
+
+struct GateProcess_Object {
+    IGateProvider_SuperObject;  /* For inheritance from IGateProvider */
+    GateProcess_Shared *shared; /* mapping of the segment */
+    Char name[GateProcess_MAXNAMELEN];
+    Bool unlink;
+};
+
+
+/* -----------------------------------------------------------------------------
+ *  Forward declarations
+ * -----------------------------------------------------------------------------
+ */
+IArg GateProcess_enter(GateProcess_Handle handle);
+Void GateProcess_leave(GateProcess_Handle handle, IArg key);
+
+
+/* -----------------------------------------------------------------------------
+ *  Globals
+ * -----------------------------------------------------------------------------
+ */
+static GateProcess_Params GateProcess_defInstParams =
+{
+    .name       = NULL,
+    .openFlag   = FALSE,
+    .unlink     = FALSE
+};
+
+
+/* -----------------------------------------------------------------------------
+ *  Internal functions
+ * -----------------------------------------------------------------------------
+ */
+#if defined(IPC_BUILDOS_ANDROID)
+/* LAD_WORKINGDIR without the trailing '/', segment names start with one */
+#define GateProcess_SHMDIR "/data/lad/LAD"
+
+static int GateProcess_shmOpen(String name, int oflag, mode_t mode)
+{
+    Char path[sizeof(GateProcess_SHMDIR) + GateProcess_MAXNAMELEN];
+
+    snprintf(path, sizeof(path), "%s%s", GateProcess_SHMDIR, name);
+
+    return (open(path, oflag, mode));
+}
+
+static int GateProcess_shmUnlink(String name)
+{
+    Char path[sizeof(GateProcess_SHMDIR) + GateProcess_MAXNAMELEN];
+
+    snprintf(path, sizeof(path), "%s%s", GateProcess_SHMDIR, name);
+
+    return (unlink(path));
+}
+
+#define shm_open GateProcess_shmOpen
+#define shm_unlink GateProcess_shmUnlink
+#endif
+
+/*
+ *  Lock the mutex of a segment.  If its previous owner died, the gate is
+ *  taken over as is; there is no way to repair what the owner was doing.
+ */
+static Int GateProcess_lock(GateProcess_Shared *shared, Bool wait)
+{
+    int ret;
+
+    ret = wait ? pthread_mutex_lock(&shared->mutex) :
+        pthread_mutex_trylock(&shared->mutex);
+
+#if !defined(IPC_BUILDOS_ANDROID)
+    if (ret == EOWNERDEAD) {
+        pthread_mutex_consistent(&shared->mutex);
+        ret = 0;
+    }
+#endif
+
+    return (ret == 0 ? GateProcess_S_SUCCESS :
+        (ret == EBUSY ? GateProcess_E_BUSY : GateProcess_E_FAIL));
+}
+
+/* initialize the gate of a segment this process has just created */
+static Int GateProcess_initShared(GateProcess_Shared *shared)
+{
+    pthread_mutexattr_t attr;
+    int ret;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+#if !defined(IPC_BUILDOS_ANDROID)
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+#endif
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    ret = pthread_mutex_init(&shared->mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    if (ret != 0) {
+        return (GateProcess_E_FAIL);
+    }
+
+    __atomic_store_n(&shared->ready, 1, __ATOMIC_RELEASE);
+
+    return (GateProcess_S_SUCCESS);
+}
+
+/*
+ *  Map the segment 'name', creating it unless openFlag is set, and count
+ *  this instance as a user of it.  Returns NULL if the segment doesn't
+ *  exist (openFlag) or can't be set up.
+ */
+static GateProcess_Shared *GateProcess_map(String name, Bool openFlag)
+{
+    GateProcess_Shared *shared;
+    Bool created;
+    Ptr addr;
+    UInt i;
+    int fd;
+
+    while (1) {
+        created = FALSE;
+        fd = -1;
+
+        if (!openFlag) {
+            fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+            created = (fd >= 0);
+            if ((fd < 0) && (errno != EEXIST)) {
+                return (NULL);
+            }
+        }
+        if (fd < 0) {
+            fd = shm_open(name, O_RDWR | O_CLOEXEC, 0);
+            if (fd < 0) {
+                if ((errno == ENOENT) && !openFlag) {
+                    continue;   /* removed since, create it again */
+                }
+                return (NULL);
+            }
+        }
+
+        /*
+         *  Every user sizes the segment before mapping it, so it is never
+         *  mapped short.  A new segment is zero filled.
+         */
+        if (ftruncate(fd, sizeof(GateProcess_Shared)) < 0) {
+            close(fd);
+            return (NULL);
+        }
+
+        addr = mmap(NULL, sizeof(GateProcess_Shared), PROT_READ | PROT_WRITE,
+            MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (addr == MAP_FAILED) {
+            return (NULL);
+        }
+        shared = (GateProcess_Shared *)addr;
+
+        if (created) {
+            if (GateProcess_initShared(shared) < 0) {
+                munmap(addr, sizeof(GateProcess_Shared));
+                shm_unlink(name);
+                return (NULL);
+            }
+        }
+        else {
+            /* the creator may still be initializing the mutex */
+            for (i = 0; (i < GateProcess_READYMSEC) &&
+                !__atomic_load_n(&shared->ready, __ATOMIC_ACQUIRE); i++) {
+                usleep(1000);
+            }
+            if (!__atomic_load_n(&shared->ready, __ATOMIC_ACQUIRE)) {
+                munmap(addr, sizeof(GateProcess_Shared));
+                return (NULL);
+            }
+        }
+
+        if (GateProcess_lock(shared, TRUE) < 0) {
+            munmap(addr, sizeof(GateProcess_Shared));
+            return (NULL);
+        }
+
+        if (!shared->removed) {
+            shared->users++;
+            pthread_mutex_unlock(&shared->mutex);
+            return (shared);
+        }
+
+        /* the last user removed it after we opened it, try again */
+        pthread_mutex_unlock(&shared->mutex);
+        munmap(addr, sizeof(GateProcess_Shared));
+        if (openFlag) {
+            return (NULL);
+        }
+    }
+}
+
+
+/* -----------------------------------------------------------------------------
+ *  APIs
+ * -----------------------------------------------------------------------------
+ */
+Void GateProcess_Params_init(GateProcess_Params *params)
+{
+    if (params != NULL) {
+        memcpy(params, &GateProcess_defInstParams,
+            sizeof(GateProcess_Params));
+    }
+}
+
+GateProcess_Handle GateProcess_create(const GateProcess_Params *params)
+{
+    GateProcess_Object *obj;
+
+    if ((params == NULL) || (params->name == NULL) ||
+        (strlen(params->name) >= GateProcess_MAXNAMELEN)) {
+        return (NULL);
+    }
+
+    obj = (GateProcess_Object *)calloc(1, sizeof(GateProcess_Object));
+    if (obj == NULL) {
+        return (NULL);
+    }
+
+    IGateProvider_ObjectInitializer(obj, GateProcess);
+    strcpy(obj->name, params->name);
+    obj->unlink = params->unlink;
+
+    obj->shared = GateProcess_map(obj->name, params->openFlag);
+    if (obj->shared == NULL) {
+        free(obj);
+        return (NULL);
+    }
+
+    return ((GateProcess_Handle)obj);
+}
+
+Int GateProcess_delete(GateProcess_Handle *handle)
+{
+    GateProcess_Object *obj;
+    GateProcess_Shared *shared;
+
+    if ((handle == NULL) || (*handle == NULL)) {
+        return (GateProcess_E_INVALIDARG);
+    }
+
+    obj = (GateProcess_Object *)*handle;
+    shared = obj->shared;
+
+    /* remove the name with the gate held, see GateProcess_map() */
+    if (GateProcess_lock(shared, TRUE) == GateProcess_S_SUCCESS) {
+        shared->users--;
+        if (((shared->users == 0) || obj->unlink) && !shared->removed) {
+            shared->removed = 1;
+            shm_unlink(obj->name);
+        }
+        pthread_mutex_unlock(&shared->mutex);
+    }
+
+    munmap(shared, sizeof(GateProcess_Shared));
+
+    free(obj);
+    *handle = NULL;
+
+    return (GateProcess_S_SUCCESS);
+}
+
+IArg GateProcess_enter(GateProcess_Handle handle)
+{
+    GateProcess_Object *obj = (GateProcess_Object *)handle;
+
+    GateProcess_lock(obj->shared, TRUE);
+
+    return (0);
+}
+
+Int GateProcess_tryEnter(GateProcess_Handle handle, IArg *key)
+{
+    GateProcess_Object *obj = (GateProcess_Object *)handle;
+
+    *key = 0;
+
+    return (GateProcess_lock(obj->shared, FALSE));
+}
+
+Void GateProcess_leave(GateProcess_Handle handle, IArg key)
+{
+    GateProcess_Object *obj = (GateProcess_Object *)handle;
+    (Void)key;
+
+    pthread_mutex_unlock(&obj->shared->mutex);
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
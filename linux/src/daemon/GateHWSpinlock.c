@@ -63,6 +63,7 @@ typedef UInt32            Error_Block;
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include <linux/hwspinlock_user.h>
 
@@ -76,6 +77,7 @@ typedef struct {
     UInt32 *                        baseAddr;   /* base addr lock registers */
     GateMutex_Handle                gmHandle;   /* handle to gate mutex */
     Bool                            useHwlockDrv; /* use the hwspinlock driver */
+    Bool                            useShm;     /* emulate locks in shm */
 } GateHWSpinlock_Module_State;
 
 /* GateHWSpinlock instance object */
@@ -100,6 +102,7 @@ static GateHWSpinlock_Module_State GateHWSpinlock_state =
     .baseAddr = NULL,
     .gmHandle = NULL,
     .useHwlockDrv = false,
+    .useShm = false,
 };
 
 static GateHWSpinlock_Module_State *Mod = &GateHWSpinlock_state;
@@ -122,15 +125,29 @@ static GateHWSpinlock_Params GateHWSpinlock_defInstParams =
 Int32 GateHWSpinlock_start(Void)
 {
     Int32               status = GateHWSpinlock_S_SUCCESS;
-    UInt32              dst;
-
-    /* Fall back to /dev/mem if hwspinlock_user driver is not supported */
-    Mod->fd = open("/dev/hwspinlock", O_RDWR);
-    if (Mod->fd < 0) {
-        Mod->fd = open ("/dev/mem", O_RDWR | O_SYNC);
+    Char *              dst;
+
+    if (_GateHWSpinlock_cfgParams.backend == GateHWSpinlock_Backend_SHM) {
+        /* start from a new file, i.e. with all locks free */
+        Mod->useShm = true;
+        shm_unlink(GateHWSpinlock_SHMNAME);
+        Mod->fd = shm_open(GateHWSpinlock_SHMNAME,
+            O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+        if ((Mod->fd >= 0) && ((fchmod(Mod->fd, 0666) < 0) ||
+            (ftruncate(Mod->fd, _GateHWSpinlock_cfgParams.size) < 0))) {
+            close(Mod->fd);
+            Mod->fd = -1;
+        }
     }
     else {
-        Mod->useHwlockDrv = true;
+        /* Fall back to /dev/mem if hwspinlock_user driver is not supported */
+        Mod->fd = open("/dev/hwspinlock", O_RDWR);
+        if (Mod->fd < 0) {
+            Mod->fd = open ("/dev/mem", O_RDWR | O_SYNC);
+        }
+        else {
+            Mod->useHwlockDrv = true;
+        }
     }
 
     if (Mod->fd < 0){
@@ -140,12 +157,12 @@ Int32 GateHWSpinlock_start(Void)
 
     /* map the hardware lock registers into the local address space */
     if (!Mod->useHwlockDrv && status == GateHWSpinlock_S_SUCCESS) {
-        dst = (UInt32)mmap(NULL, _GateHWSpinlock_cfgParams.size,
+        dst = (Char *)mmap(NULL, _GateHWSpinlock_cfgParams.size,
                             (PROT_READ | PROT_WRITE),
-                            (MAP_SHARED), Mod->fd,
+                            (MAP_SHARED), Mod->fd, Mod->useShm ? 0 :
                             (off_t)_GateHWSpinlock_cfgParams.baseAddr);
 
-        if (dst == (UInt32)MAP_FAILED) {
+        if (dst == (Char *)MAP_FAILED) {
             LOG0("GateHWSpinlock_start: Memory map failed")
             status = GateHWSpinlock_E_OSFAILURE;
             close(Mod->fd);
@@ -185,8 +202,14 @@ Int GateHWSpinlock_stop(Void)
 
     /* release lock register mapping */
     if (!Mod->useHwlockDrv && (Mod->baseAddr != NULL)) {
-        munmap((void *)_GateHWSpinlock_cfgParams.baseAddr,
+        munmap((Char *)Mod->baseAddr - _GateHWSpinlock_cfgParams.offset,
            _GateHWSpinlock_cfgParams.size);
+        Mod->baseAddr = NULL;
+    }
+
+    if (Mod->useShm) {
+        shm_unlink(GateHWSpinlock_SHMNAME);
+        Mod->useShm = false;
     }
 
     /* close the spinlock device file */
@@ -283,6 +306,11 @@ IArg GateHWSpinlock_enter(GateHWSpinlock_Object *obj)
         if (Mod->useHwlockDrv) {
             locked = !ioctl(Mod->fd, HWSPINLOCK_USER_LOCK, &data);
         }
+        else if (Mod->useShm) {
+            /* same test-and-set semantics as the lock register */
+            locked = (__atomic_exchange_n(&baseAddr[obj->lockNum], 1,
+                __ATOMIC_ACQUIRE) == 0);
+        }
         else {
             /* read the spinlock, returns non-zero when we get it */
             locked = (baseAddr[obj->lockNum] == 0);
@@ -318,6 +346,9 @@ Int GateHWSpinlock_leave(GateHWSpinlock_Object *obj, IArg key)
         if (Mod->useHwlockDrv) {
             ioctl(Mod->fd, HWSPINLOCK_USER_UNLOCK, &data);
         }
+        else if (Mod->useShm) {
+            __atomic_store_n(&baseAddr[obj->lockNum], 0, __ATOMIC_RELEASE);
+        }
         else {
             baseAddr[obj->lockNum] = 0;
         }
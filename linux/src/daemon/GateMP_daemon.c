@@ -100,12 +100,14 @@ typedef struct {
     Bool              isSetup;
     Int               refCount[MultiProc_MAXPROCESSORS];
     UInt16            attachedProcId;
+    Bool              emulated;
 } GateMP_ModuleObject;
 
 /* Internal functions */
 static Int GateMP_get_sr0(Char *name, UInt32 name_len, UInt32 *baseaddr);
 static Int GateMP_openDefaultGate(GateMP_Handle *handlePtr, UInt16 procId[]);
 static Int GateMP_closeDefaultGate(GateMP_Handle *handlePtr);
+static Int GateMP_setupEmulated(Void);
 
 /* =============================================================================
  *  Globals
@@ -126,6 +128,7 @@ static GateMP_ModuleObject GateMP_state = {
     .isSetup                         = FALSE,
     .refCount                        = {0},
     .attachedProcId                  = MultiProc_INVALIDID,
+    .emulated                        = FALSE,
 };
 
 static GateMP_ModuleObject * GateMP_module = &GateMP_state;
@@ -159,13 +162,74 @@ Int GateMP_setup(Void)
         status = GateMP_E_FAIL;
         LOG0("GateMP_setup: NameServer_create failed\n");
     }
-    else {
+    else if (_GateHWSpinlock_cfgParams.backend ==
+            GateHWSpinlock_Backend_SHM) {
+        status = GateMP_setupEmulated();
+        if (status < 0) {
+            GateMP_destroy();
+        }
+    }
+
+    if (status == GateMP_S_SUCCESS) {
         GateMP_module->isSetup = TRUE;
     }
 
     return status;
 }
 
+/*
+ *  With emulated spinlocks there is no remote core to provide the default
+ *  gate and the gate resource table, so LAD provides them itself.  As on
+ *  the remote cores, lock 0 is reserved for the default gate.
+ */
+static Int GateMP_setupEmulated(Void)
+{
+    GateMP_Handle     gate;
+    UInt32            nsValue[4];
+    UInt16            procList[2];
+    Int               status;
+
+    GateMP_module->numRemoteSystem = (_GateHWSpinlock_cfgParams.size -
+        _GateHWSpinlock_cfgParams.offset) / sizeof(UInt32);
+    GateMP_module->remoteSystemInUse =
+        calloc(GateMP_module->numRemoteSystem, sizeof(UInt8));
+
+    if (GateMP_module->remoteSystemInUse == NULL) {
+        LOG0("GateMP_setupEmulated: memory allocation failed\n");
+        return (GateMP_E_MEMORY);
+    }
+    GateMP_module->remoteSystemInUse[0] = RESERVED;
+
+    /* same entry as the one a remote core would add, see GateMP_open() */
+    nsValue[0] = getpid();
+    nsValue[1] = MultiProc_self() << 16 | 1;
+    nsValue[2] = 0;
+    nsValue[3] = SETMASK(GateMP_RemoteProtect_SYSTEM,
+        GateMP_LocalProtect_PROCESS);
+
+    if (NameServer_add(GateMP_module->nameServer, "_GateMP_TI_dGate",
+            &nsValue, sizeof(nsValue)) == NULL) {
+        LOG0("GateMP_setupEmulated: NameServer_add failed\n");
+        return (GateMP_E_FAIL);
+    }
+
+    procList[0] = MultiProc_self();
+    procList[1] = MultiProc_INVALIDID;
+    status = GateMP_openDefaultGate(&gate, procList);
+    if (status < 0) {
+        LOG0("GateMP_setupEmulated: failed to open default gate\n");
+        return (status);
+    }
+
+    GateMP_module->defaultGate = gate;
+    GateMP_module->emulated = TRUE;
+
+    LOG1("GateMP_setupEmulated: %d gates in emulated spinlocks\n",
+        GateMP_module->numRemoteSystem);
+
+    return (GateMP_S_SUCCESS);
+}
+
 Int GateMP_attach(UInt16 procId)
 {
     GateMP_Handle     deflateGate;  /* that's right, Pats fan here */
@@ -190,7 +254,7 @@ Int GateMP_attach(UInt16 procId)
     }
 
     /* must reference count because we have multiple clients */
-    if (GateMP_module->refCount[clId] > 0) {
+    if ((GateMP_module->refCount[clId] > 0) || GateMP_module->emulated) {
         GateMP_module->refCount[clId]++;
         goto done;
     }
@@ -352,7 +416,8 @@ Int GateMP_detach(UInt16 procId)
 {
     UInt16 clId;
 
-    if (procId != GateMP_module->attachedProcId) {
+    if ((procId != GateMP_module->attachedProcId) &&
+        !GateMP_module->emulated) {
         return GateMP_E_NOTFOUND;
     }
 
@@ -366,7 +431,7 @@ Int GateMP_detach(UInt16 procId)
 
 
     /* decrement reference count regardless of outcome below */
-    if (--GateMP_module->refCount[clId] > 0) {
+    if ((--GateMP_module->refCount[clId] > 0) || GateMP_module->emulated) {
         goto done;
     }
 
@@ -400,6 +465,18 @@ done:
 
 Void GateMP_destroy(Void)
 {
+    /* LAD's own default gate and resources, see GateMP_setupEmulated() */
+    if (GateMP_module->defaultGate && GateMP_module->emulated) {
+        GateMP_closeDefaultGate(&GateMP_module->defaultGate);
+    }
+
+    if (GateMP_module->remoteSystemInUse && GateMP_module->emulated) {
+        free(GateMP_module->remoteSystemInUse);
+        GateMP_module->remoteSystemInUse = NULL;
+        GateMP_module->numRemoteSystem = 0;
+    }
+    GateMP_module->emulated = FALSE;
+
     if (GateMP_module->nameServer) {
         NameServer_delete(&GateMP_module->nameServer);
         GateMP_module->nameServer = NULL;
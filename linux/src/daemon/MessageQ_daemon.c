@@ -127,6 +127,8 @@ typedef struct MessageQ_Object {
     /* NameServer key */
     Int                     ownerPid;
     /* Process ID of owner */
+    Bool                    leased;
+    /* Index is leased to ownerPid, queue lives in the client */
 } MessageQ_Object;
 
 
@@ -166,6 +168,13 @@ MessageQ_ModuleObject * MessageQ_module = &MessageQ_state;
 /* Grow the MessageQ table */
 static UInt16 _MessageQ_grow(MessageQ_Object * obj);
 
+/* Grow the MessageQ table to hold at least numQueues entries */
+static Void _MessageQ_growTo(UInt numQueues);
+
+/* Find the leased object backing queueId, owned by pid */
+static MessageQ_Object * _MessageQ_findLeased(MessageQ_QueueId queueId,
+        Int pid);
+
 /* =============================================================================
  * APIS
  * =============================================================================
@@ -455,27 +464,45 @@ MessageQ_QueueId MessageQ_getQueueId(MessageQ_Handle handle)
 static UInt16 _MessageQ_grow(MessageQ_Object * obj)
 {
     UInt16            queueIndex = MessageQ_module->numQueues;
+
+    /* No parameter validation required since this is an internal function. */
+    _MessageQ_growTo(MessageQ_module->numQueues + MessageQ_GROWSIZE);
+
+    /* Fill in the new entry */
+    MessageQ_module->queues[queueIndex] = (MessageQ_Handle)obj;
+
+    LOG1("_MessageQ_grow: queueIndex: 0x%x\n", queueIndex)
+
+    return (queueIndex);
+}
+
+/*
+ *  ======== _MessageQ_growTo ========
+ *  Reallocate the MessageQ table with room for numQueues entries.
+ *  Caller must hold MessageQ_module->gate.
+ */
+static Void _MessageQ_growTo(UInt numQueues)
+{
     UInt16            oldSize;
     MessageQ_Handle * queues;
     MessageQ_Handle * oldQueues;
 
-    /* No parameter validation required since this is an internal function. */
+    if (numQueues <= MessageQ_module->numQueues) {
+        return;
+    }
+
     oldSize = (MessageQ_module->numQueues) * sizeof(MessageQ_Handle);
 
     /* Allocate larger table */
-    queues = calloc(MessageQ_module->numQueues + MessageQ_GROWSIZE,
-                    sizeof(MessageQ_Handle));
+    queues = calloc(numQueues, sizeof(MessageQ_Handle));
 
     /* Copy contents into new table */
     memcpy(queues, MessageQ_module->queues, oldSize);
 
-    /* Fill in the new entry */
-    queues[queueIndex] = (MessageQ_Handle)obj;
-
     /* Hook-up new table */
     oldQueues = MessageQ_module->queues;
     MessageQ_module->queues = queues;
-    MessageQ_module->numQueues += MessageQ_GROWSIZE;
+    MessageQ_module->numQueues = numQueues;
 
     /* Delete old table if not statically defined */
     if (MessageQ_module->canFreeQueues == TRUE) {
@@ -484,10 +511,30 @@ static UInt16 _MessageQ_grow(MessageQ_Object * obj)
     else {
         MessageQ_module->canFreeQueues = TRUE;
     }
+}
 
-    LOG1("_MessageQ_grow: queueIndex: 0x%x\n", queueIndex)
+/*
+ *  ======== _MessageQ_findLeased ========
+ */
+static MessageQ_Object * _MessageQ_findLeased(MessageQ_QueueId queueId,
+        Int pid)
+{
+    MessageQ_Object * obj = NULL;
+    UInt16            queueIndex;
 
-    return (queueIndex);
+    queueIndex = MessageQ_getQueueIndex(queueId);
+
+    if (queueIndex < MessageQ_module->numQueues) {
+        obj = (MessageQ_Object *)MessageQ_module->queues[queueIndex];
+    }
+
+    if ((obj == NULL) || (obj->leased == FALSE) || (obj->ownerPid != pid)) {
+        LOG2("_MessageQ_findLeased: Error: queueId 0x%x not leased to pid "
+                "%d\n", queueId, pid)
+        return (NULL);
+    }
+
+    return (obj);
 }
 
 /*
@@ -532,6 +579,189 @@ Void MessageQ_cleanupOwner(Int pid)
     }
 }
 
+/*
+ *  ======== MessageQ_lease ========
+ *  Reserve a contiguous block of count queue indexes for client pid.
+ *
+ *  Each index is backed by a placeholder object so the slot stays busy
+ *  and MessageQ_cleanupOwner() reclaims it when the client departs.
+ *  The client creates and deletes queues within the block on its own;
+ *  only names go through MessageQ_register()/MessageQ_unregister().
+ */
+Int MessageQ_lease(UInt16 count, Int pid, MessageQ_QueueId * baseId)
+{
+    MessageQ_Object * obj;
+    UInt16            procId;
+    UInt              numReserved;
+    UInt              base;
+    UInt              run = 0;
+    UInt              i;
+
+    if (count == 0) {
+        return (MessageQ_E_INVALIDARG);
+    }
+
+    numReserved = MessageQ_module->cfg->numReservedEntries;
+    procId = MultiProc_self();
+
+    pthread_mutex_lock(&(MessageQ_module->gate));
+
+    /* first fit; a run reaching the end of the table is extended below */
+    base = MessageQ_module->numQueues;
+    for (i = numReserved; i < MessageQ_module->numQueues; i++) {
+        if (MessageQ_module->queues[i] != NULL) {
+            run = 0;
+            continue;
+        }
+        if (run++ == 0) {
+            base = i;
+        }
+        if (run == count) {
+            break;
+        }
+    }
+
+    if (run == 0) {
+        base = (MessageQ_module->numQueues > numReserved) ?
+                MessageQ_module->numQueues : numReserved;
+    }
+
+    if (base + count > 0xFFFF - MessageQ_PORTOFFSET) {
+        pthread_mutex_unlock(&(MessageQ_module->gate));
+        LOG1("MessageQ_lease: Error: no room for %d queue indexes\n", count)
+        return (MessageQ_E_RESOURCE);
+    }
+
+    if (base + count > MessageQ_module->numQueues) {
+        _MessageQ_growTo(base + count + MessageQ_GROWSIZE);
+    }
+
+    for (i = base; i < base + count; i++) {
+        obj = (MessageQ_Object *)calloc(1, sizeof(MessageQ_Object));
+
+        if (obj == NULL) {
+            /* give back what we took so far */
+            while (i-- > base) {
+                free(MessageQ_module->queues[i]);
+                MessageQ_module->queues[i] = NULL;
+            }
+            pthread_mutex_unlock(&(MessageQ_module->gate));
+            LOG0("MessageQ_lease: Error: no memory\n")
+            return (MessageQ_E_MEMORY);
+        }
+
+        obj->queue = (MessageQ_QueueId)(((UInt32)procId << 16) |
+                (i + MessageQ_PORTOFFSET));
+        obj->ownerPid = pid;
+        obj->leased = TRUE;
+        MessageQ_module->queues[i] = (MessageQ_Handle)obj;
+    }
+
+    pthread_mutex_unlock(&(MessageQ_module->gate));
+
+    *baseId = (MessageQ_QueueId)(((UInt32)procId << 16) |
+            (base + MessageQ_PORTOFFSET));
+
+    LOG3("MessageQ_lease: leased %d indexes at %d to pid %d\n", count, base,
+            pid)
+
+    return (MessageQ_S_SUCCESS);
+}
+
+/*
+ *  ======== MessageQ_releaseLeases ========
+ *  Return all leased indexes owned by pid, dropping any names on them.
+ */
+Void MessageQ_releaseLeases(Int pid)
+{
+    MessageQ_Handle queue;
+    Int i;
+
+    for (i = 0; i < MessageQ_module->numQueues; i++) {
+        queue = MessageQ_module->queues[i];
+        if (queue != NULL && queue->leased && queue->ownerPid == pid) {
+            MessageQ_delete(&queue);
+        }
+    }
+}
+
+/*
+ *  ======== MessageQ_register ========
+ *  Publish name for a queue the client created on a leased index.
+ */
+Int MessageQ_register(String name, MessageQ_QueueId queueId, Int pid)
+{
+    MessageQ_Object * obj;
+
+    obj = _MessageQ_findLeased(queueId, pid);
+
+    if (obj == NULL) {
+        return (MessageQ_E_FAIL);
+    }
+
+    return (MessageQ_announce(name, (MessageQ_Handle *)&obj));
+}
+
+/*
+ *  ======== MessageQ_unregister ========
+ *  Withdraw the name published for a leased index, keeping the lease.
+ */
+Int MessageQ_unregister(MessageQ_QueueId queueId, Int pid)
+{
+    Int               status = MessageQ_S_SUCCESS;
+    MessageQ_Object * obj;
+
+    obj = _MessageQ_findLeased(queueId, pid);
+
+    if (obj == NULL) {
+        return (MessageQ_E_FAIL);
+    }
+
+    if (obj->nsKey != NULL) {
+        if (NameServer_removeEntry(MessageQ_module->nameServer,
+                obj->nsKey) < 0) {
+            status = MessageQ_E_FAIL;
+        }
+        obj->nsKey = NULL;
+    }
+
+    return (status);
+}
+
+/*
+ *  ======== MessageQ_getIndexStats ========
+ */
+Void MessageQ_getIndexStats(UInt32 * numQueues, UInt32 * numUsed,
+        UInt32 * numLeased)
+{
+    MessageQ_Handle queue;
+    Int i;
+
+    *numUsed = 0;
+    *numLeased = 0;
+
+    pthread_mutex_lock(&(MessageQ_module->gate));
+
+    /* before MessageQ_setup() numQueues is set but there is no table */
+    *numQueues = (MessageQ_module->queues != NULL) ?
+            MessageQ_module->numQueues : 0;
+
+    for (i = 0; i < *numQueues; i++) {
+        queue = MessageQ_module->queues[i];
+        if (queue == NULL) {
+            continue;
+        }
+        if (queue->leased) {
+            (*numLeased)++;
+        }
+        else {
+            (*numUsed)++;
+        }
+    }
+
+    pthread_mutex_unlock(&(MessageQ_module->gate));
+}
+
 Void _MessageQ_setNumReservedEntries(UInt n)
 {
     MessageQ_module->cfg->numReservedEntries = n;
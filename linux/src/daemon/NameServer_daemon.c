@@ -42,7 +42,6 @@
 #include <pthread.h>
 
 /* Socket Headers */
-#include <sys/queue.h>
 #include <sys/select.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -50,6 +49,7 @@
 #include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <errno.h>
+#include <time.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -86,6 +86,23 @@
 #define NameServer_Event_REFRESH        (1 << 1)
 #define NameServer_Event_SHUTDOWN       (1 << 2)
 
+/* Hash tables: initial slot count, max load (percent), slots moved per op */
+#define NameServer_HASH_INITSIZE        16
+#define NameServer_HASH_MAXLOAD         70
+#define NameServer_HASH_MIGRATE         16
+
+/* Marks a slot whose entry was removed (keeps probe chains intact) */
+#define NameServer_HASH_DELETED         ((String)-1)
+
+/*
+ * Negative lookup cache: number of slots and default time-to-live.  Only
+ * real misses are cached, not timeouts.  A miss is forgotten when the
+ * remote core announces the name (NAMESERVER_ANNOUNCE), when its TTL
+ * expires, or when the processor is attached or detached.
+ */
+#define NameServer_NEGCACHE_SIZE        64
+#define NameServer_NEGCACHE_TTL         1000    /* milliseconds */
+
 #if defined (__cplusplus)
 extern "C" {
 #endif
@@ -98,8 +115,6 @@ extern "C" {
 
 /* Structure of entry in Name/Value table */
 typedef struct NameServer_TableEntry_tag {
-    CIRCLEQ_ENTRY(NameServer_TableEntry_tag) elem;
-    /* List element */
     UInt32                    hash;
     /* Hash value */
     String                    name;
@@ -108,16 +123,37 @@ typedef struct NameServer_TableEntry_tag {
     /* Length of the value field. */
     Ptr                       value;
     /* Value portion of the name/value entry. */
-    Bool                      collide;
-    /* Does the hash collide? */
-    struct NameServer_TableEntry_tag * next;
-    /* Pointer to the next entry, used incase of collision only */
 } NameServer_TableEntry;
 
+/* Slot of an open-addressing hash table */
+typedef struct NameServer_HashSlot {
+    UInt32             hash;            /* stringHash() of key */
+    String             key;             /* NULL if empty, or HASH_DELETED */
+    Ptr                item;            /* entry or instance object */
+} NameServer_HashSlot;
+
+/*
+ * Open-addressing (linear probing) hash table keyed on stringHash().
+ *
+ * Growing is done incrementally: when the load limit is reached a new
+ * slot array is allocated and the previous one is kept in 'old' until
+ * every live slot has been moved over, NameServer_HASH_MIGRATE slots at
+ * a time on each insert or remove.  Lookups search both arrays while a
+ * resize is in progress.
+ */
+typedef struct NameServer_HashTable {
+    NameServer_HashSlot *slots;         /* current slot array */
+    UInt32             size;            /* slots, always a power of 2 */
+    UInt32             used;            /* live plus deleted slots */
+    UInt32             count;           /* live entries in both arrays */
+    NameServer_HashSlot *old;           /* array being drained, or NULL */
+    UInt32             oldSize;         /* slots in old array */
+    UInt32             oldNext;         /* next old slot to migrate */
+} NameServer_HashTable;
+
 /* Structure defining object for the NameServer */
 struct NameServer_Object {
-    CIRCLEQ_ENTRY(NameServer_Object) elem;
-    CIRCLEQ_HEAD(dummy2, NameServer_TableEntry_tag) nameList;
+    NameServer_HashTable nameTable;     /* name/value entries */
     String             name;            /* name of the instance */
     NameServer_Params  params;          /* the parameter structure */
     UInt32             count;           /* count of entries */
@@ -125,9 +161,20 @@ struct NameServer_Object {
     pthread_mutex_t    gate;            /* crit sect gate */
 } NameServer_Object;
 
+/* Entry in the negative lookup cache of remote misses */
+typedef struct NameServer_NegCacheEntry {
+    Bool               valid;           /* slot in use? */
+    UInt16             procId;          /* processor that missed */
+    UInt32             hash;            /* stringHash() of name */
+    struct timespec    expires;         /* CLOCK_MONOTONIC expiry time */
+    Char               instanceName[MAXNAMEINCHAR];
+    Char               name[MAXNAMEINCHAR];
+} NameServer_NegCacheEntry;
+
 /* structure for NameServer module state */
 typedef struct NameServer_ModuleObject {
-    CIRCLEQ_HEAD(dummy1, NameServer_Object) objList;
+    NameServer_HashTable objTable;
+    /* Instances, keyed by instance name */
     Int32                refCount;
     struct {
         Int refCount;           /* attached reference count */
@@ -146,15 +193,18 @@ typedef struct NameServer_ModuleObject {
     /* Default instance paramters */
     pthread_mutex_t      modGate;
     pthread_mutex_t      attachGate;
+    NameServer_NegCacheEntry negCache[NameServer_NEGCACHE_SIZE];
+    /* Remote lookups which recently missed */
+    UInt                 negCacheTtl;
+    /* Lifetime of a negative cache entry in msec, 0 disables the cache */
+    UInt                 negCacheNext;
+    /* Next slot to evict when the cache is full */
+    pthread_mutex_t      negCacheGate;
+    /* Protects negCache, used by LAD and listener threads */
+    NameServer_RemoteStats remoteStats[MultiProc_MAXPROCESSORS];
+    /* Remote lookups per cluster processor, only touched by LAD thread */
 } NameServer_ModuleObject;
 
-#define CIRCLEQ_elemClear(elem) { \
-        (elem)->cqe_next = (elem)->cqe_prev = (Void *)(elem); \
-}
-
-#define CIRCLEQ_traverse(x, y, tag) \
-        for (x = (y)->cqh_first; x != (struct tag *)(y); x = x->elem.cqe_next)
-
 /* =============================================================================
  *  Globals
  * =============================================================================
@@ -180,6 +230,9 @@ static NameServer_ModuleObject NameServer_state = {
     .modGate                         = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP,
 #endif
     .attachGate                      = PTHREAD_MUTEX_INITIALIZER,
+    .negCacheTtl                     = NameServer_NEGCACHE_TTL,
+    .negCacheNext                    = 0,
+    .negCacheGate                    = PTHREAD_MUTEX_INITIALIZER,
     .refCount                        = 0
 };
 
@@ -233,16 +286,382 @@ static const UInt32 stringCrcTab[256u] = {
 
 static UInt32 stringHash(String s)
 {
-    UInt32 hash = strlen(s);
+    UInt32 len = strlen(s);
+    UInt32 hash = len;
     UInt32 i;
 
-    for (i = 0; i < strlen(s); i++) {
+    for (i = 0; i < len; i++) {
         hash = (hash >> 8u) ^ stringCrcTab[(hash & 0xff)] ^ s[i];
     }
 
     return (hash);
 }
 
+/*
+ *  ======== NameServer_hashInit ========
+ */
+static Int NameServer_hashInit(NameServer_HashTable *table)
+{
+    table->slots = (NameServer_HashSlot *)calloc(NameServer_HASH_INITSIZE,
+            sizeof(NameServer_HashSlot));
+    if (table->slots == NULL) {
+        return (NameServer_E_MEMORY);
+    }
+
+    table->size = NameServer_HASH_INITSIZE;
+    table->used = 0;
+    table->count = 0;
+    table->old = NULL;
+    table->oldSize = 0;
+    table->oldNext = 0;
+
+    return (NameServer_S_SUCCESS);
+}
+
+/*
+ *  ======== NameServer_hashFinalize ========
+ */
+static Void NameServer_hashFinalize(NameServer_HashTable *table)
+{
+    free(table->old);
+    free(table->slots);
+    table->old = NULL;
+    table->slots = NULL;
+    table->size = table->oldSize = 0;
+    table->count = table->used = 0;
+}
+
+/*
+ *  ======== NameServer_hashPlace ========
+ *  Store item in the first empty slot of its probe chain. The slot array
+ *  must have room, which the load limit guarantees.
+ */
+static Void NameServer_hashPlace(NameServer_HashTable *table, UInt32 hash,
+        String key, Ptr item)
+{
+    NameServer_HashSlot *slot;
+    UInt32 mask = table->size - 1;
+    UInt32 i;
+
+    for (i = hash & mask; ; i = (i + 1) & mask) {
+        slot = &table->slots[i];
+        if ((slot->key == NULL) || (slot->key == NameServer_HASH_DELETED)) {
+            if (slot->key == NULL) {
+                table->used++;
+            }
+            slot->hash = hash;
+            slot->key = key;
+            slot->item = item;
+            break;
+        }
+    }
+}
+
+/*
+ *  ======== NameServer_hashMigrate ========
+ *  Move up to 'n' slots from the old array into the current one.
+ */
+static Void NameServer_hashMigrate(NameServer_HashTable *table, UInt32 n)
+{
+    NameServer_HashSlot *slot;
+
+    while ((table->old != NULL) && (n-- > 0)) {
+        slot = &table->old[table->oldNext++];
+
+        if ((slot->key != NULL) && (slot->key != NameServer_HASH_DELETED)) {
+            NameServer_hashPlace(table, slot->hash, slot->key, slot->item);
+        }
+
+        if (table->oldNext == table->oldSize) {
+            free(table->old);
+            table->old = NULL;
+            table->oldSize = 0;
+            table->oldNext = 0;
+        }
+    }
+}
+
+/*
+ *  ======== NameServer_hashProbe ========
+ *  Find the slot holding key in one slot array. If item is not NULL the
+ *  slot must also refer to that item.
+ */
+static NameServer_HashSlot *NameServer_hashProbe(NameServer_HashSlot *slots,
+        UInt32 size, UInt32 hash, String key, Ptr item)
+{
+    NameServer_HashSlot *slot;
+    UInt32 mask = size - 1;
+    UInt32 i;
+    UInt32 n;
+
+    if (slots == NULL) {
+        return (NULL);
+    }
+
+    for (i = hash & mask, n = 0; n < size; i = (i + 1) & mask, n++) {
+        slot = &slots[i];
+        if (slot->key == NULL) {
+            break;
+        }
+        if ((slot->key != NameServer_HASH_DELETED) && (slot->hash == hash) &&
+            ((item == NULL) || (slot->item == item)) &&
+            (strcmp(slot->key, key) == 0)) {
+            return (slot);
+        }
+    }
+
+    return (NULL);
+}
+
+/*
+ *  ======== NameServer_hashFindSlot ========
+ */
+static NameServer_HashSlot *NameServer_hashFindSlot(
+        NameServer_HashTable *table, UInt32 hash, String key, Ptr item)
+{
+    NameServer_HashSlot *slot;
+
+    slot = NameServer_hashProbe(table->slots, table->size, hash, key, item);
+    if (slot == NULL) {
+        slot = NameServer_hashProbe(table->old, table->oldSize, hash, key,
+                item);
+    }
+
+    return (slot);
+}
+
+/*
+ *  ======== NameServer_hashFind ========
+ */
+static Ptr NameServer_hashFind(NameServer_HashTable *table, UInt32 hash,
+        String key)
+{
+    NameServer_HashSlot *slot;
+
+    slot = NameServer_hashFindSlot(table, hash, key, NULL);
+
+    return (slot != NULL ? slot->item : NULL);
+}
+
+/*
+ *  ======== NameServer_hashInsert ========
+ *  Add item under key. The key string must live as long as the item.
+ */
+static Int NameServer_hashInsert(NameServer_HashTable *table, UInt32 hash,
+        String key, Ptr item)
+{
+    NameServer_HashSlot *slots;
+    UInt32 size;
+
+    NameServer_hashMigrate(table, NameServer_HASH_MIGRATE);
+
+    if ((table->used + 1) * 100 > table->size * NameServer_HASH_MAXLOAD) {
+        /* a previous resize must complete before starting another one */
+        NameServer_hashMigrate(table, table->oldSize);
+
+        /* grow if mostly live entries, otherwise just purge deleted slots */
+        size = table->size;
+        if ((table->count + 1) * 100 > size * (NameServer_HASH_MAXLOAD / 2)) {
+            size *= 2;
+        }
+
+        slots = (NameServer_HashSlot *)calloc(size,
+                sizeof(NameServer_HashSlot));
+        if (slots == NULL) {
+            return (NameServer_E_MEMORY);
+        }
+
+        table->old = table->slots;
+        table->oldSize = table->size;
+        table->oldNext = 0;
+        table->slots = slots;
+        table->size = size;
+        table->used = 0;
+
+        NameServer_hashMigrate(table, NameServer_HASH_MIGRATE);
+    }
+
+    NameServer_hashPlace(table, hash, key, item);
+    table->count++;
+
+    return (NameServer_S_SUCCESS);
+}
+
+/*
+ *  ======== NameServer_hashRemove ========
+ *  Remove key from the table. If item is not NULL only the slot referring
+ *  to that item is removed. Returns the removed item or NULL.
+ */
+static Ptr NameServer_hashRemove(NameServer_HashTable *table, UInt32 hash,
+        String key, Ptr item)
+{
+    NameServer_HashSlot *slot;
+
+    slot = NameServer_hashFindSlot(table, hash, key, item);
+    if (slot == NULL) {
+        return (NULL);
+    }
+
+    item = slot->item;
+    slot->key = NameServer_HASH_DELETED;
+    slot->item = NULL;
+    table->count--;
+
+    NameServer_hashMigrate(table, NameServer_HASH_MIGRATE);
+
+    return (item);
+}
+
+/*
+ *  ======== NameServer_negCacheFind ========
+ *  Return the live negative cache slot for (instance, name, procId).
+ *  Must be called with negCacheGate held.
+ */
+static NameServer_NegCacheEntry *NameServer_negCacheFind(String instanceName,
+        String name, UInt32 hash, UInt16 procId)
+{
+    NameServer_NegCacheEntry *entry;
+    UInt i;
+
+    for (i = 0; i < NameServer_NEGCACHE_SIZE; i++) {
+        entry = &NameServer_module->negCache[i];
+        if (entry->valid && (entry->hash == hash) &&
+            (entry->procId == procId) && (strcmp(entry->name, name) == 0) &&
+            (strcmp(entry->instanceName, instanceName) == 0)) {
+            return (entry);
+        }
+    }
+
+    return (NULL);
+}
+
+/*
+ *  ======== NameServer_negCacheLookup ========
+ *  Returns TRUE if a recent remote lookup of name on procId missed.
+ */
+static Bool NameServer_negCacheLookup(String instanceName, String name,
+        UInt16 procId)
+{
+    NameServer_NegCacheEntry *entry;
+    struct timespec now;
+    Bool hit = FALSE;
+
+    if (NameServer_module->negCacheTtl == 0) {
+        return (FALSE);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&NameServer_module->negCacheGate);
+
+    entry = NameServer_negCacheFind(instanceName, name, stringHash(name),
+            procId);
+
+    if (entry != NULL) {
+        if ((now.tv_sec < entry->expires.tv_sec) ||
+            ((now.tv_sec == entry->expires.tv_sec) &&
+             (now.tv_nsec < entry->expires.tv_nsec))) {
+            hit = TRUE;
+        }
+        else {
+            /* expired, release the slot */
+            entry->valid = FALSE;
+        }
+    }
+
+    pthread_mutex_unlock(&NameServer_module->negCacheGate);
+
+    return (hit);
+}
+
+/*
+ *  ======== NameServer_negCacheInsert ========
+ *  Remember that name was not found on procId for negCacheTtl msec.
+ */
+static Void NameServer_negCacheInsert(String instanceName, String name,
+        UInt16 procId)
+{
+    NameServer_NegCacheEntry *entry;
+    UInt32 hash;
+    UInt i;
+
+    if (NameServer_module->negCacheTtl == 0) {
+        return;
+    }
+
+    hash = stringHash(name);
+
+    pthread_mutex_lock(&NameServer_module->negCacheGate);
+
+    entry = NameServer_negCacheFind(instanceName, name, hash, procId);
+
+    /* pick a free slot, otherwise evict in round-robin order */
+    for (i = 0; (entry == NULL) && (i < NameServer_NEGCACHE_SIZE); i++) {
+        if (!NameServer_module->negCache[i].valid) {
+            entry = &NameServer_module->negCache[i];
+        }
+    }
+
+    if (entry == NULL) {
+        entry = &NameServer_module->negCache[NameServer_module->negCacheNext];
+        NameServer_module->negCacheNext = (NameServer_module->negCacheNext + 1)
+                % NameServer_NEGCACHE_SIZE;
+    }
+
+    entry->procId = procId;
+    entry->hash = hash;
+    strncpy(entry->instanceName, instanceName, MAXNAMEINCHAR - 1);
+    entry->instanceName[MAXNAMEINCHAR - 1] = '\0';
+    strncpy(entry->name, name, MAXNAMEINCHAR - 1);
+    entry->name[MAXNAMEINCHAR - 1] = '\0';
+
+    clock_gettime(CLOCK_MONOTONIC, &entry->expires);
+    entry->expires.tv_sec += NameServer_module->negCacheTtl / 1000;
+    entry->expires.tv_nsec += (NameServer_module->negCacheTtl % 1000) *
+            1000000;
+    if (entry->expires.tv_nsec >= 1000000000) {
+        entry->expires.tv_sec++;
+        entry->expires.tv_nsec -= 1000000000;
+    }
+
+    entry->valid = TRUE;
+
+    pthread_mutex_unlock(&NameServer_module->negCacheGate);
+}
+
+/*
+ *  ======== NameServer_negCacheInvalidate ========
+ *  Drop cached misses. A NULL name drops every entry for procId, and
+ *  MultiProc_INVALIDID as procId drops the whole cache.
+ */
+static Void NameServer_negCacheInvalidate(String instanceName, String name,
+        UInt16 procId)
+{
+    NameServer_NegCacheEntry *entry;
+    UInt i;
+
+    pthread_mutex_lock(&NameServer_module->negCacheGate);
+
+    if (name != NULL) {
+        entry = NameServer_negCacheFind(instanceName, name, stringHash(name),
+                procId);
+        if (entry != NULL) {
+            entry->valid = FALSE;
+        }
+    }
+    else {
+        for (i = 0; i < NameServer_NEGCACHE_SIZE; i++) {
+            entry = &NameServer_module->negCache[i];
+            if ((procId == MultiProc_INVALIDID) ||
+                (entry->procId == procId)) {
+                entry->valid = FALSE;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&NameServer_module->negCacheGate);
+}
+
 static Int NameServer_reattach(UInt16 procId)
 {
     Int status = NameServer_S_SUCCESS;
@@ -315,6 +734,9 @@ static Int NameServer_reattach(UInt16 procId)
     NameServer_module->comm[clId].sendSock = sendSock;
     NameServer_module->comm[clId].recvSock = recvSock;
 
+    /* remote core restarted, anything it missed before may exist now */
+    NameServer_negCacheInvalidate(NULL, NULL, procId);
+
 done:
     if (status < 0) {
         if (recvSock >= 0) {
@@ -393,6 +815,16 @@ static void NameServerRemote_processMessage(NameServerRemote_Msg *msg,
             LOG2("NameServer: send failed: %d, %s\n", errno, strerror(errno))
         }
     }
+    else if (msg->request == NAMESERVER_ANNOUNCE) {
+        LOG3("NameServer Announce: procId: %d, instanceName: %s, name: %s\n",
+                procId, (String)msg->instanceName, (String)msg->name)
+
+        /* remote just added this name, forget any earlier miss */
+        ((Char *)msg->instanceName)[MAXNAMEINCHAR - 1] = '\0';
+        ((Char *)msg->name)[MAXNAMEINCHAR - 1] = '\0';
+        NameServer_negCacheInvalidate((String)msg->instanceName,
+                (String)msg->name, procId);
+    }
     else {
         LOG3("NameServer Reply: instanceName: %s, name: %s, value: 0x%x\n",
                 (String)msg->instanceName, (String)msg->name, msg->value);
@@ -589,8 +1021,12 @@ Int NameServer_setup(Void)
         NameServer_module->comm[i].recvSock = INVALIDSOCKET;
     }
 
-    /* Construct the list object */
-    CIRCLEQ_INIT(&NameServer_module->objList);
+    /* Construct the instance table */
+    status = NameServer_hashInit(&NameServer_module->objTable);
+    if (status < 0) {
+        LOG0("NameServer_setup: failed to create instance table.\n")
+        goto exit;
+    }
 
     /* Create the listener thread: */
     LOG0("NameServer_setup: creating listener thread\n")
@@ -651,6 +1087,10 @@ Int NameServer_destroy(void)
     close(NameServer_module->unblockFd);
     close(NameServer_module->waitFd);
 
+    NameServer_hashFinalize(&NameServer_module->objTable);
+
+    NameServer_negCacheInvalidate(NULL, NULL, MultiProc_INVALIDID);
+
 exit:
     LOG1("NameServer_destroy: exiting, refCount=%d\n",
             NameServer_module->refCount)
@@ -664,8 +1104,6 @@ exit:
 NameServer_Handle NameServer_getHandle(String name)
 {
     NameServer_Handle handle = NULL;
-    Bool              found = FALSE;
-    struct NameServer_Object * elem;
 
     assert(name != NULL);
     assert(NameServer_module->refCount != 0);
@@ -673,17 +1111,8 @@ NameServer_Handle NameServer_getHandle(String name)
     pthread_mutex_lock(&NameServer_module->modGate);
 
     /* Lookup handle from name: */
-    CIRCLEQ_traverse(elem, &NameServer_module->objList, NameServer_Object) {
-        handle = (NameServer_Handle) elem;
-        if (strcmp(handle->name, name) == 0) {
-            found = TRUE;
-            break;
-        }
-    }
-
-    if (found == FALSE) {
-        handle = NULL;
-    }
+    handle = (NameServer_Handle)NameServer_hashFind(
+            &NameServer_module->objTable, stringHash(name), name);
 
     pthread_mutex_unlock(&NameServer_module->modGate);
 
@@ -748,12 +1177,21 @@ NameServer_Handle NameServer_create(String name,
         handle->params.maxValueLen = params->maxValueLen;
     }
 
-    CIRCLEQ_INIT(&handle->nameList);
+    status = NameServer_hashInit(&handle->nameTable);
+    if (status < 0) {
+        LOG0("NameServer_create: name table alloc failed\n")
+        goto cleanup;
+    }
     handle->count = 0u;
 
-    /* Put in the local list */
-    CIRCLEQ_elemClear(&handle->elem);
-    CIRCLEQ_INSERT_HEAD(&NameServer_module->objList, handle, elem);
+    /* Put in the instance table */
+    status = NameServer_hashInsert(&NameServer_module->objTable,
+            stringHash(handle->name), handle->name, handle);
+    if (status < 0) {
+        LOG0("NameServer_create: instance table insert failed\n")
+        NameServer_hashFinalize(&handle->nameTable);
+        goto cleanup;
+    }
 
     /*
      * NameServer_removeEntry() enters gate and is called by
@@ -765,6 +1203,7 @@ NameServer_Handle NameServer_create(String name,
     goto leave;
 
 cleanup:
+    free(handle->name);
     free(handle);
     handle = NULL;
 
@@ -783,6 +1222,9 @@ Int NameServer_delete(NameServer_Handle *handle)
 {
     Int status = NameServer_S_SUCCESS;
     struct NameServer_Object *obj;
+    NameServer_HashSlot *slot;
+    NameServer_TableEntry *node;
+    UInt32 i;
 
     assert(handle != NULL);
     assert(*handle != NULL);
@@ -797,10 +1239,28 @@ Int NameServer_delete(NameServer_Handle *handle)
         goto leave;
     }
 
-    /* delete each entry on the name list */
-    while (obj->nameList.cqh_first != (void *)&obj->nameList) {
-        NameServer_removeEntry(*handle, (Ptr)(obj->nameList.cqh_first));
+    /* free all entries in one pass over the slots, then the table */
+    pthread_mutex_lock(&obj->gate);
+
+    NameServer_hashMigrate(&obj->nameTable, obj->nameTable.oldSize);
+
+    for (i = 0; i < obj->nameTable.size; i++) {
+        slot = &obj->nameTable.slots[i];
+        if ((slot->key != NULL) && (slot->key != NameServer_HASH_DELETED)) {
+            node = (NameServer_TableEntry *)slot->item;
+            free(node->value);
+            free(node->name);
+            free(node);
+        }
     }
+    NameServer_hashFinalize(&obj->nameTable);
+    obj->count = 0;
+
+    pthread_mutex_unlock(&obj->gate);
+
+    /* remove from objTable, before the key string is freed */
+    NameServer_hashRemove(&NameServer_module->objTable, stringHash(obj->name),
+            obj->name, obj);
 
     /* free the instance name */
     if (obj->name != NULL) {
@@ -811,9 +1271,6 @@ Int NameServer_delete(NameServer_Handle *handle)
     /* destroy the mutex */
     pthread_mutex_destroy(&obj->gate);
 
-    /* remove from objList */
-    CIRCLEQ_REMOVE(&NameServer_module->objList, obj, elem);
-
     /* finally, free the instance object */
     free(obj);
 
@@ -830,9 +1287,7 @@ leave:
 Ptr NameServer_add(NameServer_Handle handle, String name, Ptr buf, UInt len)
 {
     Int                 status = NameServer_S_SUCCESS;
-    NameServer_TableEntry * node = NULL;
     NameServer_TableEntry * new_node = NULL;
-    Bool                found = FALSE;
     UInt32              hash;
 
     assert(handle != NULL);
@@ -860,26 +1315,11 @@ Ptr NameServer_add(NameServer_Handle handle, String name, Ptr buf, UInt len)
         goto exit;
     }
 
-    /* Traverse the list to find duplicate check */
-    CIRCLEQ_traverse(node, &handle->nameList, NameServer_TableEntry_tag) {
-        /* Hash matches */
-        if (node->hash == hash) {
-            /* If the name matches, incase hash is duplicate */
-            if (strcmp(node->name, name) == 0) {
-                if (handle->params.checkExisting == TRUE) {
-                    status = NameServer_E_INVALIDARG;
-                    LOG1("NameServer_add: '%s' - duplicate entry found!\n", name)
-                    break;
-                }
-            }
-            else {
-                found = TRUE;
-                break;
-            } /* name does not match */
-        } /* hash does not match */
-    } /* CIRCLEQ_traverse */
-
-    if (status != NameServer_S_SUCCESS) {
+    /* Duplicate check */
+    if ((handle->params.checkExisting == TRUE) &&
+        (NameServer_hashFind(&handle->nameTable, hash, name) != NULL)) {
+        status = NameServer_E_INVALIDARG;
+        LOG1("NameServer_add: '%s' - duplicate entry found!\n", name)
         new_node = NULL;
         goto exit;
     }
@@ -894,24 +1334,22 @@ Ptr NameServer_add(NameServer_Handle handle, String name, Ptr buf, UInt len)
     }
 
     new_node->hash    = hash;
-    new_node->collide = found; /* Indicate if there is a collision*/
     new_node->len     = len;
-    new_node->next    = NULL;
     new_node->name = (String)malloc(strlen(name) + 1u);
     new_node->value  = (Ptr)malloc(len);
     strncpy(new_node->name, name, strlen(name) + 1u);
     memcpy((Ptr)new_node->value, (Ptr)buf, len);
 
-    if (found == TRUE) {
-        /* If hash is found, need to stitch the list to link the
-         * new node to the existing node with the same hash.
-         */
-        new_node->next = node->next;
-        node->next = new_node;
-    }
-    else {
-        /* put the new node into the list */
-        CIRCLEQ_INSERT_HEAD(&handle->nameList, new_node, elem);
+    /* put the new node into the table */
+    status = NameServer_hashInsert(&handle->nameTable, hash, new_node->name,
+            new_node);
+    if (status < 0) {
+        LOG1("NameServer_add: %d - name table insert failed!\n", status)
+        free(new_node->value);
+        free(new_node->name);
+        free(new_node);
+        new_node = NULL;
+        goto exit;
     }
 
     handle->count++;
@@ -944,10 +1382,7 @@ Ptr NameServer_addUInt32(NameServer_Handle handle, String name, UInt32 value)
 Int NameServer_remove(NameServer_Handle handle, String name)
 {
     Int                 status = NameServer_S_SUCCESS;
-    NameServer_TableEntry *prev = NULL;
-    NameServer_TableEntry *temp = NULL;
     NameServer_TableEntry *node = NULL;
-    Bool                done   = FALSE;
     UInt32              hash;
 
     assert(handle != NULL);
@@ -959,50 +1394,13 @@ Int NameServer_remove(NameServer_Handle handle, String name)
 
     pthread_mutex_lock(&handle->gate);
 
-    /* Traverse the list to find duplicate check */
-    CIRCLEQ_traverse(node, &handle->nameList, NameServer_TableEntry_tag) {
-        /* Hash matchs */
-        if (node->hash == hash) {
-            if (node->collide == TRUE) {
-                if (strcmp(node->name, name) == 0){
-                    free(node->value);
-                    free(node->name);
-                    memcpy((Ptr)node, (Ptr) node->next,
-                           sizeof(NameServer_TableEntry));
-                    node->next = node->next->next;
-                    free(node->next);
-                    handle->count--;
-                    done = TRUE;
-                    break;
-                }
-                else {
-                    prev = node;
-                    temp = node->next;
-                    while (temp) {
-                        if (strcmp(temp->name, name) == 0){
-                            free(temp->value);
-                            free(temp->name);
-                            prev->next = temp->next;
-                            free(temp);
-                            handle->count--;
-                            done = TRUE;
-                            break;
-                        }
-                        temp = temp->next;
-                    }
-                    break;
-                }
-            }
-            else {
-                NameServer_removeEntry(handle, (Ptr)node);
+    node = (NameServer_TableEntry *)NameServer_hashFind(&handle->nameTable,
+            hash, name);
 
-                done = TRUE;
-                break;
-            }
-        }
+    if (node != NULL) {
+        NameServer_removeEntry(handle, (Ptr)node);
     }
-
-    if (done == FALSE) {
+    else {
         status = NameServer_E_INVALIDARG;
         LOG1("NameServer_remove %d Entry not found!\n", status)
     }
@@ -1026,9 +1424,9 @@ Int NameServer_removeEntry(NameServer_Handle handle, Ptr entry)
 
     node = (NameServer_TableEntry *)entry;
 
+    NameServer_hashRemove(&handle->nameTable, node->hash, node->name, node);
     free(node->value);
     free(node->name);
-    CIRCLEQ_REMOVE(&handle->nameList, node, elem);
     free(node);
     handle->count--;
 
@@ -1069,6 +1467,9 @@ Int NameServer_getRemote(NameServer_Handle handle,
     static int seqNum = 0;
     Bool done = FALSE;
     UInt16 clusterId;
+    NameServer_RemoteStats *stats;
+    struct timespec start, end;
+    UInt64 elapsed;
 
     if (strlen(name) >= MAXNAMEINCHAR) {
         LOG0("Name is too long in remote query\n");
@@ -1080,12 +1481,24 @@ Int NameServer_getRemote(NameServer_Handle handle,
         return NameServer_E_NAMETOOLONG;
     }
 
+    clusterId = procId - MultiProc_getBaseIdOfCluster();
+    stats = &NameServer_module->remoteStats[clusterId];
+
+    /* Skip the round-trip if this name recently missed on procId */
+    if (NameServer_negCacheLookup(obj->name, name, procId)) {
+        LOG3("NameServer_getRemote: cached miss for procId %d, %s: %s\n",
+                procId, obj->name, name);
+        stats->cacheHits++;
+        return NameServer_E_NOTFOUND;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
     /* Set Timeout to wait: */
     tv.tv_sec = 0;
     tv.tv_usec = NAMESERVER_GET_TIMEOUT;
 
     /* Create request message and send to remote: */
-    clusterId = procId - MultiProc_getBaseIdOfCluster();
     sock = NameServer_module->comm[clusterId].sendSock;
     if (sock == INVALIDSOCKET) {
         LOG1("NameServer_getRemote: no socket connection to processor %d\n",
@@ -1194,6 +1607,36 @@ Int NameServer_getRemote(NameServer_Handle handle,
     }
 
 exit:
+    /* a timeout says nothing about the name, the core may just be slow */
+    if (status == NameServer_E_NOTFOUND) {
+        NameServer_negCacheInsert(obj->name, name, procId);
+    }
+
+    /* account for the query in the per-processor statistics */
+    if (status == NameServer_S_SUCCESS || status == NameServer_E_NOTFOUND ||
+        status == NameServer_E_TIMEOUT) {
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        elapsed = (UInt64)(end.tv_sec - start.tv_sec) * 1000000000ULL +
+                end.tv_nsec - start.tv_nsec;
+        stats->queries++;
+        stats->totalTime += elapsed;
+        if (elapsed > stats->maxTime) {
+            stats->maxTime = elapsed;
+        }
+        if (status == NameServer_S_SUCCESS) {
+            stats->found++;
+        }
+        else if (status == NameServer_E_NOTFOUND) {
+            stats->notFound++;
+        }
+        else {
+            stats->timeouts++;
+        }
+    }
+    else {
+        stats->errors++;
+    }
+
     return (status);
 }
 
@@ -1298,8 +1741,6 @@ Int NameServer_getLocal(NameServer_Handle handle,
 {
     Int status = NameServer_E_NOTFOUND;
     NameServer_TableEntry * node = NULL;
-    NameServer_TableEntry * temp = NULL;
-    Bool done   = FALSE;
     UInt32 length;
     UInt32 hash;
 
@@ -1316,52 +1757,29 @@ Int NameServer_getLocal(NameServer_Handle handle,
 
     pthread_mutex_lock(&handle->gate);
 
-    /* Traverse the list to find duplicate check */
-    CIRCLEQ_traverse(node, &handle->nameList, NameServer_TableEntry_tag) {
-        if (node->hash == hash) {
-            if (node->collide == TRUE) {
-                temp = node;
-                while (temp) {
-                    if (strcmp(temp->name, name) == 0u){
-                        if (length <= node->len) {
-                            memcpy(value, node->value, length);
-                            *len = length;
-                        }
-                        else {
-                            memcpy(value, node->value, node->len);
-                            *len = node->len;
-                        }
-                        done = TRUE;
-                        break;
-                    }
-                    temp = temp->next;
-                }
-                break;
-            }
-            else {
-                if (length <= node->len) {
-                    memcpy(value, node->value, length);
-                    *len = length;
-                }
-                else {
-                    memcpy(value, node->value, node->len);
-                    *len = node->len;
-                }
-                done = TRUE;
-                break;
-            }
+    node = (NameServer_TableEntry *)NameServer_hashFind(&handle->nameTable,
+            hash, name);
+
+    if (node != NULL) {
+        if (length <= node->len) {
+            memcpy(value, node->value, length);
+            *len = length;
         }
+        else {
+            memcpy(value, node->value, node->len);
+            *len = node->len;
+        }
+        status = NameServer_S_SUCCESS;
     }
 
     pthread_mutex_unlock(&handle->gate);
 
-    if (done == FALSE) {
+    if (status < 0) {
         LOG1("NameServer_getLocal: entry key: '%s' not found!\n", name)
     }
     else {
-        LOG2("NameServer_getLocal: Found entry key: '%s', data: 0x%x\n",
-             node->name, (UInt32)node->value)
-        status = NameServer_S_SUCCESS;
+        LOG2("NameServer_getLocal: Found entry key: '%s', len: %d\n",
+             name, *len)
     }
 
     return (status);
@@ -1464,6 +1882,9 @@ Int NameServer_attach(UInt16 procId)
     /* getting here means we have successfully attached */
     NameServer_module->comm[clId].refCount++;
 
+    /* misses recorded while the processor was unreachable are stale */
+    NameServer_negCacheInvalidate(NULL, NULL, procId);
+
     pthread_mutex_unlock(&NameServer_module->attachGate);
 
     /* tell the listener thread to add new receive sockets */
@@ -1565,12 +1986,87 @@ Int NameServer_detach(UInt16 procId)
     LOG1("NameServer_detach: closing socket: %d\n", recvSock)
     close(recvSock);
 
+    NameServer_negCacheInvalidate(NULL, NULL, procId);
+
 done:
     LOG2("NameServer_detach: <-- refCount=%d, status=%d\n",
             NameServer_module->comm[clId].refCount, status)
     return (status);
 }
 
+/*
+ *  ======== _NameServer_setNegCacheTimeout ========
+ *  Set the lifetime of remote lookup misses, 0 disables the cache
+ */
+Void _NameServer_setNegCacheTimeout(UInt msec)
+{
+    pthread_mutex_lock(&NameServer_module->negCacheGate);
+    NameServer_module->negCacheTtl = msec;
+    pthread_mutex_unlock(&NameServer_module->negCacheGate);
+
+    NameServer_negCacheInvalidate(NULL, NULL, MultiProc_INVALIDID);
+}
+
+/*
+ *  ======== _NameServer_getInstanceStats ========
+ *  Report the index'th instance in objTable order.  This walks the table,
+ *  so it is meant for the occasional statistics query only.
+ */
+Int _NameServer_getInstanceStats(UInt index, NameServer_InstanceStats *stats)
+{
+    NameServer_HashTable *table = &NameServer_module->objTable;
+    NameServer_HashSlot *slot;
+    struct NameServer_Object *obj = NULL;
+    UInt32 i;
+    UInt n = 0;
+
+    pthread_mutex_lock(&NameServer_module->modGate);
+
+    for (i = 0; obj == NULL && i < table->size + table->oldSize; i++) {
+        slot = (i < table->size) ? &table->slots[i] :
+                &table->old[i - table->size];
+        if (slot->key == NULL || slot->key == NameServer_HASH_DELETED) {
+            continue;
+        }
+        if (n++ == index) {
+            obj = (struct NameServer_Object *)slot->item;
+        }
+    }
+
+    if (obj == NULL) {
+        pthread_mutex_unlock(&NameServer_module->modGate);
+        return (NameServer_E_NOTFOUND);
+    }
+
+    pthread_mutex_lock(&obj->gate);
+    strncpy(stats->name, obj->name, NameServer_STATSNAMELEN - 1);
+    stats->name[NameServer_STATSNAMELEN - 1] = '\0';
+    stats->numEntries = obj->nameTable.count;
+    stats->tableSize = obj->nameTable.size + obj->nameTable.oldSize;
+    pthread_mutex_unlock(&obj->gate);
+
+    pthread_mutex_unlock(&NameServer_module->modGate);
+
+    return (NameServer_S_SUCCESS);
+}
+
+/*
+ *  ======== _NameServer_getRemoteStats ========
+ */
+Int _NameServer_getRemoteStats(UInt16 procId, NameServer_RemoteStats *stats)
+{
+    UInt16 clusterId = procId - MultiProc_getBaseIdOfCluster();
+
+    if (clusterId >= MultiProc_getNumProcsInCluster()) {
+        return (NameServer_E_INVALIDARG);
+    }
+
+    memcpy(stats, &NameServer_module->remoteStats[clusterId],
+            sizeof(NameServer_RemoteStats));
+
+    return (NameServer_S_SUCCESS);
+}
+
 #if defined (__cplusplus)
 }
 #endif /* defined (__cplusplus) */
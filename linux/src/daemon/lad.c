@@ -68,10 +68,6 @@
 
 #define READ_BUF_SIZE 50
 
-Bool logFile = FALSE;
-FILE *logPtr = NULL;
-struct timeval start_tv;
-
 static String commandFIFOFile = LAD_COMMANDFIFO;
 static FILE *commandFIFOFilePtr = NULL;
 
@@ -85,6 +81,17 @@ static UInt clientPID[LAD_MAXNUMCLIENTS];
 static Char clientFIFOName[LAD_MAXNUMCLIENTS][LAD_MAXLENGTHFIFONAME];
 static FILE * responseFIFOFilePtr[LAD_MAXNUMCLIENTS];
 
+/* statistics reported by LAD_GETSTATS, times in nsec */
+static UInt64 statsStartTime;
+static UInt64 numCommands = 0;
+static LAD_TimeStats queueWaitStats;
+static LAD_TimeStats commandStats[LAD_EXIT];
+static struct {
+    UInt64 connectTime;
+    UInt64 lastTime;
+    UInt64 numCommands;
+} clientStats[LAD_MAXNUMCLIENTS];
+
 /* local internal routines */
 static Bool isDaemonRunning(Char *pidName);
 static LAD_ClientHandle assignClientId(Void);
@@ -93,6 +100,9 @@ static Void cleanupDepartedClients(Void);
 static Int connectToLAD(String clientName, Int pid, String clientProto, Int *clientIdPtr);
 static Void disconnectFromLAD(Int clientId);
 static Void doDisconnect(Int clientId);
+static UInt64 getTime(Void);
+static Void addTime(LAD_TimeStats *stats, UInt64 time);
+static Void getStats(Int section, Int index);
 
 struct LAD_CommandObj cmd;
 union LAD_ResponseObj rsp;
@@ -103,12 +113,18 @@ Usage:\n\
 \n\
 Options:\n\
     h            : print this help message\n\
+    e            : enable GateMP support with the hardware spinlocks\n\
+                   emulated in shared memory, for running without\n\
+                   remote cores\n\
     g            : enable GateMP support \n\
     l <logfile>  : name of logfile for LAD\n\
+    m            : keep a log in memory only, SIGUSR1 dumps it to\n\
+                   " LAD_WORKINGDIR LAD_LOGDUMPFILE " (see lad_logdecode)\n\
     n <nprocs>   : total number of processors in the system\n\
     p <oct value>: set LAD's directory permissions\n\
     r <nreserve> : number of reserved queues\n\
     s <synctype> : type of Ipc_ProcSync (ALL|PAIR|NONE)\n\
+    t <msec>     : lifetime of cached remote NameServer misses (0 = off)\n\
     b <value>    : Processor's base cluster id \n\
 \n\
 Examples:\n\
@@ -116,6 +132,7 @@ Examples:\n\
     lad_<platform> -l log.txt\n\
     lad_<platform> -l log.txt -p 777\n\
     lad_<platform> -g -l log.txt\n\
+    lad_<platform> -m\n\
     lad_<platform> -l log.txt -b 10\n\
 \n"
 
@@ -127,6 +144,7 @@ int main(int argc, char * argv[])
     MessageQ_Handle handle;
     Ipc_Config ipcCfg;
     UInt16 *procIdPtr;
+    UInt64 dispatchTime;
     Int statusIO;
     Int clientId;
     Int command;
@@ -134,8 +152,8 @@ int main(int argc, char * argv[])
     Int i;
     Int n;
     Int c;
-#if defined(GATEMP_SUPPORT)
     Int status;
+#if defined(GATEMP_SUPPORT)
     UInt16 procId;
 #endif
     String tmpString;
@@ -182,12 +200,22 @@ int main(int argc, char * argv[])
 
     /* process command line args */
     while (1) {
-        c = getopt(argc, argv, "b:ghl:n:p:r:s:");
+        c = getopt(argc, argv, "b:eghl:mn:p:r:s:t:");
         if (c == -1) {
             break;
         }
 
         switch (c) {
+            case 'e':
+#if defined(GATEMP_SUPPORT)
+                printf("\nGateMP support enabled on host, hardware spinlocks "
+                        "emulated in %s\n", GateHWSpinlock_SHMNAME);
+                _GateHWSpinlock_cfgParams.backend = GateHWSpinlock_Backend_SHM;
+                gatempEnabled = TRUE;
+#else
+                printf("\nGateMP is not supported for this device\n");
+#endif
+                break;
             case 'g':
 #if defined(GATEMP_SUPPORT)
                 printf("\nGateMP support enabled on host\n");
@@ -214,7 +242,6 @@ int main(int argc, char * argv[])
                 }
                 else {
                     logFile = TRUE;
-                    gettimeofday(&start_tv, NULL);
                     printf("\nOpened log file: %s\n", optarg);
                     /* close log file upon LAD termination */
                     flags = fcntl(fileno(logPtr), F_GETFD);
@@ -223,6 +250,11 @@ int main(int argc, char * argv[])
                     }
                 }
                 break;
+            case 'm':
+                printf("\nLogging to memory, SIGUSR1 dumps to %s%s\n",
+                        LAD_WORKINGDIR, LAD_LOGDUMPFILE);
+                logFile = TRUE;
+                break;
             case 'n':
                 printf("\nSet LAD's number of processors to %s\n", optarg);
                 _MultiProc_cfg.numProcessors = atoi(optarg);
@@ -260,6 +292,11 @@ int main(int argc, char * argv[])
 
                 Ipc_setConfig(&ipcCfg);
                 break;
+            case 't':
+                printf("\nSet LAD's NameServer miss cache lifetime to %s "
+                       "msec\n", optarg);
+                _NameServer_setNegCacheTimeout(atoi(optarg));
+                break;
             default:
                 fprintf (stderr, "\nUnrecognized argument\n");
                 exit(EXIT_FAILURE);
@@ -327,6 +364,13 @@ int main(int argc, char * argv[])
 
 #endif
 
+    /* the log writer thread must be created after the fork */
+    if (logFile && LAD_logStart() < 0) {
+        logFile = FALSE;
+    }
+
+    statsStartTime = getTime();
+
     LOG0("\nInitializing LAD... ")
 
     /* TODO:L make sure LAD is not already running? */
@@ -417,6 +461,11 @@ opencommandFIFO:
         command = cmd.cmd;
         clientId = cmd.clientId;
 
+        dispatchTime = getTime();
+        if (cmd.sendTime != 0 && cmd.sendTime <= dispatchTime) {
+            addTime(&queueWaitStats, dispatchTime - cmd.sendTime);
+        }
+
         /* process individual commands */
         switch (command) {
           /*
@@ -631,10 +680,20 @@ opencommandFIFO:
           case LAD_MESSAGEQ_SETUP:
             LOG0("LAD_MESSAGEQ_SETUP: calling MessageQ_setup()...\n")
 
-            rsp.setup.status = MessageQ_setup(&cmd.args.messageQSetup.cfg);
-            rsp.setup.nameServerHandle = MessageQ_getNameServerHandle();
+            rsp.messageQSetup.status =
+                MessageQ_setup(&cmd.args.messageQSetup.cfg);
+            rsp.messageQSetup.nameServerHandle =
+                MessageQ_getNameServerHandle();
+
+            /* hand out the client's first block of queue indexes */
+            rsp.messageQSetup.count = 0;
+            if (rsp.messageQSetup.status >= 0 &&
+                MessageQ_lease(LAD_MESSAGEQLEASESIZE, clientPID[clientId],
+                    &rsp.messageQSetup.baseId) == MessageQ_S_SUCCESS) {
+                rsp.messageQSetup.count = LAD_MESSAGEQLEASESIZE;
+            }
 
-            LOG1("    status = %d\n", rsp.setup.status)
+            LOG1("    status = %d\n", rsp.messageQSetup.status)
             LOG0("DONE\n")
 
             break;
@@ -642,6 +701,7 @@ opencommandFIFO:
           case LAD_MESSAGEQ_DESTROY:
             LOG0("LAD_MESSAGEQ_DESTROY: calling MessageQ_destroy()...\n")
 
+            MessageQ_releaseLeases(clientPID[clientId]);
             rsp.status = MessageQ_destroy();
 
             LOG1("    status = %d\n", rsp.status)
@@ -700,6 +760,55 @@ opencommandFIFO:
 
             break;
 
+          case LAD_MESSAGEQ_LEASE:
+            LOG1("LAD_MESSAGEQ_LEASE: calling MessageQ_lease(%d)...\n",
+                    cmd.args.messageQLease.count)
+
+            rsp.messageQLease.count = cmd.args.messageQLease.count;
+            rsp.messageQLease.status = MessageQ_lease(rsp.messageQLease.count,
+                    clientPID[clientId], &rsp.messageQLease.baseId);
+
+            LOG1("    status = %d\n", rsp.messageQLease.status)
+            LOG0("DONE\n")
+
+            break;
+
+          case LAD_MESSAGEQ_REGISTER:
+            LOG2("LAD_MESSAGEQ_REGISTER: calling MessageQ_register(%s, "
+                    "0x%x)...\n", cmd.args.messageQRegister.name,
+                    cmd.args.messageQRegister.queueId)
+
+            status = MessageQ_register(cmd.args.messageQRegister.name,
+                    cmd.args.messageQRegister.queueId, clientPID[clientId]);
+
+            LOG1("    status = %d\n", status)
+            LOG0("DONE\n")
+
+            break;
+
+          case LAD_MESSAGEQ_UNREGISTER:
+            LOG1("LAD_MESSAGEQ_UNREGISTER: calling MessageQ_unregister(0x%x)"
+                    "...\n", cmd.args.messageQUnregister.queueId)
+
+            status = MessageQ_unregister(cmd.args.messageQUnregister.queueId,
+                    clientPID[clientId]);
+
+            LOG1("    status = %d\n", status)
+            LOG0("DONE\n")
+
+            break;
+
+          case LAD_GETSTATS:
+            LOG2("LAD_GETSTATS: section %d, index %d\n",
+                    cmd.args.getStats.section, cmd.args.getStats.index)
+
+            getStats(cmd.args.getStats.section, cmd.args.getStats.index);
+
+            LOG1("    status = %d\n", rsp.stats.status)
+            LOG0("DONE\n")
+
+            break;
+
           case LAD_MESSAGEQ_MSGINIT:
             LOG1("LAD_MESSAGEQ_MSGINIT: calling MessageQ_msgInit(%p)...\n", &rsp.msgInit.msg);
 
@@ -854,6 +963,8 @@ opencommandFIFO:
           case LAD_MESSAGEQ_ANNOUNCE:
           case LAD_MESSAGEQ_DELETE:
           case LAD_MESSAGEQ_MSGINIT:
+          case LAD_MESSAGEQ_LEASE:
+          case LAD_GETSTATS:
           case LAD_MULTIPROC_GETCONFIG:
 #if defined(GATEMP_SUPPORT)
           case LAD_GATEMP_ATTACH:
@@ -876,6 +987,18 @@ opencommandFIFO:
           default:
             break;
         }
+
+        /* account for the command now that its response is out */
+        if (command >= 0 && command < LAD_EXIT) {
+            addTime(&commandStats[command], getTime() - dispatchTime);
+        }
+        numCommands++;
+
+        if (command != LAD_CONNECT && clientId >= 0 &&
+            clientId < LAD_MAXNUMCLIENTS) {
+            clientStats[clientId].numCommands++;
+            clientStats[clientId].lastTime = dispatchTime - statsStartTime;
+        }
     }
 
 exitNow:
@@ -887,7 +1010,10 @@ exitNow:
 #endif
     if (logFile) {
         LOG0("\n\nLAD IS SELF TERMINATING...\n\n")
-        fclose(logPtr);
+        LAD_logStop();
+        if (logPtr != NULL) {
+            fclose(logPtr);
+        }
     }
     unlink(commandFIFOFile);
 
@@ -1185,6 +1311,10 @@ openResponseFIFO:
         responseFIFOFilePtr[clientId] = filePtr;
         clientPID[clientId] = pid;
         clientConnected[clientId] = TRUE;
+
+        clientStats[clientId].connectTime = getTime() - statsStartTime;
+        clientStats[clientId].lastTime = clientStats[clientId].connectTime;
+        clientStats[clientId].numCommands = 0;
     }
 
     rsp.connect.assignedId = clientId;
@@ -1246,3 +1376,108 @@ static Void doDisconnect(Int clientId)
     LOG1("    done, unlinking %s\n", clientFIFOName[clientId]);
     unlink(clientFIFOName[clientId]);
 }
+
+/*
+ *  ======== getTime ========
+ */
+static UInt64 getTime(Void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((UInt64)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+/*
+ *  ======== addTime ========
+ */
+static Void addTime(LAD_TimeStats *stats, UInt64 time)
+{
+    UInt64 usec = time / 1000;
+    Int bucket = 0;
+
+    while (usec != 0 && bucket < LAD_STATSBUCKETS - 1) {
+        usec >>= 1;
+        bucket++;
+    }
+
+    stats->count++;
+    stats->totalTime += time;
+    if (time > stats->maxTime) {
+        stats->maxTime = time;
+    }
+    stats->hist[bucket]++;
+}
+
+/*
+ *  ======== getStats ========
+ *  Fill in rsp.stats for one LAD_GETSTATS section/index.  A status of -1
+ *  tells the caller it has walked past the last index of the section.
+ */
+static Void getStats(Int section, Int index)
+{
+    Int status = 0;
+    Int i;
+
+    switch (section) {
+      case LAD_STATS_SUMMARY:
+        rsp.stats.u.summary.upTime = getTime() - statsStartTime;
+        rsp.stats.u.summary.numCommands = numCommands;
+        rsp.stats.u.summary.queueWait = queueWaitStats;
+        rsp.stats.u.summary.numClients = 0;
+        for (i = 0; i < LAD_MAXNUMCLIENTS; i++) {
+            if (clientConnected[i]) {
+                rsp.stats.u.summary.numClients++;
+            }
+        }
+        MessageQ_getIndexStats(&rsp.stats.u.summary.numQueues,
+                &rsp.stats.u.summary.numQueuesUsed,
+                &rsp.stats.u.summary.numQueuesLeased);
+        break;
+
+      case LAD_STATS_COMMAND:
+        if (index < 0 || index >= LAD_EXIT) {
+            status = -1;
+            break;
+        }
+        rsp.stats.u.command.cmd = index;
+        rsp.stats.u.command.service = commandStats[index];
+        break;
+
+      case LAD_STATS_CLIENT:
+        if (index < 0 || index >= LAD_MAXNUMCLIENTS) {
+            status = -1;
+            break;
+        }
+        rsp.stats.u.client.pid = clientPID[index];
+        rsp.stats.u.client.connected = clientConnected[index];
+        rsp.stats.u.client.connectTime = clientStats[index].connectTime;
+        rsp.stats.u.client.lastTime = clientStats[index].lastTime;
+        rsp.stats.u.client.numCommands = clientStats[index].numCommands;
+        break;
+
+      case LAD_STATS_NAMESERVER:
+        if (index < 0 || _NameServer_getInstanceStats(index,
+                &rsp.stats.u.nameServer) < 0) {
+            status = -1;
+        }
+        break;
+
+      case LAD_STATS_REMOTE:
+        rsp.stats.u.remote.procId = MultiProc_getBaseIdOfCluster() + index;
+        if (index < 0 || _NameServer_getRemoteStats(
+                rsp.stats.u.remote.procId, &rsp.stats.u.remote.stats) < 0) {
+            status = -1;
+        }
+        break;
+
+      default:
+        status = -1;
+        break;
+    }
+
+    rsp.stats.status = status;
+    rsp.stats.section = section;
+    rsp.stats.index = index;
+}
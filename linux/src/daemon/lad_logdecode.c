@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== lad_logdecode.c ========
+ *
+ *  Render a LAD log ring dump as text.  Send SIGUSR1 to a running LAD to
+ *  produce the dump:
+ *
+ *      kill -USR1 `pidof lad_dra7xx`
+ *      lad_logdecode [dumpfile]
+ */
+
+#include <ti/ipc/Std.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <_lad.h>
+
+#define USAGE "\
+Usage:\n\
+    lad_logdecode [dumpfile]\n\
+\n\
+Renders a LAD log ring dump (default " LAD_WORKINGDIR LAD_LOGDUMPFILE ").\n\
+Send SIGUSR1 to LAD to write the dump.\n"
+
+typedef struct {
+    char   *fmt;
+    UInt16  strMask;
+} Site;
+
+int main(int argc, char * argv[])
+{
+    const char *path = LAD_WORKINGDIR LAD_LOGDUMPFILE;
+    LAD_LogDumpHeader hdr;
+    LAD_LogRecord rec;
+    Site *sites = NULL;
+    UInt16 id;
+    UInt16 len;
+    UInt32 i;
+    FILE *in;
+    int status = 1;
+
+    if (argc > 2 || (argc == 2 && argv[1][0] == '-')) {
+        printf("%s", USAGE);
+        return (argc == 2 && !strcmp(argv[1], "-h")) ? 0 : 1;
+    }
+    if (argc == 2) {
+        path = argv[1];
+    }
+
+    in = fopen(path, "r");
+    if (in == NULL) {
+        fprintf(stderr, "lad_logdecode: can't open %s\n", path);
+        return (1);
+    }
+
+    if (fread(&hdr, sizeof(hdr), 1, in) != 1 ||
+        strncmp(hdr.magic, LAD_LOGMAGIC, sizeof(hdr.magic)) != 0) {
+        fprintf(stderr, "lad_logdecode: %s is not a LAD log dump\n", path);
+        goto exit;
+    }
+
+    /* site ids are 1-based and dense */
+    sites = calloc(hdr.numSites + 1, sizeof(Site));
+    if (sites == NULL) {
+        goto exit;
+    }
+
+    for (i = 0; i < hdr.numSites; i++) {
+        if (fread(&id, sizeof(id), 1, in) != 1 ||
+            fread(&len, sizeof(len), 1, in) != 1 ||
+            id == 0 || id > hdr.numSites || sites[id].fmt != NULL ||
+            (sites[id].fmt = calloc(1, len + 1)) == NULL ||
+            fread(sites[id].fmt, 1, len, in) != len) {
+            fprintf(stderr, "lad_logdecode: bad format table\n");
+            goto exit;
+        }
+        sites[id].strMask = LAD_logStrMask(sites[id].fmt);
+    }
+
+    if (hdr.dropped != 0) {
+        printf("[%llu older log records were overwritten]\n", hdr.dropped);
+    }
+
+    for (i = 0; i < hdr.numRecords; i++) {
+        if (fread(&rec, sizeof(rec), 1, in) != 1) {
+            fprintf(stderr, "lad_logdecode: dump truncated after %u "
+                    "records\n", i);
+            goto exit;
+        }
+        if (rec.site == 0 || rec.site > hdr.numSites) {
+            printf("[record with unknown format id %u]\n", rec.site);
+            continue;
+        }
+        LAD_logRender(stdout, sites[rec.site].fmt, sites[rec.site].strMask,
+                &rec);
+    }
+
+    status = 0;
+
+exit:
+    if (sites != NULL) {
+        for (i = 0; i <= hdr.numSites; i++) {
+            free(sites[i].fmt);
+        }
+        free(sites);
+    }
+    fclose(in);
+
+    return (status);
+}
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== lad_stats.c ========
+ *
+ *  Print the load statistics of a running LAD, collected with
+ *  LAD_GETSTATS.
+ */
+
+#include <ti/ipc/Std.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <ladclient.h>
+#include <_lad.h>
+
+#define USAGE "\
+Usage:\n\
+    lad_stats [options]\n\
+\n\
+Options:\n\
+    h            : print this help message\n\
+    a            : also list idle commands, clients and processors\n\
+\n"
+
+/* names of the _LAD_Command values, keep in the same order */
+static const char *cmdNames[] = {
+    "CONNECT",
+    "DISCONNECT",
+    "IPC_GETCONFIG",
+    "NAMESERVER_SETUP",
+    "NAMESERVER_DESTROY",
+    "NAMESERVER_PARAMS_INIT",
+    "NAMESERVER_CREATE",
+    "NAMESERVER_DELETE",
+    "NAMESERVER_ADD",
+    "NAMESERVER_GET",
+    "NAMESERVER_ADDUINT32",
+    "NAMESERVER_GETUINT32",
+    "NAMESERVER_GETLOCAL",
+    "NAMESERVER_GETLOCALUINT32",
+    "NAMESERVER_REMOVE",
+    "NAMESERVER_REMOVEENTRY",
+    "NAMESERVER_ATTACH",
+    "NAMESERVER_DETACH",
+    "MESSAGEQ_GETCONFIG",
+    "MESSAGEQ_SETUP",
+    "MESSAGEQ_DESTROY",
+    "MESSAGEQ_CREATE",
+    "MESSAGEQ_ANNOUNCE",
+    "MESSAGEQ_DELETE",
+    "MESSAGEQ_MSGINIT",
+    "MULTIPROC_GETCONFIG",
+    "GATEMP_ATTACH",
+    "GATEMP_DETACH",
+    "GATEMP_START",
+    "GATEMP_GETNUMRESOURCES",
+    "GATEMP_GETFREERESOURCE",
+    "GATEMP_RELEASERESOURCE",
+    "GATEMP_ISSETUP",
+    "GATEHWSPINLOCK_GETCONFIG",
+    "MESSAGEQ_LEASE",
+    "MESSAGEQ_REGISTER",
+    "MESSAGEQ_UNREGISTER",
+    "GETSTATS"
+};
+
+/*
+ *  ======== getStats ========
+ */
+static Int getStats(LAD_ClientHandle handle, Int section, Int index,
+        union LAD_ResponseObj *rsp)
+{
+    struct LAD_CommandObj cmd;
+    Int status;
+
+    cmd.cmd = LAD_GETSTATS;
+    cmd.clientId = handle;
+    cmd.args.getStats.section = section;
+    cmd.args.getStats.index = index;
+
+    if ((status = LAD_putCommand(&cmd)) != LAD_SUCCESS) {
+        fprintf(stderr, "lad_stats: sending LAD command failed, status=%d\n",
+                status);
+        return (-1);
+    }
+
+    if ((status = LAD_getResponse(handle, rsp)) != LAD_SUCCESS) {
+        fprintf(stderr, "lad_stats: no LAD response, status=%d\n", status);
+        return (-1);
+    }
+
+    return (rsp->stats.status);
+}
+
+/*
+ *  ======== usec ========
+ */
+static double usec(UInt64 nsec)
+{
+    return (nsec / 1000.0);
+}
+
+/*
+ *  ======== printTimes ========
+ *  One line of count, mean, max and the non-empty histogram buckets.
+ */
+static Void printTimes(const char *name, const LAD_TimeStats *t)
+{
+    Int i;
+
+    printf("  %-26s %9u %10.1f %10.1f ", name, t->count,
+            t->count ? usec(t->totalTime) / t->count : 0.0,
+            usec(t->maxTime));
+
+    for (i = 0; i < LAD_STATSBUCKETS; i++) {
+        if (t->hist[i] == 0) {
+            continue;
+        }
+        if (i == LAD_STATSBUCKETS - 1) {
+            printf(" >=%u:%u", 1u << (i - 1), t->hist[i]);
+        }
+        else {
+            printf(" <%u:%u", 1u << i, t->hist[i]);
+        }
+    }
+    printf("\n");
+}
+
+int main(int argc, char * argv[])
+{
+    LAD_ClientHandle handle;
+    union LAD_ResponseObj rsp;
+    NameServer_RemoteStats *rs;
+    UInt64 upTime;
+    double secs;
+    double idle;
+    Bool all = FALSE;
+    Int status;
+    Int i;
+    Int c;
+
+    while ((c = getopt(argc, argv, "ah")) != -1) {
+        switch (c) {
+            case 'a':
+                all = TRUE;
+                break;
+            case 'h':
+                printf("%s", USAGE);
+                return (0);
+            default:
+                fprintf(stderr, "%s", USAGE);
+                return (1);
+        }
+    }
+
+    status = LAD_connect(&handle);
+    if (status != LAD_SUCCESS) {
+        fprintf(stderr, "lad_stats: LAD_connect() failed: %d\n", status);
+        return (1);
+    }
+
+    if (getStats(handle, LAD_STATS_SUMMARY, 0, &rsp) < 0) {
+        LAD_disconnect(handle);
+        return (1);
+    }
+
+    upTime = rsp.stats.u.summary.upTime;
+    secs = upTime / 1e9;
+
+    printf("LAD up %.1f s, %llu commands (%.1f/s), %u clients connected\n",
+            secs, rsp.stats.u.summary.numCommands,
+            secs > 0 ? rsp.stats.u.summary.numCommands / secs : 0.0,
+            rsp.stats.u.summary.numClients);
+    printf("MessageQ indexes: %u in table, %u used by LAD, %u leased to "
+            "clients\n\n", rsp.stats.u.summary.numQueues,
+            rsp.stats.u.summary.numQueuesUsed,
+            rsp.stats.u.summary.numQueuesLeased);
+
+    printf("  %-26s %9s %10s %10s  histogram (usec:count)\n", "time (usec)",
+            "count", "mean", "max");
+    printTimes("queue wait", &rsp.stats.u.summary.queueWait);
+
+    for (i = 0; getStats(handle, LAD_STATS_COMMAND, i, &rsp) == 0; i++) {
+        if (rsp.stats.u.command.service.count == 0 && !all) {
+            continue;
+        }
+        printTimes((i < (Int)(sizeof(cmdNames) / sizeof(cmdNames[0]))) ?
+                cmdNames[i] : "?", &rsp.stats.u.command.service);
+    }
+
+    printf("\n  %-6s %-8s %-9s %12s %10s %12s\n", "client", "pid", "state",
+            "commands", "per sec", "idle (s)");
+    for (i = 0; getStats(handle, LAD_STATS_CLIENT, i, &rsp) == 0; i++) {
+        if (rsp.stats.u.client.numCommands == 0 && !all) {
+            continue;
+        }
+        /* our own queries come after the summary, don't go negative */
+        secs = (upTime > rsp.stats.u.client.connectTime) ?
+                (upTime - rsp.stats.u.client.connectTime) / 1e9 : 0.0;
+        idle = (upTime > rsp.stats.u.client.lastTime) ?
+                (upTime - rsp.stats.u.client.lastTime) / 1e9 : 0.0;
+        printf("  %-6d %-8d %-9s %12llu %10.1f %12.1f\n", i,
+                rsp.stats.u.client.pid,
+                rsp.stats.u.client.connected ? "connected" : "gone",
+                rsp.stats.u.client.numCommands,
+                secs > 0 ? rsp.stats.u.client.numCommands / secs : 0.0,
+                idle);
+    }
+
+    printf("\n  %-32s %10s %10s\n", "NameServer instance", "entries",
+            "slots");
+    for (i = 0; getStats(handle, LAD_STATS_NAMESERVER, i, &rsp) == 0; i++) {
+        printf("  %-32s %10u %10u\n", rsp.stats.u.nameServer.name,
+                rsp.stats.u.nameServer.numEntries,
+                rsp.stats.u.nameServer.tableSize);
+    }
+
+    printf("\n  %-6s %8s %8s %8s %8s %8s %8s %10s %10s\n", "procId",
+            "queries", "found", "missing", "timeout", "errors", "cached",
+            "mean usec", "max usec");
+    for (i = 0; getStats(handle, LAD_STATS_REMOTE, i, &rsp) == 0; i++) {
+        rs = &rsp.stats.u.remote.stats;
+        if (rs->queries == 0 && rs->errors == 0 && rs->cacheHits == 0 &&
+            !all) {
+            continue;
+        }
+        printf("  %-6u %8u %8u %8u %8u %8u %8u %10.1f %10.1f\n",
+                rsp.stats.u.remote.procId, rs->queries, rs->found,
+                rs->notFound, rs->timeouts, rs->errors, rs->cacheHits,
+                rs->queries ? usec(rs->totalTime) / rs->queries : 0.0,
+                usec(rs->maxTime));
+    }
+
+    LAD_disconnect(handle);
+
+    return (0);
+}
@@ -0,0 +1,547 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ *  @file       ladlog.c
+ *
+ *  @brief      In-memory binary log ring behind the LAD LOGn macros.
+ *
+ *  Writers claim a slot with an atomic increment of the ring head and
+ *  publish it seqlock style: seq is cleared, the record is filled in and
+ *  seq is set to ticket + 1.  The ring overwrites the oldest records, so
+ *  a slow reader loses records rather than stalling the daemon; the
+ *  number lost is reported in the text log and in dumps.
+ *
+ *  The writer thread wakes every LAD_LOGFLUSHMSEC to render new records
+ *  to logPtr, and on SIGUSR1 dumps the ring to LAD_LOGDUMPFILE.
+ */
+
+/* Standard IPC headers */
+#include <ti/ipc/Std.h>
+
+/* Linux specific header files */
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* for Logging */
+#include <_lad.h>
+
+
+/* =============================================================================
+ *  Globals
+ * =============================================================================
+ */
+Bool logFile = FALSE;
+FILE *logPtr = NULL;
+
+static LAD_LogRecord ring[LAD_LOGRINGSIZE];
+static UInt64 ringHead = 0;             /* next ticket to hand out */
+static UInt64 ringTail = 0;             /* next ticket to render */
+static UInt64 ringDropped = 0;          /* records lost before rendering */
+static UInt64 startTime = 0;
+
+static LAD_LogSite *sites[LAD_LOGMAXSITES];
+static UInt16 numSites = 0;
+static pthread_mutex_t siteGate = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_t writerThread;
+static Bool writerRunning = FALSE;
+static volatile Bool writerStop = FALSE;
+
+
+/* =============================================================================
+ *  Internal functions
+ * =============================================================================
+ */
+
+/*
+ *  ======== now ========
+ */
+static UInt64 now(Void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((UInt64)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+/*
+ *  ======== specEnd ========
+ *  Return the conversion character of the spec starting at p (a '%').
+ */
+static const char *specEnd(const char *p)
+{
+    p++;
+    while (*p != '\0' && strchr("-+ #0", *p) != NULL) {
+        p++;
+    }
+    while ((*p >= '0' && *p <= '9') || *p == '.') {
+        p++;
+    }
+    while (*p != '\0' && strchr("hlLqjzt", *p) != NULL) {
+        p++;
+    }
+
+    return (p);
+}
+
+/*
+ *  ======== registerSite ========
+ */
+static Void registerSite(LAD_LogSite *site)
+{
+    pthread_mutex_lock(&siteGate);
+
+    if (site->id == 0 && numSites < LAD_LOGMAXSITES) {
+        site->strMask = LAD_logStrMask(site->fmt);
+        sites[numSites++] = site;
+        __atomic_store_n(&site->id, numSites, __ATOMIC_RELEASE);
+    }
+
+    pthread_mutex_unlock(&siteGate);
+}
+
+/*
+ *  ======== readRecord ========
+ *  Copy out the record for ticket.  Returns 1 on success, 0 if it has
+ *  not been completed yet and -1 if it was overwritten.
+ */
+static Int readRecord(UInt64 ticket, LAD_LogRecord *rec)
+{
+    LAD_LogRecord *slot = &ring[ticket & (LAD_LOGRINGSIZE - 1)];
+    UInt64 seq;
+
+    seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+    if (seq == 0 || seq < ticket + 1) {
+        return (0);
+    }
+    if (seq != ticket + 1) {
+        return (-1);
+    }
+
+    memcpy(rec, slot, sizeof(*rec));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != seq) {
+        return (-1);
+    }
+
+    return (1);
+}
+
+/*
+ *  ======== drain ========
+ *  Render all completed records to logPtr.  Only the writer thread (or
+ *  LAD_logStop() after it has exited) calls this.
+ */
+static Void drain(Void)
+{
+    LAD_LogRecord rec;
+    LAD_LogSite *site;
+    UInt64 head;
+    UInt64 lost = 0;
+    Int status;
+
+    head = __atomic_load_n(&ringHead, __ATOMIC_ACQUIRE);
+
+    if (head - ringTail > LAD_LOGRINGSIZE) {
+        lost = head - ringTail - LAD_LOGRINGSIZE;
+        ringTail = head - LAD_LOGRINGSIZE;
+    }
+
+    while (ringTail < head) {
+        status = readRecord(ringTail, &rec);
+
+        if (status == 0) {
+            break;
+        }
+
+        ringTail++;
+
+        if (status < 0) {
+            lost++;
+            continue;
+        }
+
+        if (lost != 0) {
+            fprintf(logPtr, "[lost %llu log records]\n", lost);
+            ringDropped += lost;
+            lost = 0;
+        }
+
+        site = (rec.site != 0) ? sites[rec.site - 1] : NULL;
+        if (site != NULL) {
+            LAD_logRender(logPtr, site->fmt, site->strMask, &rec);
+        }
+    }
+
+    if (lost != 0) {
+        fprintf(logPtr, "[lost %llu log records]\n", lost);
+        ringDropped += lost;
+    }
+
+    fflush(logPtr);
+}
+
+/*
+ *  ======== writerFxn ========
+ */
+static Void *writerFxn(Void *arg)
+{
+    struct timespec timeout;
+    sigset_t sigs;
+    Int sig;
+
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = LAD_LOGFLUSHMSEC * 1000000L;
+
+    sigemptyset(&sigs);
+    sigaddset(&sigs, SIGUSR1);
+
+    while (!writerStop) {
+        sig = sigtimedwait(&sigs, NULL, &timeout);
+
+        if (logPtr != NULL) {
+            drain();
+        }
+
+        if (sig == SIGUSR1 && !writerStop) {
+            LAD_logDump(LAD_LOGDUMPFILE);
+        }
+    }
+
+    return (NULL);
+}
+
+
+/* =============================================================================
+ *  APIs
+ * =============================================================================
+ */
+
+/*
+ *  ======== LAD_logStart ========
+ */
+Int LAD_logStart(Void)
+{
+    sigset_t sigs;
+
+    if (writerRunning) {
+        return (0);
+    }
+
+    startTime = now();
+
+    /* SIGUSR1 is taken by the writer thread; threads created later inherit */
+    sigemptyset(&sigs);
+    sigaddset(&sigs, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &sigs, NULL);
+
+    writerStop = FALSE;
+    if (pthread_create(&writerThread, NULL, writerFxn, NULL) != 0) {
+        return (-1);
+    }
+    writerRunning = TRUE;
+
+    /* flush the tail of the log however main() returns */
+    atexit(LAD_logStop);
+
+    return (0);
+}
+
+/*
+ *  ======== LAD_logStop ========
+ */
+Void LAD_logStop(Void)
+{
+    if (!writerRunning) {
+        return;
+    }
+
+    writerStop = TRUE;
+    pthread_kill(writerThread, SIGUSR1);
+    pthread_join(writerThread, NULL);
+    writerRunning = FALSE;
+
+    if (logPtr != NULL) {
+        drain();
+    }
+}
+
+/*
+ *  ======== LAD_logWrite ========
+ */
+Void LAD_logWrite(LAD_LogSite *site, UInt64 a0, UInt64 a1, UInt64 a2,
+        UInt64 a3)
+{
+    LAD_LogRecord *rec;
+    UInt64 ticket;
+    UInt16 id;
+    UInt off = 0;
+    UInt len;
+    Int i;
+
+    id = __atomic_load_n(&site->id, __ATOMIC_ACQUIRE);
+    if (id == 0) {
+        registerSite(site);
+        id = site->id;
+        if (id == 0) {
+            return;     /* out of sites */
+        }
+    }
+
+    ticket = __atomic_fetch_add(&ringHead, 1, __ATOMIC_RELAXED);
+    rec = &ring[ticket & (LAD_LOGRINGSIZE - 1)];
+
+    __atomic_store_n(&rec->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    rec->time = now() - startTime;
+    rec->site = id;
+    rec->args[0] = a0;
+    rec->args[1] = a1;
+    rec->args[2] = a2;
+    rec->args[3] = a3;
+
+    /* strings may not outlive the call, keep copies in the record */
+    for (i = 0; i < LAD_LOGMAXARGS && (site->strMask >> i) != 0; i++) {
+        if ((site->strMask & (1 << i)) == 0) {
+            continue;
+        }
+        if (rec->args[i] == 0) {
+            rec->args[i] = LAD_LOGNULLSTR;
+            continue;
+        }
+        len = 0;
+        if (off < LAD_LOGSTRLEN - 1) {
+            len = strnlen((const char *)(uintptr_t)rec->args[i],
+                    LAD_LOGSTRLEN - 1 - off);
+            memcpy(&rec->str[off], (const char *)(uintptr_t)rec->args[i],
+                    len);
+        }
+        rec->str[off + len] = '\0';
+        rec->args[i] = off;
+        off += len + ((off + len < LAD_LOGSTRLEN - 1) ? 1 : 0);
+    }
+
+    __atomic_store_n(&rec->seq, ticket + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ *  ======== LAD_logDump ========
+ */
+Int LAD_logDump(const char *path)
+{
+    LAD_LogDumpHeader hdr;
+    LAD_LogRecord *recs;
+    UInt64 head;
+    UInt64 ticket;
+    UInt16 len;
+    UInt16 id;
+    FILE *out;
+    Int i;
+
+    recs = malloc(LAD_LOGRINGSIZE * sizeof(LAD_LogRecord));
+    if (recs == NULL) {
+        return (-1);
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    strncpy(hdr.magic, LAD_LOGMAGIC, sizeof(hdr.magic));
+
+    head = __atomic_load_n(&ringHead, __ATOMIC_ACQUIRE);
+    ticket = (head > LAD_LOGRINGSIZE) ? head - LAD_LOGRINGSIZE : 0;
+    hdr.dropped = ticket;
+
+    for (; ticket < head; ticket++) {
+        if (readRecord(ticket, &recs[hdr.numRecords]) == 1) {
+            hdr.numRecords++;
+        }
+        else {
+            hdr.dropped++;
+        }
+    }
+
+    out = fopen(path, "w");
+    if (out == NULL) {
+        free(recs);
+        return (-1);
+    }
+
+    pthread_mutex_lock(&siteGate);
+
+    hdr.numSites = numSites;
+    fwrite(&hdr, sizeof(hdr), 1, out);
+
+    for (i = 0; i < numSites; i++) {
+        id = i + 1;
+        len = strlen(sites[i]->fmt);
+        fwrite(&id, sizeof(id), 1, out);
+        fwrite(&len, sizeof(len), 1, out);
+        fwrite(sites[i]->fmt, len, 1, out);
+    }
+
+    pthread_mutex_unlock(&siteGate);
+
+    fwrite(recs, sizeof(LAD_LogRecord), hdr.numRecords, out);
+    fclose(out);
+    free(recs);
+
+    return (0);
+}
+
+/*
+ *  ======== LAD_logStrMask ========
+ */
+UInt16 LAD_logStrMask(const char *fmt)
+{
+    const char *p;
+    UInt16 mask = 0;
+    Int n = 0;
+
+    for (p = fmt; *p != '\0'; p++) {
+        if (*p != '%') {
+            continue;
+        }
+        if (p[1] == '%') {
+            p++;
+            continue;
+        }
+        p = specEnd(p);
+        if (*p == '\0') {
+            break;
+        }
+        if (*p == 's' && n < LAD_LOGMAXARGS) {
+            mask |= 1 << n;
+        }
+        n++;
+    }
+
+    return (mask);
+}
+
+/*
+ *  ======== LAD_logRender ========
+ *  Print rec the way the old synchronous LOGn macros did, timestamp
+ *  first.
+ */
+Void LAD_logRender(FILE *out, const char *fmt, UInt16 strMask,
+        const LAD_LogRecord *rec)
+{
+    const char *p;
+    const char *q;
+    const char *s;
+    char spec[32];
+    UInt64 val;
+    Int longs;
+    Int n = 0;
+
+    fprintf(out, "[%u.%06u] ", (unsigned int)(rec->time / 1000000000ULL),
+            (unsigned int)((rec->time % 1000000000ULL) / 1000));
+
+    for (p = fmt; *p != '\0'; p++) {
+        if (*p != '%') {
+            fputc(*p, out);
+            continue;
+        }
+        if (p[1] == '%') {
+            fputc('%', out);
+            p++;
+            continue;
+        }
+
+        q = specEnd(p);
+        if (*q == '\0' || (q - p + 2) > (Int)sizeof(spec)) {
+            fputs(p, out);
+            break;
+        }
+        memcpy(spec, p, q - p + 1);
+        spec[q - p + 1] = '\0';
+
+        val = (n < LAD_LOGMAXARGS) ? rec->args[n] : 0;
+        longs = (strstr(spec, "ll") != NULL) ? 2 :
+                (strchr(spec, 'l') != NULL) ? 1 : 0;
+
+        if (n < LAD_LOGMAXARGS && (strMask & (1 << n))) {
+            s = (val == LAD_LOGNULLSTR) ? "(null)" :
+                    &rec->str[(val < LAD_LOGSTRLEN) ? val : 0];
+            fprintf(out, spec, s);
+        }
+        else {
+            switch (*q) {
+                case 'd':
+                case 'i':
+                case 'c':
+                    if (longs == 2) {
+                        fprintf(out, spec, (long long)val);
+                    }
+                    else if (longs == 1) {
+                        fprintf(out, spec, (long)val);
+                    }
+                    else {
+                        fprintf(out, spec, (int)val);
+                    }
+                    break;
+
+                case 'u':
+                case 'x':
+                case 'X':
+                case 'o':
+                    if (longs == 2) {
+                        fprintf(out, spec, (unsigned long long)val);
+                    }
+                    else if (longs == 1) {
+                        fprintf(out, spec, (unsigned long)val);
+                    }
+                    else {
+                        fprintf(out, spec, (unsigned int)val);
+                    }
+                    break;
+
+                case 'p':
+                    fprintf(out, spec, (void *)(uintptr_t)val);
+                    break;
+
+                default:
+                    fputs(spec, out);
+                    break;
+            }
+        }
+
+        n++;
+        p = q;
+    }
+}
@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* =============================================================================
+ *  @file   HeapMemMPStress.c
+ *
+ *  @brief  Host stress test for the HeapMemMP allocator
+ *
+ *  Builds the BIOS-side HeapMemMP.c against the host stand-ins in stubs/,
+ *  with a single shared region in process memory, so it runs on any Linux
+ *  host.  A random mix of allocs and frees of 16 B to 64 KB blocks, one in
+ *  ten of them 4 KB aligned, is run against a 64 MB heap while checking
+ *  that no two live blocks overlap and that the free memory adds up.  The
+ *  number of failed allocs and the largest free block at the end measure
+ *  the fragmentation; the alloc and free latencies are also reported.
+ *
+ *  ============================================================================
+ */
+
+/* Standard headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* IPC Headers */
+#include <xdc/std.h>
+#include <xdc/runtime/Memory.h>
+#include <ti/ipc/GateMP.h>
+#include <ti/ipc/HeapMemMP.h>
+#include <ti/ipc/MultiProc.h>
+#include <ti/ipc/NameServer.h>
+#include <ti/ipc/SharedRegion.h>
+#include <ti/sdo/ipc/GateMP.h>
+#include <ti/sdo/ipc/SharedRegion.h>
+
+#define NUM_OPS_DFLT        2000000
+#define HEAP_SIZE           (64 * 1024 * 1024)
+#define REGION_SIZE         (HEAP_SIZE + 1024 * 1024)
+#define CACHE_LINE_SIZE     128
+#define MAX_LIVE            6000
+
+typedef struct {
+    Char    *addr;
+    SizeT   size;
+} Block;
+
+static Char *regionBase = NULL;
+static Int gateEntered = 0;
+static UInt16 clusterProcList[] = { 0 };
+
+/*
+ *  The SharedRegion, GateMP, NameServer and MultiProc functions HeapMemMP
+ *  calls, for one cache-coherent region at regionBase and a gate that
+ *  only checks that it is not entered twice.
+ */
+SizeT SharedRegion_getCacheLineSize(UInt16 regionId)
+{
+    return (CACHE_LINE_SIZE);
+}
+
+Ptr SharedRegion_getHeap(UInt16 regionId)
+{
+    return (NULL);
+}
+
+UInt16 SharedRegion_getId(Ptr addr)
+{
+    if (((Char *)addr >= regionBase) &&
+            ((Char *)addr < regionBase + REGION_SIZE)) {
+        return (0);
+    }
+
+    return (SharedRegion_INVALIDREGIONID);
+}
+
+Ptr SharedRegion_getPtr(SharedRegion_SRPtr srptr)
+{
+    return (srptr == ti_sdo_ipc_SharedRegion_INVALIDSRPTR ? NULL :
+            regionBase + srptr);
+}
+
+SharedRegion_SRPtr SharedRegion_getSRPtr(Ptr addr, UInt16 regionId)
+{
+    return (addr == NULL ? ti_sdo_ipc_SharedRegion_INVALIDSRPTR :
+            (SharedRegion_SRPtr)((Char *)addr - regionBase));
+}
+
+Bool SharedRegion_isCacheEnabled(UInt16 regionId)
+{
+    return (FALSE);
+}
+
+GateMP_Handle GateMP_getDefaultRemote(Void)
+{
+    return ((GateMP_Handle)&gateEntered);
+}
+
+Int GateMP_openByAddr(Ptr sharedAddr, GateMP_Handle *handlePtr)
+{
+    *handlePtr = GateMP_getDefaultRemote();
+
+    return (GateMP_S_SUCCESS);
+}
+
+Int GateMP_close(GateMP_Handle *handlePtr)
+{
+    *handlePtr = NULL;
+
+    return (GateMP_S_SUCCESS);
+}
+
+IArg GateMP_enter(GateMP_Handle handle)
+{
+    if (gateEntered++ != 0) {
+        printf("Error: gate entered twice\n");
+        exit(1);
+    }
+
+    return (0);
+}
+
+Void GateMP_leave(GateMP_Handle handle, IArg key)
+{
+    gateEntered--;
+}
+
+Bits32 ti_sdo_ipc_GateMP_getSharedAddr(ti_sdo_ipc_GateMP_Handle handle)
+{
+    return (0);
+}
+
+Ptr NameServer_addUInt32(NameServer_Handle handle, String name, UInt32 value)
+{
+    return (NULL);
+}
+
+Int NameServer_getUInt32(NameServer_Handle handle, String name, Ptr buf,
+        UInt16 procId[])
+{
+    return (NameServer_E_NOTFOUND);
+}
+
+Int NameServer_removeEntry(NameServer_Handle handle, Ptr entry)
+{
+    return (NameServer_S_SUCCESS);
+}
+
+UInt16 *MultiProc_getClusterProcList(Void)
+{
+    return (clusterProcList);
+}
+
+static int compare(const void *a, const void *b)
+{
+    long x = *(const long *)a;
+    long y = *(const long *)b;
+
+    return (x < y ? -1 : x > y);
+}
+
+static void report(const char *name, long *lat, long num)
+{
+    qsort(lat, num, sizeof(long), compare);
+    printf("    %-5s %7ld ops, nsecs p50 %ld p99 %ld p99.9 %ld max %ld\n",
+            name, num, lat[num / 2], lat[num * 99 / 100],
+            lat[num * 999 / 1000], lat[num - 1]);
+}
+
+static long nsecs(struct timespec start, struct timespec end)
+{
+    return ((end.tv_sec - start.tv_sec) * 1000000000L +
+            (end.tv_nsec - start.tv_nsec));
+}
+
+/*
+ *  Mark the cache lines of a block as owned, or clear them.  Fails if
+ *  a block being allocated overlaps a live one.
+ */
+static Int own(UChar *owner, HeapMemMP_ExtendedStats *heap, Block *block,
+        Bool mark)
+{
+    SizeT first = (block->addr - (Char *)heap->buf) / CACHE_LINE_SIZE;
+    SizeT last = (block->addr + block->size - 1 - (Char *)heap->buf) /
+            CACHE_LINE_SIZE;
+    SizeT i;
+
+    for (i = first; i <= last; i++) {
+        if (mark && owner[i]) {
+            return (-1);
+        }
+        owner[i] = mark;
+    }
+
+    return (0);
+}
+
+Int HeapMemMPStress_execute(long numOps)
+{
+    Int                     status = 0;
+    HeapMemMP_Handle        heap;
+    HeapMemMP_Params        params;
+    HeapMemMP_ExtendedStats ext;
+    Memory_Stats            stats;
+    struct timespec         start, end;
+    Block                   live[MAX_LIVE];
+    Int                     numLive = 0;
+    long                    numFailed = 0;
+    long                    *allocLat, *freeLat;
+    long                    numAlloc = 0, numFree = 0;
+    UChar                   *owner;
+    SizeT                   size, align, used;
+    Block                   block;
+    long                    i;
+    Int                     k;
+
+    printf("Entered HeapMemMPStress_execute: %ld ops\n", numOps);
+
+    regionBase = Memory_alloc(NULL, REGION_SIZE, 4096, NULL);
+    owner = calloc(HEAP_SIZE / CACHE_LINE_SIZE, 1);
+    allocLat = malloc(numOps * sizeof(long));
+    freeLat = malloc(numOps * sizeof(long));
+    if ((regionBase == NULL) || (owner == NULL) || (allocLat == NULL) ||
+            (freeLat == NULL)) {
+        printf("Error: out of memory\n");
+        exit(1);
+    }
+
+    HeapMemMP_Params_init(&params);
+    params.sharedAddr = regionBase;
+    params.sharedBufSize = HEAP_SIZE;
+
+    heap = HeapMemMP_create(&params);
+    if (heap == NULL) {
+        printf("Error in HeapMemMP_create\n");
+        status = -1;
+        goto exit;
+    }
+    HeapMemMP_getExtendedStats(heap, &ext);
+
+    srand(1);
+    for (i = 0; i < numOps; i++) {
+        if ((numLive == 0) ||
+                ((numLive < MAX_LIVE) && (rand() % 100 < 55))) {
+            size = 16 << (rand() % 12);
+            size += rand() % size;
+            align = (rand() % 10 == 0) ? 4096 : 8;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            block.addr = HeapMemMP_alloc(heap, size, align);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            allocLat[numAlloc++] = nsecs(start, end);
+
+            if (block.addr == NULL) {
+                numFailed++;
+                continue;
+            }
+            block.size = size;
+
+            if (((UArg)block.addr & (align - 1)) ||
+                    (block.addr < (Char *)ext.buf) ||
+                    (block.addr + size > (Char *)ext.buf + ext.size) ||
+                    (own(owner, &ext, &block, TRUE) < 0)) {
+                printf("Error: bad block %p of %zu bytes at op %ld\n",
+                        block.addr, size, i);
+                status = -1;
+                goto cleanup;
+            }
+            memset(block.addr, 0x5a, size);
+            live[numLive++] = block;
+        }
+        else {
+            k = rand() % numLive;
+            block = live[k];
+            live[k] = live[--numLive];
+            own(owner, &ext, &block, FALSE);
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            HeapMemMP_free(heap, block.addr, block.size);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            freeLat[numFree++] = nsecs(start, end);
+        }
+
+        /* the free memory and the live blocks make up the whole heap */
+        if (i % 100000 == 0) {
+            used = 0;
+            for (k = 0; k < numLive; k++) {
+                used += (live[k].size + CACHE_LINE_SIZE - 1) &
+                        ~(CACHE_LINE_SIZE - 1);
+            }
+            HeapMemMP_getStats(heap, &stats);
+            if (stats.totalFreeSize + used != ext.size) {
+                printf("Error: %lu bytes free, %zu used, in %zu at op %ld\n",
+                        (ULong)stats.totalFreeSize, used, ext.size, i);
+                status = -1;
+                goto cleanup;
+            }
+        }
+    }
+
+    HeapMemMP_getStats(heap, &stats);
+    printf("    %ld failed allocs, %d live blocks, %lu bytes free, "
+            "largest free block %lu\n", numFailed, numLive,
+            (ULong)stats.totalFreeSize, (ULong)stats.largestFreeSize);
+    report("alloc", allocLat, numAlloc);
+    report("free", freeLat, numFree);
+
+cleanup:
+    while (numLive > 0) {
+        numLive--;
+        HeapMemMP_free(heap, live[numLive].addr, live[numLive].size);
+    }
+
+    /* everything is free again and joined into one block */
+    HeapMemMP_getStats(heap, &stats);
+    if ((stats.totalFreeSize != ext.size) ||
+            (stats.largestFreeSize != ext.size)) {
+        printf("Error: %lu bytes free, largest block %lu, after freeing "
+                "all\n", (ULong)stats.totalFreeSize,
+                (ULong)stats.largestFreeSize);
+        status = -1;
+    }
+
+    HeapMemMP_delete(&heap);
+
+exit:
+    free(freeLat);
+    free(allocLat);
+    free(owner);
+    Memory_free(NULL, regionBase, REGION_SIZE);
+
+    printf("Leaving HeapMemMPStress_execute\n\n");
+
+    return (status);
+}
+
+int main (int argc, char * argv[])
+{
+    Int status;
+    long numOps = NUM_OPS_DFLT;
+
+    if ((argc > 1) && (argv[1][0] == '-')) {
+        printf("Usage: %s [<numOps>]\n", argv[0]);
+        printf("\tDefault: %d ops\n", NUM_OPS_DFLT);
+        exit(0);
+    }
+
+    if (argc > 1) {
+        numOps = strtol(argv[1], NULL, 0);
+    }
+
+    status = HeapMemMPStress_execute(numOps);
+
+    return (status < 0 ? 1 : 0);
+}
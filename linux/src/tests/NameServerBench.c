@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* =============================================================================
+ *  @file   NameServerBench.c
+ *
+ *  @brief  Host microbenchmark for the LAD NameServer tables
+ *
+ *  Links the daemon's NameServer implementation directly, so it runs on
+ *  any Linux host without LAD or remote processors.
+ *
+ *  ============================================================================
+ */
+
+/* Standard headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* IPC Headers */
+#include <ti/ipc/Std.h>
+#include <ti/ipc/NameServer.h>
+#include <_NameServer.h>
+
+#define NUM_ENTRIES_DFLT    10000
+#define NAME_LEN            32
+
+long diff(struct timespec start, struct timespec end)
+{
+    struct timespec temp;
+
+    if ((end.tv_nsec - start.tv_nsec) < 0) {
+        temp.tv_sec = end.tv_sec - start.tv_sec-1;
+        temp.tv_nsec = 1000000000UL + end.tv_nsec - start.tv_nsec;
+    } else {
+        temp.tv_sec = end.tv_sec - start.tv_sec;
+        temp.tv_nsec = end.tv_nsec - start.tv_nsec;
+    }
+
+    return (temp.tv_sec * 1000000UL + temp.tv_nsec / 1000);
+}
+
+Int NameServerBench_execute(UInt32 numEntries)
+{
+    Int                 status = 0;
+    NameServer_Handle   nsHandle;
+    NameServer_Params   params;
+    struct timespec     start, end;
+    char                name[NAME_LEN];
+    UInt32              val;
+    UInt32              i;
+
+    printf("Entered NameServerBench_execute: %d entries\n", numEntries);
+
+    NameServer_Params_init(&params);
+    params.maxNameLen = NAME_LEN;
+
+    nsHandle = NameServer_create("NameServerBench", &params);
+    if (nsHandle == NULL) {
+        printf("Error in NameServer_create\n");
+        status = -1;
+        goto exit;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < numEntries; i++) {
+        snprintf(name, NAME_LEN, "MessageQ_%u", i);
+        if (NameServer_addUInt32(nsHandle, name, i) == NULL) {
+            printf("Error in NameServer_addUInt32 (%s)\n", name);
+            status = -1;
+            goto cleanup;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("    add:    %8ld usecs total, %ld nsecs/op\n", diff(start, end),
+            diff(start, end) * 1000 / numEntries);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < numEntries; i++) {
+        snprintf(name, NAME_LEN, "MessageQ_%u", i);
+        status = NameServer_getLocalUInt32(nsHandle, name, &val);
+        if ((status < 0) || (val != i)) {
+            printf("Error in NameServer_getLocalUInt32 (%s) [%d]\n", name,
+                    status);
+            status = -1;
+            goto cleanup;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("    get:    %8ld usecs total, %ld nsecs/op\n", diff(start, end),
+            diff(start, end) * 1000 / numEntries);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < numEntries; i++) {
+        snprintf(name, NAME_LEN, "MessageQ_%u", i);
+        status = NameServer_remove(nsHandle, name);
+        if (status < 0) {
+            printf("Error in NameServer_remove (%s) [%d]\n", name, status);
+            goto cleanup;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("    remove: %8ld usecs total, %ld nsecs/op\n", diff(start, end),
+            diff(start, end) * 1000 / numEntries);
+
+    /* every entry is gone, lookups must now miss */
+    snprintf(name, NAME_LEN, "MessageQ_%u", numEntries / 2);
+    if (NameServer_getLocalUInt32(nsHandle, name, &val) >= 0) {
+        printf("Error: %s found after removal\n", name);
+        status = -1;
+        goto cleanup;
+    }
+
+    /* refill the instance and time deleting it with all entries in place */
+    for (i = 0; i < numEntries; i++) {
+        snprintf(name, NAME_LEN, "MessageQ_%u", i);
+        if (NameServer_addUInt32(nsHandle, name, i) == NULL) {
+            printf("Error in NameServer_addUInt32 (%s)\n", name);
+            status = -1;
+            goto cleanup;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    NameServer_delete(&nsHandle);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("    delete: %8ld usecs total, %ld nsecs/op\n", diff(start, end),
+            diff(start, end) * 1000 / numEntries);
+    goto exit;
+
+cleanup:
+    NameServer_delete(&nsHandle);
+
+exit:
+    printf("Leaving NameServerBench_execute\n\n");
+
+    return (status);
+}
+
+int main (int argc, char * argv[])
+{
+    Int status = 0;
+    UInt32 numEntries;
+    Int i;
+
+    if ((argc > 1) && (argv[1][0] == '-')) {
+        printf("Usage: %s [<numEntries> ...]\n", argv[0]);
+        printf("\tDefaults: runs with %d and %d entries\n",
+                NUM_ENTRIES_DFLT, NUM_ENTRIES_DFLT * 10);
+        exit(0);
+    }
+
+    status = NameServer_setup();
+    if (status < 0) {
+        printf("Error: NameServer_setup failed, error=%d\n", status);
+        goto exit;
+    }
+
+    if (argc > 1) {
+        for (i = 1; (i < argc) && (status >= 0); i++) {
+            numEntries = strtoul(argv[i], NULL, 0);
+            if (numEntries > 0) {
+                status = NameServerBench_execute(numEntries);
+            }
+        }
+    }
+    else {
+        status = NameServerBench_execute(NUM_ENTRIES_DFLT);
+        if (status >= 0) {
+            status = NameServerBench_execute(NUM_ENTRIES_DFLT * 10);
+        }
+    }
+
+    NameServer_destroy();
+
+exit:
+    return (status < 0 ? 1 : 0);
+}
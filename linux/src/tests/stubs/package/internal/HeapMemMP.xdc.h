@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== HeapMemMP.xdc.h ========
+ *  Host stand-in for the generated internal header of
+ *  ti.sdo.ipc.heaps.HeapMemMP.  create() and delete() run the instance
+ *  functions on a malloc'ed object, as the XDC runtime would.
+ */
+
+#ifndef ti_sdo_ipc_heaps_HeapMemMP__internalaccess
+#define ti_sdo_ipc_heaps_HeapMemMP__internalaccess
+
+#include <ti/sdo/ipc/heaps/HeapMemMP.h>
+
+#define HeapMemMP_module (&ti_sdo_ipc_heaps_HeapMemMP_Module__state__V)
+
+#define HeapMemMP_postInit ti_sdo_ipc_heaps_HeapMemMP_postInit
+
+Int ti_sdo_ipc_heaps_HeapMemMP_Instance_init(
+        ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        const ti_sdo_ipc_heaps_HeapMemMP_Params *params, Error_Block *eb);
+Void ti_sdo_ipc_heaps_HeapMemMP_Instance_finalize(
+        ti_sdo_ipc_heaps_HeapMemMP_Object *obj, Int status);
+Void ti_sdo_ipc_heaps_HeapMemMP_postInit(
+        ti_sdo_ipc_heaps_HeapMemMP_Object *obj, Error_Block *eb);
+
+ti_sdo_ipc_heaps_HeapMemMP_Module_State
+        ti_sdo_ipc_heaps_HeapMemMP_Module__state__V;
+
+/*
+ *  ======== ti_sdo_ipc_heaps_HeapMemMP_Params_init ========
+ */
+Void ti_sdo_ipc_heaps_HeapMemMP_Params_init(
+        ti_sdo_ipc_heaps_HeapMemMP_Params *params)
+{
+    params->gate = NULL;
+    params->openFlag = FALSE;
+    params->name = NULL;
+    params->regionId = 0;
+    params->sharedAddr = NULL;
+    params->sharedBufSize = 0;
+}
+
+/*
+ *  ======== ti_sdo_ipc_heaps_HeapMemMP_create ========
+ */
+ti_sdo_ipc_heaps_HeapMemMP_Handle ti_sdo_ipc_heaps_HeapMemMP_create(
+        const ti_sdo_ipc_heaps_HeapMemMP_Params *params, Error_Block *eb)
+{
+    ti_sdo_ipc_heaps_HeapMemMP_Params defaults;
+    ti_sdo_ipc_heaps_HeapMemMP_Object *obj;
+    Int status;
+
+    if (params == NULL) {
+        ti_sdo_ipc_heaps_HeapMemMP_Params_init(&defaults);
+        params = &defaults;
+    }
+
+    obj = calloc(1, sizeof(*obj));
+    if (obj == NULL) {
+        return (NULL);
+    }
+
+    status = ti_sdo_ipc_heaps_HeapMemMP_Instance_init(obj, params, eb);
+    if (status != 0) {
+        ti_sdo_ipc_heaps_HeapMemMP_Instance_finalize(obj, status);
+        free(obj);
+        return (NULL);
+    }
+
+    return (obj);
+}
+
+/*
+ *  ======== ti_sdo_ipc_heaps_HeapMemMP_delete ========
+ */
+Void ti_sdo_ipc_heaps_HeapMemMP_delete(
+        ti_sdo_ipc_heaps_HeapMemMP_Handle *handlePtr)
+{
+    ti_sdo_ipc_heaps_HeapMemMP_Instance_finalize(*handlePtr, 0);
+    free(*handlePtr);
+    *handlePtr = NULL;
+}
+
+#endif
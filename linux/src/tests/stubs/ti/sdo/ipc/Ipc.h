@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== Ipc.h ========
+ *  Host stand-in for the generated ti.sdo.ipc.Ipc header
+ */
+
+#ifndef ti_sdo_ipc_Ipc__include
+#define ti_sdo_ipc_Ipc__include
+
+#include <xdc/runtime/Assert.h>
+#include <xdc/runtime/Error.h>
+
+typedef enum ti_sdo_ipc_Ipc_ObjType {
+    ti_sdo_ipc_Ipc_ObjType_CREATESTATIC = 0x1,
+    ti_sdo_ipc_Ipc_ObjType_CREATESTATIC_REGION = 0x2,
+    ti_sdo_ipc_Ipc_ObjType_CREATEDYNAMIC = 0x4,
+    ti_sdo_ipc_Ipc_ObjType_CREATEDYNAMIC_REGION = 0x8,
+    ti_sdo_ipc_Ipc_ObjType_OPENDYNAMIC = 0x10,
+    ti_sdo_ipc_Ipc_ObjType_LOCAL = 0x20
+} ti_sdo_ipc_Ipc_ObjType;
+
+#define ti_sdo_ipc_Ipc_A_addrNotCacheAligned    ((Assert_Id)1)
+#define ti_sdo_ipc_Ipc_A_addrNotInSharedRegion  ((Assert_Id)2)
+#define ti_sdo_ipc_Ipc_A_internal               ((Assert_Id)3)
+#define ti_sdo_ipc_Ipc_A_invParam               ((Assert_Id)4)
+#define ti_sdo_ipc_Ipc_A_nullArgument           ((Assert_Id)5)
+
+#define ti_sdo_ipc_Ipc_E_internal               ((Error_Id)1)
+#define ti_sdo_ipc_Ipc_E_nameFailed             ((Error_Id)2)
+
+#endif
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== HeapMemMP.h ========
+ *  Host stand-in for the generated ti.sdo.ipc.heaps.HeapMemMP header.
+ *  The types and constants must match HeapMemMP.xdc.  Define
+ *  ti_sdo_ipc_heaps_HeapMemMP_localCacheSize to configure the local
+ *  cache.
+ */
+
+#ifndef ti_sdo_ipc_heaps_HeapMemMP__include
+#define ti_sdo_ipc_heaps_HeapMemMP__include
+
+#include <xdc/runtime/Assert.h>
+#include <xdc/runtime/Error.h>
+#include <xdc/runtime/Memory.h>
+
+#include <ti/sdo/ipc/Ipc.h>
+#include <ti/sdo/ipc/GateMP.h>
+#include <ti/sdo/utils/NameServer.h>
+
+/* internal constants */
+#define ti_sdo_ipc_heaps_HeapMemMP_CREATED          ((UInt32)0x07041777)
+#define ti_sdo_ipc_heaps_HeapMemMP_SUBCLASSBITS     (3)
+#define ti_sdo_ipc_heaps_HeapMemMP_NUMCLASSES       (256)
+#define ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES    (4)
+
+/* module configs */
+#ifndef ti_sdo_ipc_heaps_HeapMemMP_localCacheSize
+#define ti_sdo_ipc_heaps_HeapMemMP_localCacheSize   (0)
+#endif
+#define ti_sdo_ipc_heaps_HeapMemMP_maxNameLen       (32)
+
+#define ti_sdo_ipc_heaps_HeapMemMP_A_zeroBlock      ((Assert_Id)1)
+#define ti_sdo_ipc_heaps_HeapMemMP_A_heapSize       ((Assert_Id)2)
+#define ti_sdo_ipc_heaps_HeapMemMP_A_align          ((Assert_Id)3)
+#define ti_sdo_ipc_heaps_HeapMemMP_A_invalidFree    ((Assert_Id)4)
+#define ti_sdo_ipc_heaps_HeapMemMP_E_memory         ((Error_Id)3)
+
+typedef struct ti_sdo_ipc_heaps_HeapMemMP_Header {
+    Bits32 next;
+    Bits32 prev;
+    Bits32 size;
+    Bits32 pad;
+} ti_sdo_ipc_heaps_HeapMemMP_Header;
+
+typedef struct ti_sdo_ipc_heaps_HeapMemMP_Attrs {
+    Bits32 status;
+    Bits32 bufPtr;
+    Bits32 bufSize;
+    Bits32 gateMPAddr;
+    Bits32 mapPtr;
+    Bits32 wordMask;
+    Bits32 classMask[8];
+    Bits32 freeList[ti_sdo_ipc_heaps_HeapMemMP_NUMCLASSES];
+} ti_sdo_ipc_heaps_HeapMemMP_Attrs;
+
+typedef struct ti_sdo_ipc_heaps_HeapMemMP_Object {
+    ti_sdo_ipc_heaps_HeapMemMP_Attrs *attrs;
+    ti_sdo_ipc_GateMP_Handle gate;
+    ti_sdo_ipc_Ipc_ObjType objType;
+    Ptr nsKey;
+    Bool cacheEnabled;
+    UInt16 regionId;
+    SizeT allocSize;
+    Char *buf;
+    Bits32 *map;
+    SizeT minAlign;
+    SizeT bufSize;
+    Ptr *localCache;
+    SizeT cachedSize[ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES];
+    UInt numCached[ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES];
+} ti_sdo_ipc_heaps_HeapMemMP_Object;
+
+typedef ti_sdo_ipc_heaps_HeapMemMP_Object *ti_sdo_ipc_heaps_HeapMemMP_Handle;
+
+typedef struct ti_sdo_ipc_heaps_HeapMemMP_Params {
+    ti_sdo_ipc_GateMP_Handle gate;
+    Bool openFlag;
+    String name;
+    UInt16 regionId;
+    Ptr sharedAddr;
+    SizeT sharedBufSize;
+} ti_sdo_ipc_heaps_HeapMemMP_Params;
+
+typedef struct ti_sdo_ipc_heaps_HeapMemMP_Module_State {
+    ti_sdo_utils_NameServer_Handle nameServer;
+} ti_sdo_ipc_heaps_HeapMemMP_Module_State;
+
+extern ti_sdo_ipc_heaps_HeapMemMP_Module_State
+        ti_sdo_ipc_heaps_HeapMemMP_Module__state__V;
+
+Void ti_sdo_ipc_heaps_HeapMemMP_Params_init(
+        ti_sdo_ipc_heaps_HeapMemMP_Params *params);
+ti_sdo_ipc_heaps_HeapMemMP_Handle ti_sdo_ipc_heaps_HeapMemMP_create(
+        const ti_sdo_ipc_heaps_HeapMemMP_Params *params, Error_Block *eb);
+Void ti_sdo_ipc_heaps_HeapMemMP_delete(
+        ti_sdo_ipc_heaps_HeapMemMP_Handle *handlePtr);
+
+Ptr ti_sdo_ipc_heaps_HeapMemMP_alloc(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        SizeT size, SizeT align, Error_Block *eb);
+Void ti_sdo_ipc_heaps_HeapMemMP_free(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        Ptr block, SizeT size);
+Bool ti_sdo_ipc_heaps_HeapMemMP_isBlocking(
+        ti_sdo_ipc_heaps_HeapMemMP_Object *obj);
+Void ti_sdo_ipc_heaps_HeapMemMP_getStats(
+        ti_sdo_ipc_heaps_HeapMemMP_Object *obj, Memory_Stats *stats);
+
+#endif
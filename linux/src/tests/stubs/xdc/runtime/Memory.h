@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== Memory.h ========
+ *  Host stand-in for xdc.runtime.Memory.  Every heap is the C library
+ *  heap.
+ */
+
+#ifndef xdc_runtime_Memory__include
+#define xdc_runtime_Memory__include
+
+#include <stdlib.h>
+
+#include <xdc/runtime/Error.h>
+#include <xdc/runtime/IHeap.h>
+
+typedef UArg Memory_Size;
+
+typedef struct Memory_Stats {
+    Memory_Size totalSize;
+    Memory_Size totalFreeSize;
+    Memory_Size largestFreeSize;
+} Memory_Stats;
+
+static inline Ptr Memory_alloc(IHeap_Handle heap, SizeT size, SizeT align,
+        Error_Block *eb)
+{
+    Ptr block;
+
+    if (align < sizeof(Ptr)) {
+        align = sizeof(Ptr);
+    }
+    if (posix_memalign(&block, align, size) != 0) {
+        Error_raise(eb, 1, 0, 0);
+        return (NULL);
+    }
+
+    return (block);
+}
+
+static inline Void Memory_free(IHeap_Handle heap, Ptr block, SizeT size)
+{
+    free(block);
+}
+
+#endif
@@ -331,9 +331,14 @@ LAD_Status LAD_putCommand(struct LAD_CommandObj *cmd)
     LAD_Status status = LAD_SUCCESS;
     Int stat;
     Int n;
+    struct timespec ts;
 
     PRINTVERBOSE1("\nLAD_putCommand: cmd = %d\n", cmd->cmd);
 
+    /* lets LAD measure how long the command waited in the FIFO */
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    cmd->sendTime = (UInt64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+
     pthread_mutex_lock(&modGate);
 
     n = fwrite(cmd, LAD_COMMANDLENGTH, 1, commandFIFOFilePtr);
@@ -360,6 +365,23 @@ LAD_Status LAD_putCommand(struct LAD_CommandObj *cmd)
     return(status);
 }
 
+/*
+ *  ======== LAD_postCommand ========
+ *  Send a command for which LAD returns no response.
+ */
+LAD_Status LAD_postCommand(struct LAD_CommandObj *cmd)
+{
+    LAD_Status status;
+
+    status = LAD_putCommand(cmd);
+
+    /* nothing to read back, release the mutex LAD_putCommand() took */
+    if (status == LAD_SUCCESS) {
+        pthread_mutex_unlock(&modGate);
+    }
+
+    return(status);
+}
 
 /*
  *  ======== initWrappers ========
@@ -150,6 +150,14 @@ extern "C" {
  *  @brief  Operation was interrupted. Please restart the operation  */
 #define GateMP_E_RESTART           (-10)
 
+/*!
+ *  @brief  Gate is held by another thread or processor  */
+#define GateMP_E_BUSY              (-11)
+
+/*!
+ *  @brief  Operation is not supported for this gate  */
+#define GateMP_E_NOTSUPPORTED      (-12)
+
 /* =============================================================================
  *  Structures & Enums
  * =============================================================================
@@ -274,6 +282,72 @@ typedef struct GateMP_Params {
      */
 } GateMP_Params;
 
+/*!
+ *  @brief  Number of log2 usec buckets in the #GateMP_Stats histograms
+ */
+#define GateMP_STATSBUCKETS     16
+
+/*!
+ *  @brief  Number of call sites reported in #GateMP_Stats
+ */
+#define GateMP_STATSSITES       8
+
+/*!
+ *  @brief  A caller of GateMP_enter(), found by sampling acquisitions
+ */
+typedef struct GateMP_CallSite {
+    Ptr addr;
+    /*!< Return address of the GateMP_enter() call, NULL if unused */
+
+    UInt32 samples;
+    /*!< Sampled acquisitions made from this call site (an upper bound) */
+
+    UInt64 waitTime;
+    /*!< Time the sampled acquisitions waited for the gate, in nsec */
+} GateMP_CallSite;
+
+/*!
+ *  @brief  Contention statistics of a GateMP instance, as seen by the
+ *          calling process.  Times are in nsec.
+ *
+ *  Histogram bucket 0 counts times below 1 usec, bucket n times from
+ *  2^(n-1) up to 2^n usec, and the last bucket everything longer.
+ */
+typedef struct GateMP_Stats {
+    UInt32 numEnters;
+    /*!< Times the gate was acquired (nested enters are not counted) */
+
+    UInt32 numContended;
+    /*!< Acquisitions that waited 1 usec or more for the gate */
+
+    UInt32 numNested;
+    /*!< Enters by a thread already holding the gate */
+
+    UInt32 maxDepth;
+    /*!< Deepest nesting seen */
+
+    UInt64 totalWaitTime;
+    /*!< Time spent waiting in GateMP_enter(), summed */
+
+    UInt64 maxWaitTime;
+    /*!< Longest wait in GateMP_enter() */
+
+    UInt64 totalHoldTime;
+    /*!< Time the gate was held, summed */
+
+    UInt64 maxHoldTime;
+    /*!< Longest time the gate was held */
+
+    UInt32 waitHist[GateMP_STATSBUCKETS];
+    /*!< Wait times, log2 usec buckets */
+
+    UInt32 holdHist[GateMP_STATSBUCKETS];
+    /*!< Hold times, log2 usec buckets */
+
+    GateMP_CallSite sites[GateMP_STATSSITES];
+    /*!< Most frequent callers, most samples first */
+} GateMP_Stats;
+
 /* =============================================================================
  *  GateMP Module-wide Functions
  * =============================================================================
@@ -391,6 +465,149 @@ IArg GateMP_enter(GateMP_Handle handle);
  */
 Void GateMP_leave(GateMP_Handle handle, IArg key);
 
+/*!
+ *  @brief      Enter the GateMP without waiting
+ *
+ *  Makes one attempt to enter the gate.  A thread that already holds
+ *  the gate always succeeds, as with GateMP_enter().  On success the
+ *  gate must be left with GateMP_leave() and @c key.
+ *
+ *  @note       Only the remote protection is tried without waiting.  On
+ *              SYS/BIOS the local protection (e.g. GateMP_LocalProtect_TASK)
+ *              may still block while another thread of the same processor
+ *              holds the gate.
+ *
+ *  @param[in]  handle      GateMP handle
+ *  @param[out] key         key that must be used to leave the gate
+ *
+ *  @return     Status
+ *              - #GateMP_E_BUSY: the gate is held by another thread or
+ *                processor
+ *              - #GateMP_S_SUCCESS: the gate was entered
+ *
+ *  @sa         GateMP_enterTimeout()
+ */
+Int GateMP_tryEnter(GateMP_Handle handle, IArg *key);
+
+/*!
+ *  @brief      Enter the GateMP, waiting at most a given time
+ *
+ *  Retries the gate until it is entered or @c timeout microseconds have
+ *  passed.  The gate is polled, so it may be entered a little after it
+ *  was released by its previous owner.
+ *
+ *  @param[in]  handle      GateMP handle
+ *  @param[in]  timeout     maximum time to wait, in microseconds
+ *  @param[out] key         key that must be used to leave the gate
+ *
+ *  @return     Status
+ *              - #GateMP_E_TIMEOUT: the gate was not entered in time
+ *              - #GateMP_S_SUCCESS: the gate was entered
+ *
+ *  @sa         GateMP_tryEnter()
+ */
+Int GateMP_enterTimeout(GateMP_Handle handle, UInt timeout, IArg *key);
+
+/*!
+ *  @brief      Enter the GateMP as a reader
+ *
+ *  Any number of readers on any processor can be between
+ *  GateMP_enterRead() and GateMP_leaveRead() at the same time.  Readers
+ *  only hold the gate while they count themselves in and out, and wait
+ *  while a writer is waiting or writing, so a steady stream of readers
+ *  cannot starve writers.
+ *
+ *  Readers are only excluded by GateMP_enterWrite(), not by
+ *  GateMP_enter().  A thread must not enter the gate as a reader while
+ *  it holds it as a writer or the other way around.
+ *
+ *  A reader or writer that has to wait gives the gate up between looks.
+ *  On SYS/BIOS a waiting task sleeps a tick after a few looks, so that
+ *  lower priority threads on the same processor can get out of the way.
+ *  Swis and Hwis keep polling, so they must only wait for other
+ *  processors.
+ *
+ *  @note       On Linux, gates with remote protection keep the reader
+ *              count in shared memory the host does not map.  There
+ *              GateMP_enterRead() and GateMP_enterWrite() fail with
+ *              #GateMP_E_NOTSUPPORTED.
+ *
+ *  @param[in]  handle      GateMP handle
+ *  @param[out] key         key that must be used to leave the gate
+ *
+ *  @return     Status
+ *              - #GateMP_E_NOTSUPPORTED: the gate has no reader/writer
+ *                state on this processor
+ *              - #GateMP_S_SUCCESS: the gate was entered as a reader
+ *
+ *  @sa         GateMP_leaveRead()
+ */
+Int GateMP_enterRead(GateMP_Handle handle, IArg *key);
+
+/*!
+ *  @brief      Leave the GateMP as a reader
+ *
+ *  @param[in]  handle      GateMP handle
+ *  @param[in]  key         key returned from GateMP_enterRead
+ */
+Void GateMP_leaveRead(GateMP_Handle handle, IArg key);
+
+/*!
+ *  @brief      Enter the GateMP as a writer
+ *
+ *  Keeps new readers out, waits for the readers already in the gate to
+ *  leave, and returns holding the gate exclusively.
+ *
+ *  @param[in]  handle      GateMP handle
+ *  @param[out] key         key that must be used to leave the gate
+ *
+ *  @return     Status
+ *              - #GateMP_E_NOTSUPPORTED: the gate has no reader/writer
+ *                state on this processor
+ *              - #GateMP_S_SUCCESS: the gate was entered as a writer
+ *
+ *  @sa         GateMP_enterRead()
+ */
+Int GateMP_enterWrite(GateMP_Handle handle, IArg *key);
+
+/*!
+ *  @brief      Leave the GateMP as a writer
+ *
+ *  @param[in]  handle      GateMP handle
+ *  @param[in]  key         key returned from GateMP_enterWrite
+ */
+Void GateMP_leaveWrite(GateMP_Handle handle, IArg key);
+
+/*!
+ *  @brief      Get the contention statistics of a GateMP instance
+ *              (Linux only)
+ *
+ *  Statistics are only collected when the GATEMP_PROFILE environment
+ *  variable is set when Ipc_start() runs.  Its value selects where
+ *  SIGUSR2 dumps the statistics of all gates in the process: a path
+ *  starting with '/' is appended to, anything else writes to stderr.
+ *
+ *  @param[in]  handle      GateMP handle
+ *  @param[out] stats       Statistics of the instance
+ *
+ *  @return     GateMP status:
+ *              - #GateMP_E_INVALIDSTATE: profiling is not enabled
+ *              - #GateMP_S_SUCCESS: statistics returned
+ */
+Int GateMP_getStats(GateMP_Handle handle, GateMP_Stats *stats);
+
+/*!
+ *  @brief      Clear the contention statistics of a GateMP instance
+ *              (Linux only)
+ *
+ *  @param[in]  handle      GateMP handle
+ *
+ *  @return     GateMP status:
+ *              - #GateMP_E_INVALIDSTATE: profiling is not enabled
+ *              - #GateMP_S_SUCCESS: statistics cleared
+ */
+Int GateMP_resetStats(GateMP_Handle handle);
+
 #if defined (__cplusplus)
 }
 #endif /* defined (__cplusplus) */
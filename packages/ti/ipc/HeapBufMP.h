@@ -385,6 +385,31 @@ SizeT HeapBufMP_sharedMemReq(const HeapBufMP_Params *params);
  */
 Void *HeapBufMP_alloc(HeapBufMP_Handle handle, SizeT size, SizeT align);
 
+/*!
+ *  @brief      Allocate several blocks
+ *
+ *  HeapBufMP_allocN() allocates @c num blocks, each like HeapBufMP_alloc(),
+ *  entering the HeapBufMP gate once for all of them.  Either all of the
+ *  blocks are allocated or none are.
+ *
+ *  @param[in]  handle    Handle to previously created/opened instance.
+ *  @param[in]  size      Size of each block (in MADUs)
+ *  @param[in]  align     Alignment of each block (power of 2)
+ *  @param[out] blocks    Array receiving the @c num allocated blocks
+ *  @param[in]  num       Number of blocks to allocate
+ *
+ *  @return     HeapBufMP status:
+ *              - #HeapBufMP_S_SUCCESS: all blocks allocated
+ *              - #HeapBufMP_E_INVALIDARG: size or align too large for the
+ *                heap
+ *              - #HeapBufMP_E_MEMORY: fewer than @c num free blocks, none
+ *                allocated
+ *
+ *  @sa         HeapBufMP_freeN()
+ */
+Int HeapBufMP_allocN(HeapBufMP_Handle handle, SizeT size, SizeT align,
+        Ptr blocks[], UInt num);
+
 /*!
  *  @brief      Frees a block of memory.
  *
@@ -404,6 +429,22 @@ Void *HeapBufMP_alloc(HeapBufMP_Handle handle, SizeT size, SizeT align);
  */
 Void HeapBufMP_free(HeapBufMP_Handle handle, Ptr block, SizeT size);
 
+/*!
+ *  @brief      Frees several blocks
+ *
+ *  HeapBufMP_freeN() frees @c num blocks, each like HeapBufMP_free(),
+ *  entering the HeapBufMP gate once for all of them.
+ *
+ *  @param[in]  handle    Handle to previously created/opened instance.
+ *  @param[in]  blocks    Array of the @c num blocks to be freed
+ *  @param[in]  size      Size of each block (in MADUs)
+ *  @param[in]  num       Number of blocks to free
+ *
+ *  @sa         HeapBufMP_allocN()
+ */
+Void HeapBufMP_freeN(HeapBufMP_Handle handle, Ptr blocks[], SizeT size,
+        UInt num);
+
 /*!
  *  @brief      Get extended memory statistics
  *
@@ -307,6 +307,19 @@ typedef struct HeapMultiBufMP_ExtendedStats {
      *  instance
      */
 
+    UInt numHits            [HeapMultiBufMP_MAXBUCKETS];
+    /*!< Allocations served by the bucket that best fits the requested
+     *  size and alignment
+     */
+
+    UInt numMisses          [HeapMultiBufMP_MAXBUCKETS];
+    /*!< Allocations that found their best fitting bucket empty */
+
+    UInt numSpills          [HeapMultiBufMP_MAXBUCKETS];
+    /*!< Misses that were served by the next larger non-empty bucket (only
+     *  when the module is configured with the SPILL fallback policy)
+     */
+
 } HeapMultiBufMP_ExtendedStats;
 
 /* =============================================================================
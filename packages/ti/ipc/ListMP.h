@@ -208,6 +208,20 @@ typedef struct ListMP_Params {
      *  name is not null.
      */
 
+    UInt spscLength;
+    /*!< Number of slots for single-producer/single-consumer mode
+     *
+     *  The default of 0 creates a regular list where every operation enters
+     *  the GateMP.  A non-zero value, which must be a power of 2, adds a ring
+     *  of that many element pointers to the shared memory.  ListMP_putTail()
+     *  from one processor and ListMP_getHead() from one other processor then
+     *  pass elements through the ring without entering the GateMP.  When the
+     *  ring is full, elements go through the gated list instead, in order.
+     *
+     *  Only ListMP_putTail(), ListMP_getHead() and ListMP_empty() may be
+     *  used on such a list.
+     */
+
 } ListMP_Params;
 
 /* =============================================================================
@@ -361,6 +375,38 @@ SizeT ListMP_sharedMemReq(const ListMP_Params *params);
  */
 Bool ListMP_empty(ListMP_Handle handle);
 
+/*!
+ *  @brief      Remove all elements from a ListMP instance
+ *
+ *  Atomically detaches every element of a ListMP instance and returns the
+ *  first one.  Only the list head is updated, so the cost does not depend
+ *  on the number of elements.  The detached elements stay linked to each
+ *  other; walk them with ListMP_next(), which returns NULL after the last
+ *  one.  The chain is no longer part of the list, so the walk needs no
+ *  protection, but the next element must be fetched before an element is
+ *  put on any list again.
+ *
+ *  @code
+ *  ListMP_Elem *elem, *next;
+ *
+ *  elem = ListMP_getAll(listHandle);
+ *  while (elem != NULL) {
+ *      next = ListMP_next(listHandle, elem);
+ *      // act on elem, it may be put on another list
+ *      elem = next;
+ *  }
+ *  @endcode
+ *
+ *  Not supported on a list created with #ListMP_Params.spscLength.
+ *
+ *  @param      handle  a ListMP handle.
+ *
+ *  @return     pointer to former first element. NULL if the ListMP is empty.
+ *
+ *  @sa         ListMP_putTailList()
+ */
+Ptr ListMP_getAll(ListMP_Handle handle);
+
 /*!
  *  @brief      Retrieves the GateMP handle associated with the ListMP instance.
  *
@@ -383,6 +429,25 @@ GateMP_Handle ListMP_getGate(ListMP_Handle handle);
  */
 Ptr ListMP_getHead(ListMP_Handle handle);
 
+/*!
+ *  @brief      Get several elements from front of a ListMP instance
+ *
+ *  Atomically removes up to @c num elements from the front of a ListMP
+ *  instance into @c elems, in list order.  #ListMP_Params.gate is entered
+ *  once, and the head and the new first element are each written once,
+ *  however many elements are removed.
+ *
+ *  @param      handle  a ListMP handle
+ *  @param      elems   array to receive up to @c num element pointers
+ *  @param      num     maximum number of elements to remove
+ *
+ *  @return     Number of elements removed, 0 if the ListMP is empty.
+ *
+ *  @sa         ListMP_getHead()
+ *  @sa         ListMP_putTailList()
+ */
+UInt ListMP_getHeadList(ListMP_Handle handle, ListMP_Elem *elems[], UInt num);
+
 /*!
  *  @brief      Get an element from back of a ListMP instance
  *
@@ -535,6 +600,27 @@ Int ListMP_putHead(ListMP_Handle handle, ListMP_Elem *elem);
  */
 Int ListMP_putTail(ListMP_Handle handle, ListMP_Elem *elem);
 
+/*!
+ *  @brief      Put several elements at back of a ListMP instance
+ *
+ *  Atomically appends @c num elements, in array order, to the back of a
+ *  ListMP instance.  The elements are linked to each other before the
+ *  gate is entered, so #ListMP_Params.gate is held only for the constant
+ *  time splice, however many elements are added.
+ *
+ *  @param      handle  a ListMP handle
+ *  @param      elems   array of pointers to the new ListMP elements
+ *  @param      num     number of elements in @c elems
+ *
+ *  @return     Status
+ *              - #ListMP_S_SUCCESS:  if operation was successful
+ *              - #ListMP_E_FAIL:  if operation failed
+ *
+ *  @sa         ListMP_getAll()
+ *  @sa         ListMP_getHeadList()
+ */
+Int ListMP_putTailList(ListMP_Handle handle, ListMP_Elem *elems[], UInt num);
+
 /*!
  *  @brief      Remove an element from a ListMP instance
  *
@@ -540,6 +540,21 @@ typedef struct {
       *  reserved slots.
       */
 
+     Bool syncRegister;
+     /*!< Wait until the name is registered (Linux only)
+      *
+      *  On Linux, MessageQ_create() of a named queue with queueIndex
+      *  MessageQ_ANY publishes the name without waiting for LAD (see
+      *  MessageQ_create()).  Set this to TRUE to wait for LAD instead, so
+      *  that MessageQ_create() fails if the name is already in use and the
+      *  name can be opened as soon as MessageQ_create() returns.  This
+      *  costs a round trip to LAD.
+      *
+      *  Other operating systems always register the name before
+      *  MessageQ_create() returns and ignore this parameter.  The default
+      *  is FALSE.
+      */
+
 } MessageQ_Params;
 
 /** @cond INTERNAL */
@@ -552,11 +567,17 @@ typedef struct {
 #define MessageQ_Params_VERSION_2       2
 /** @endcond INTERNAL */
 
+/** @cond INTERNAL */
+/*  Added the syncRegister field.
+ */
+#define MessageQ_Params_VERSION_3       3
+/** @endcond INTERNAL */
+
 /** @cond INTERNAL */
 /*!
  *  @brief      Defines the current params structure version
  */
-#define MessageQ_Params_VERSION         MessageQ_Params_VERSION_2
+#define MessageQ_Params_VERSION         MessageQ_Params_VERSION_3
 /** @endcond INTERNAL */
 
 /*!
@@ -724,6 +745,17 @@ Void MessageQ_Params2_init(MessageQ_Params2 *params);
  *  MessageQ_create() is unique across all processors. Caution must be exercised
  *  to ensure that each processor uses a unique name.
  *
+ *  On Linux, a named queue created with queueIndex #MessageQ_ANY has its
+ *  name registered with LAD asynchronously, unless
+ *  #MessageQ_Params.syncRegister is set.  Two things follow from this:
+ *  - If the name is already in use, MessageQ_create() still returns a
+ *    valid handle.  The registration fails, the failure is only reported
+ *    in the LAD log, and the queue can't be opened by name.
+ *  - The name may not be registered yet when MessageQ_create() returns.
+ *    Later LAD requests from the same process are handled after the
+ *    registration, but a MessageQ_open() of the name by another process
+ *    can run first and fail.  Retry the open, or set syncRegister.
+ *
  *  @param[in]  name        Name of the queue
  *  @param[in]  params      Initialized MessageQ parameters
  *
@@ -885,6 +917,33 @@ Int MessageQ_close(MessageQ_QueueId *queueId);
  */
 MessageQ_Msg MessageQ_alloc(UInt16 heapId, UInt32 size);
 
+/*!
+ *  @brief      Allocates several messages from the heap
+ *
+ *  This function allocates @c num messages of the same size from the heap
+ *  associated with the heapId, each like MessageQ_alloc().  Either all of
+ *  the messages are allocated or none are.  Where the heap supports it
+ *  (e.g. HeapBufMP on SYS/BIOS), the messages are taken from the heap in
+ *  a single critical section.
+ *
+ *  @param[in]  heapId      heapId
+ *  @param[in]  size        size of each message (including the
+ *                          #MessageQ_MsgHeader).
+ *  @param[out] msgs        Array receiving the @c num allocated messages
+ *  @param[in]  num         Number of messages to allocate
+ *
+ *  @pre        @c size must be at least large enough to hold a
+ *              MessageQ_MsgHeader
+ *
+ *  @return     MessageQ status:
+ *              - #MessageQ_S_SUCCESS: all messages allocated
+ *              - #MessageQ_E_MEMORY: not enough memory, none allocated
+ *
+ *  @sa         MessageQ_alloc()
+ */
+Int MessageQ_allocN(UInt16 heapId, UInt32 size, MessageQ_Msg msgs[],
+        UInt num);
+
 /*!
  *  @brief      Frees a message back to the heap
  *
@@ -576,6 +576,7 @@ Int Notify_sendEvent(UInt16 procId, UInt16 lineId, UInt32 eventId,
  *
  *  @return     Notify status:
  *              - #Notify_E_NOTFOUND: event listener not found
+ *              - #Notify_E_MEMORY: no memory for the remaining listeners
  *              - #Notify_S_SUCCESS: event listener unregistered
  *
  *  @sa         Notify_registerEvent()
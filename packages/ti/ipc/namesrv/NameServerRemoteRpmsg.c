@@ -42,6 +42,7 @@
 #include <xdc/runtime/Diags.h>
 #include <xdc/runtime/knl/ISync.h>
 
+#include <ti/sysbios/BIOS.h>
 #include <ti/sysbios/gates/GateMutex.h>
 #include <ti/sysbios/knl/Semaphore.h>
 #include <ti/sdo/utils/_NameServer.h>
@@ -270,6 +271,56 @@ exit:
 }
 #undef FXNN
 
+/*
+ *  ======== NameServerRemoteRpmsg_invalidate ========
+ *  The host NameServer doesn't cache what it gets from us.
+ */
+Void NameServerRemoteRpmsg_invalidate(NameServerRemoteRpmsg_Object *obj,
+        String instanceName)
+{
+}
+
+/*
+ *  ======== NameServerRemoteRpmsg_announce ========
+ *  The host NameServer caches misses for a while.  Tell it a name was
+ *  added, so a MessageQ_open() polling for it succeeds right away.
+ */
+#define FXNN "NameServerRemoteRpmsg_announce"
+Void NameServerRemoteRpmsg_announce(NameServerRemoteRpmsg_Object *obj,
+        String instanceName, String name)
+{
+    NameServerRemote_Msg msg;
+
+    /* the host NameServer may not be up yet, it has nothing cached then */
+    if (NameServerRemoteRpmsg_module->nsPort == NAME_SERVER_PORT_INVALID) {
+        return;
+    }
+
+    /* RPMessage_send may pend for a buffer, elsewhere the miss ages out */
+    if (BIOS_getThreadType() != BIOS_ThreadType_Task) {
+        return;
+    }
+
+    /* the host can't have looked up names it can't send */
+    if ((strlen(instanceName) >= MAXNAMEINCHAR) ||
+            (strlen(name) >= MAXNAMEINCHAR)) {
+        return;
+    }
+
+    msg.request = NameServerRemoteRpmsg_ANNOUNCE;
+    msg.requestStatus = 0;
+    msg.valueLen = 0;
+    msg.seqNum = 0;
+    strcpy((Char *)msg.instanceName, instanceName);
+    strcpy((Char *)msg.name, name);
+
+    Log_print3(Diags_INFO, FXNN": Announcing to procId %d, %s:%s\n",
+               obj->remoteProcId, (IArg)msg.instanceName, (IArg)msg.name);
+    RPMessage_send(obj->remoteProcId, NameServerRemoteRpmsg_module->nsPort,
+               RPMSG_MESSAGEQ_PORT, (Ptr)&msg, sizeof(msg));
+}
+#undef FXNN
+
 /*
  *  ======== NameServerRemoteRpmsg_sharedMemReq ========
  */
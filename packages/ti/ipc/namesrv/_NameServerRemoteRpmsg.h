@@ -68,6 +68,7 @@ typedef struct NameServerRemote_Msg {
 
 #define NAMESERVER_REQUEST    0
 #define NAMESERVER_RESPONSE   1
+#define NAMESERVER_ANNOUNCE   2   /* remote added a name, no response */
 
 #else /* SYSBIOS only */
 
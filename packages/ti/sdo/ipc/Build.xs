@@ -389,7 +389,8 @@ var ipcSources  =  "ti/sdo/ipc/GateMP.c " +
                    "ti/ipc/namesrv/NameServerRemoteRpmsg.c " +
                    "ti/ipc/remoteproc/Resource.c ";
 
-var gatesSources = "ti/sdo/ipc/gates/GatePeterson.c " +
+var gatesSources = "ti/sdo/ipc/gates/GateMCS.c " +
+                   "ti/sdo/ipc/gates/GatePeterson.c " +
                    "ti/sdo/ipc/gates/GatePetersonN.c " +
                    "ti/sdo/ipc/gates/GateMPSupportNull.c ";
 
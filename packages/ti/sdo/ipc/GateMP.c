@@ -42,9 +42,13 @@
 #include <xdc/runtime/IHeap.h>
 #include <xdc/runtime/Memory.h>
 #include <xdc/runtime/Log.h>
+#include <xdc/runtime/Timestamp.h>
+#include <xdc/runtime/Types.h>
 
 #include <ti/sdo/ipc/interfaces/IGateMPSupport.h>
 
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Task.h>
 #include <ti/sysbios/gates/GateMutexPri.h>
 #include <ti/sysbios/gates/GateSwi.h>
 #include <ti/sysbios/gates/GateAll.h>
@@ -76,13 +80,19 @@
     #pragma FUNC_EXT_CALLED(GateMP_close);
     #pragma FUNC_EXT_CALLED(GateMP_delete);
     #pragma FUNC_EXT_CALLED(GateMP_enter);
+    #pragma FUNC_EXT_CALLED(GateMP_enterRead);
+    #pragma FUNC_EXT_CALLED(GateMP_enterTimeout);
+    #pragma FUNC_EXT_CALLED(GateMP_enterWrite);
     #pragma FUNC_EXT_CALLED(GateMP_getDefaultRemote);
     #pragma FUNC_EXT_CALLED(GateMP_getLocalProtect);
     #pragma FUNC_EXT_CALLED(GateMP_getRemoteProtect);
     #pragma FUNC_EXT_CALLED(GateMP_leave);
+    #pragma FUNC_EXT_CALLED(GateMP_leaveRead);
+    #pragma FUNC_EXT_CALLED(GateMP_leaveWrite);
     #pragma FUNC_EXT_CALLED(GateMP_open);
     #pragma FUNC_EXT_CALLED(GateMP_openByAddr);
     #pragma FUNC_EXT_CALLED(GateMP_sharedMemReq);
+    #pragma FUNC_EXT_CALLED(GateMP_tryEnter);
 #endif
 
 /*
@@ -118,6 +128,30 @@ static Void GateMP_getRTSCParams(ti_sdo_ipc_GateMP_Params *params,
         sparams->remoteProtect;
 }
 
+/*
+ *  ======== GateMP_invAttrs ========
+ *  Get the reader/writer state written by other processors.
+ */
+static inline Void GateMP_invAttrs(ti_sdo_ipc_GateMP_Object *obj)
+{
+    if (obj->cacheEnabled) {
+        Cache_inv(obj->attrs, sizeof(ti_sdo_ipc_GateMP_Attrs),
+                Cache_Type_ALL, TRUE);
+    }
+}
+
+/*
+ *  ======== GateMP_wbInvAttrs ========
+ *  Publish a change of the reader/writer state.
+ */
+static inline Void GateMP_wbInvAttrs(ti_sdo_ipc_GateMP_Object *obj)
+{
+    if (obj->cacheEnabled) {
+        Cache_wbInv(obj->attrs, sizeof(ti_sdo_ipc_GateMP_Attrs),
+                Cache_Type_ALL, TRUE);
+    }
+}
+
 /*
  *************************************************************************
  *                       Common Header Functions
@@ -230,6 +264,232 @@ Void GateMP_leave(GateMP_Handle handle, IArg key)
         (UArg)obj->resourceId, key);
 }
 
+/*
+ *  ======== GateMP_tryLock ========
+ *  One attempt to enter the gate.  Gates without remote protection only
+ *  have local protection, which never waits for another processor.
+ */
+static inline Bool GateMP_tryLock(ti_sdo_ipc_GateMP_Object *obj, IArg *key)
+{
+    if ((GateMP_RemoteProtect)(obj->remoteProtect) ==
+        GateMP_RemoteProtect_NONE) {
+        *key = IGateProvider_enter(obj->gateHandle);
+        return (TRUE);
+    }
+
+    return (IGateMPSupport_tryEnter(
+        IGateMPSupport_Handle_downCast(obj->gateHandle), key));
+}
+
+/*
+ *  ======== GateMP_tryEnter ========
+ */
+Int GateMP_tryEnter(GateMP_Handle handle, IArg *key)
+{
+    ti_sdo_ipc_GateMP_Object *obj = (ti_sdo_ipc_GateMP_Object *)handle;
+
+    Assert_isTrue(obj != NULL, ti_sdo_ipc_Ipc_A_nullArgument);
+
+    if (!GateMP_tryLock(obj, key)) {
+        return (GateMP_E_BUSY);
+    }
+
+    Log_write3(ti_sdo_ipc_GateMP_LM_enter,(UArg)obj->remoteProtect,
+            (UArg)obj->resourceId, *key);
+
+    return (GateMP_S_SUCCESS);
+}
+
+/*
+ *  ======== GateMP_enterTimeout ========
+ *  Polls the gate.  The elapsed time is accumulated from 32-bit
+ *  timestamp deltas so the timestamp may wrap while waiting.
+ */
+Int GateMP_enterTimeout(GateMP_Handle handle, UInt timeout, IArg *key)
+{
+    ti_sdo_ipc_GateMP_Object *obj = (ti_sdo_ipc_GateMP_Object *)handle;
+    Types_FreqHz freq;
+    UInt32 ticksPerUsec;
+    UInt32 ticks = 0;
+    UInt32 last;
+    UInt32 now;
+    UInt elapsed = 0;
+
+    Assert_isTrue(obj != NULL, ti_sdo_ipc_Ipc_A_nullArgument);
+
+    Timestamp_getFreq(&freq);
+    ticksPerUsec = freq.lo / 1000000;
+    if (ticksPerUsec == 0) {
+        ticksPerUsec = 1;
+    }
+
+    last = Timestamp_get32();
+
+    while (!GateMP_tryLock(obj, key)) {
+        now = Timestamp_get32();
+        ticks += now - last;
+        last = now;
+
+        elapsed += ticks / ticksPerUsec;
+        ticks %= ticksPerUsec;
+
+        if (elapsed >= timeout) {
+            return (GateMP_E_TIMEOUT);
+        }
+    }
+
+    Log_write3(ti_sdo_ipc_GateMP_LM_enter,(UArg)obj->remoteProtect,
+            (UArg)obj->resourceId, *key);
+
+    return (GateMP_S_SUCCESS);
+}
+
+/*
+ *  ======== GateMP_rwWait ========
+ *  Called between looks at the reader/writer state, without the gate
+ *  held.  After a few looks a task sleeps for a tick, so lower priority
+ *  readers or writers on this processor get to run and count themselves
+ *  out.  Other threads can't block and just poll.
+ */
+static Void GateMP_rwWait(UInt *looks)
+{
+    if ((++(*looks) > GateMP_RWSPINS) &&
+        (BIOS_getThreadType() == BIOS_ThreadType_Task)) {
+        Task_sleep(1);
+    }
+}
+
+/*
+ *  ======== GateMP_enterRead ========
+ *  The reader count and writer flag live in the instance attrs in shared
+ *  memory and are only touched while holding the gate.  Waiters give
+ *  the gate up between looks, so the threads they wait for can get in
+ *  to count themselves out.
+ */
+Int GateMP_enterRead(GateMP_Handle handle, IArg *key)
+{
+    IArg gateKey;
+    UInt looks = 0;
+    ti_sdo_ipc_GateMP_Object *obj = (ti_sdo_ipc_GateMP_Object *)handle;
+
+    Assert_isTrue(obj != NULL, ti_sdo_ipc_Ipc_A_nullArgument);
+
+    /* gates created on the host have no attrs, read exclusively */
+    if (obj->attrs == NULL) {
+        *key = GateMP_enter(handle);
+        return (GateMP_S_SUCCESS);
+    }
+
+    gateKey = IGateProvider_enter(obj->gateHandle);
+    GateMP_invAttrs(obj);
+    while (obj->attrs->writer != 0) {
+        IGateProvider_leave(obj->gateHandle, gateKey);
+        GateMP_rwWait(&looks);
+        gateKey = IGateProvider_enter(obj->gateHandle);
+        GateMP_invAttrs(obj);
+    }
+    obj->attrs->readers++;
+    GateMP_wbInvAttrs(obj);
+    IGateProvider_leave(obj->gateHandle, gateKey);
+
+    Log_write3(ti_sdo_ipc_GateMP_LM_enter,(UArg)obj->remoteProtect,
+            (UArg)obj->resourceId, 0);
+
+    *key = 0;
+
+    return (GateMP_S_SUCCESS);
+}
+
+/*
+ *  ======== GateMP_leaveRead ========
+ */
+Void GateMP_leaveRead(GateMP_Handle handle, IArg key)
+{
+    ti_sdo_ipc_GateMP_Object *obj = (ti_sdo_ipc_GateMP_Object *)handle;
+
+    Assert_isTrue(obj != NULL, ti_sdo_ipc_Ipc_A_nullArgument);
+
+    if (obj->attrs == NULL) {
+        GateMP_leave(handle, key);
+        return;
+    }
+
+    key = IGateProvider_enter(obj->gateHandle);
+    GateMP_invAttrs(obj);
+    obj->attrs->readers--;
+    GateMP_wbInvAttrs(obj);
+    IGateProvider_leave(obj->gateHandle, key);
+
+    Log_write3(ti_sdo_ipc_GateMP_LM_leave, (UArg)obj->remoteProtect,
+        (UArg)obj->resourceId, 0);
+}
+
+/*
+ *  ======== GateMP_enterWrite ========
+ *  Waits for an earlier writer, then sets the writer flag so no new
+ *  readers get in, and waits for the readers to drain.  Returns holding
+ *  the gate.
+ */
+Int GateMP_enterWrite(GateMP_Handle handle, IArg *key)
+{
+    UInt looks = 0;
+    ti_sdo_ipc_GateMP_Object *obj = (ti_sdo_ipc_GateMP_Object *)handle;
+
+    Assert_isTrue(obj != NULL, ti_sdo_ipc_Ipc_A_nullArgument);
+
+    if (obj->attrs == NULL) {
+        *key = GateMP_enter(handle);
+        return (GateMP_S_SUCCESS);
+    }
+
+    *key = IGateProvider_enter(obj->gateHandle);
+    GateMP_invAttrs(obj);
+    while (obj->attrs->writer != 0) {
+        IGateProvider_leave(obj->gateHandle, *key);
+        GateMP_rwWait(&looks);
+        *key = IGateProvider_enter(obj->gateHandle);
+        GateMP_invAttrs(obj);
+    }
+
+    obj->attrs->writer = 1;
+    GateMP_wbInvAttrs(obj);
+
+    looks = 0;
+    while (obj->attrs->readers != 0) {
+        IGateProvider_leave(obj->gateHandle, *key);
+        GateMP_rwWait(&looks);
+        *key = IGateProvider_enter(obj->gateHandle);
+        GateMP_invAttrs(obj);
+    }
+
+    Log_write3(ti_sdo_ipc_GateMP_LM_enter,(UArg)obj->remoteProtect,
+            (UArg)obj->resourceId, *key);
+
+    return (GateMP_S_SUCCESS);
+}
+
+/*
+ *  ======== GateMP_leaveWrite ========
+ */
+Void GateMP_leaveWrite(GateMP_Handle handle, IArg key)
+{
+    ti_sdo_ipc_GateMP_Object *obj = (ti_sdo_ipc_GateMP_Object *)handle;
+
+    Assert_isTrue(obj != NULL, ti_sdo_ipc_Ipc_A_nullArgument);
+
+    if (obj->attrs == NULL) {
+        GateMP_leave(handle, key);
+        return;
+    }
+
+    obj->attrs->writer = 0;
+    GateMP_wbInvAttrs(obj);
+    IGateProvider_leave(obj->gateHandle, key);
+
+    Log_write3(ti_sdo_ipc_GateMP_LM_leave, (UArg)obj->remoteProtect,
+        (UArg)obj->resourceId, key);
+}
+
 /*
  *  ======== GateMP_open ========
  */
@@ -1120,6 +1380,8 @@ Int ti_sdo_ipc_GateMP_Instance_init(ti_sdo_ipc_GateMP_Object *obj,
             obj->attrs->mask = SETMASK(obj->remoteProtect, obj->localProtect);
             obj->attrs->creatorProcId = MultiProc_self();
             obj->attrs->status = ti_sdo_ipc_GateMP_CREATED;
+            obj->attrs->readers = 0;
+            obj->attrs->writer = 0;
             if (obj->cacheEnabled) {
                 /*
                  *  Need to write back memory if cache is enabled because cache
@@ -1335,6 +1597,8 @@ Int ti_sdo_ipc_GateMP_Instance_init(ti_sdo_ipc_GateMP_Object *obj,
         obj->attrs->mask = SETMASK(obj->remoteProtect, obj->localProtect);
         obj->attrs->creatorProcId = MultiProc_self();
         obj->attrs->status = ti_sdo_ipc_GateMP_CREATED;
+        obj->attrs->readers = 0;
+        obj->attrs->writer = 0;
 
         if (obj->cacheEnabled) {
             Cache_wbInv(obj->attrs, sizeof(ti_sdo_ipc_GateMP_Attrs),
@@ -64,6 +64,10 @@ function module$use()
     GateAll      = xdc.useModule('ti.sysbios.gates.GateAll');
     GateNull     = xdc.useModule('xdc.runtime.GateNull');
 
+    /* Reader/writer waits sleep in task context */
+    xdc.useModule('ti.sysbios.BIOS');
+    xdc.useModule('ti.sysbios.knl.Task');
+
     /* Asserts, errors, etc */
     Ipc          = xdc.useModule('ti.sdo.ipc.Ipc');
 
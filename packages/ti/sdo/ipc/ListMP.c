@@ -43,6 +43,7 @@
 #include <xdc/runtime/IHeap.h>
 
 #include <ti/sysbios/hal/Cache.h>
+#include <ti/sysbios/hal/Hwi.h>
 
 #include <ti/sdo/ipc/_Ipc.h>
 #include <ti/sdo/utils/_MultiProc.h>
@@ -63,17 +64,28 @@
     #pragma FUNC_EXT_CALLED(ListMP_openByAddr);
     #pragma FUNC_EXT_CALLED(ListMP_sharedMemReq);
     #pragma FUNC_EXT_CALLED(ListMP_empty);
+    #pragma FUNC_EXT_CALLED(ListMP_getAll);
     #pragma FUNC_EXT_CALLED(ListMP_getGate);
     #pragma FUNC_EXT_CALLED(ListMP_getHead);
+    #pragma FUNC_EXT_CALLED(ListMP_getHeadList);
     #pragma FUNC_EXT_CALLED(ListMP_getTail);
     #pragma FUNC_EXT_CALLED(ListMP_insert);
     #pragma FUNC_EXT_CALLED(ListMP_next);
     #pragma FUNC_EXT_CALLED(ListMP_prev);
     #pragma FUNC_EXT_CALLED(ListMP_putHead);
     #pragma FUNC_EXT_CALLED(ListMP_putTail);
+    #pragma FUNC_EXT_CALLED(ListMP_putTailList);
     #pragma FUNC_EXT_CALLED(ListMP_remove);
 #endif
 
+static Ptr ListMP_getHeadGated(ti_sdo_ipc_ListMP_Object *obj);
+static Int ListMP_putTailGated(ti_sdo_ipc_ListMP_Object *obj,
+        ListMP_Elem *elem);
+static Bool ListMP_spscEmpty(ti_sdo_ipc_ListMP_Object *obj);
+static Ptr ListMP_spscGetHead(ti_sdo_ipc_ListMP_Object *obj);
+static Int ListMP_spscPutTail(ti_sdo_ipc_ListMP_Object *obj,
+        ListMP_Elem *elem);
+
 /*
  *************************************************************************
  *                       Common Header Functions
@@ -103,6 +115,7 @@ Void ListMP_Params_init(ListMP_Params *params)
     params->sharedAddr = 0;
     params->name       = NULL;
     params->regionId   = 0;
+    params->spscLength = 0;
 }
 
 /*
@@ -124,6 +137,7 @@ ListMP_Handle ListMP_create(const ListMP_Params *params)
         mpParams.sharedAddr = params->sharedAddr;
         mpParams.name       = params->name;
         mpParams.regionId   = params->regionId;
+        mpParams.spscLength = params->spscLength;
 
         /* call the module create */
         obj = ti_sdo_ipc_ListMP_create(&mpParams, &eb);
@@ -265,6 +279,14 @@ SizeT ListMP_sharedMemReq(const ListMP_Params *params)
 
     memReq = _Ipc_roundup(sizeof(ti_sdo_ipc_ListMP_Attrs), minAlign);
 
+    if (params->spscLength != 0) {
+        /* producer index, consumer index and the ring */
+        memReq += 2 * _Ipc_roundup(sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                minAlign);
+        memReq += _Ipc_roundup(params->spscLength *
+                sizeof(ti_sdo_ipc_ListMP_SpscSlot), minAlign);
+    }
+
     return (memReq);
 }
 
@@ -279,6 +301,10 @@ Bool ListMP_empty(ListMP_Handle handle)
     IArg key;
     SharedRegion_SRPtr sharedHead;
 
+    if (obj->spscLength != 0) {
+        return (ListMP_spscEmpty(obj));
+    }
+
     /* prevent another thread or processor from modifying the ListMP */
     key = GateMP_enter((GateMP_Handle)obj->gate);
 
@@ -314,6 +340,77 @@ Bool ListMP_empty(ListMP_Handle handle)
     return (flag);
 }
 
+/*
+ *  ======== ListMP_getAll ========
+ */
+Ptr ListMP_getAll(ListMP_Handle handle)
+{
+    ti_sdo_ipc_ListMP_Object *obj = (ti_sdo_ipc_ListMP_Object *)handle;
+    ti_sdo_ipc_ListMP_Attrs *attrs = obj->attrs;
+    ListMP_Elem *elem;
+    SharedRegion_SRPtr sharedHead;
+    IArg key;
+
+    /* not supported by an SPSC list */
+    Assert_isTrue(obj->spscLength == 0, ti_sdo_ipc_Ipc_A_invParam);
+    if (obj->spscLength != 0) {
+        return (NULL);
+    }
+
+    /* prevent another thread or processor from modifying the ListMP */
+    key = GateMP_enter((GateMP_Handle)obj->gate);
+
+#if defined(xdc_target__isaCompatible_v7A) || defined(xdc_target__isaCompatible_v8A)
+    /* ARM speculative execution might have pulled attrs into cache */
+    if (obj->cacheEnabled) {
+        Cache_inv(attrs, sizeof(ti_sdo_ipc_ListMP_Attrs), Cache_Type_ALL, TRUE);
+    }
+#endif
+
+    if (ti_sdo_ipc_SharedRegion_translate == FALSE) {
+        elem = (ListMP_Elem *)((UArg)attrs->head.next);
+        sharedHead = (SharedRegion_SRPtr)((UArg)(&(attrs->head)));
+    }
+    else {
+        elem = SharedRegion_getPtr(attrs->head.next);
+        sharedHead = SharedRegion_getSRPtr(&(attrs->head), obj->regionId);
+    }
+
+    /* Assert that pointer is not NULL */
+    Assert_isTrue(elem != NULL, ti_sdo_ipc_Ipc_A_nullPointer);
+
+    if (elem == NULL || elem == (ListMP_Elem *)(&(attrs->head))) {
+        /* Empty, return NULL */
+        elem = NULL;
+
+        if (obj->cacheEnabled) {
+            Cache_inv(&(attrs->head), sizeof(ListMP_Elem), Cache_Type_ALL,
+                    TRUE);
+        }
+    }
+    else {
+        /*
+         *  Only the head changes.  The first element's prev and the last
+         *  element's next keep pointing at the head, which is how
+         *  ListMP_next() finds the end of the detached chain.
+         */
+        attrs->head.next = sharedHead;
+        attrs->head.prev = sharedHead;
+
+        if (obj->cacheEnabled) {
+            Cache_wbInv(&(attrs->head), sizeof(ListMP_Elem), Cache_Type_ALL,
+                    TRUE);
+        }
+        else {
+            ListMP_barrier();
+        }
+    }
+
+    GateMP_leave((GateMP_Handle)obj->gate, key);
+
+    return (elem);
+}
+
 /*
  *  ======== ListMP_getGate ========
  */
@@ -330,6 +427,20 @@ GateMP_Handle ListMP_getGate(ListMP_Handle handle)
 Ptr ListMP_getHead(ListMP_Handle handle)
 {
     ti_sdo_ipc_ListMP_Object *obj = (ti_sdo_ipc_ListMP_Object *)handle;
+
+    if (obj->spscLength != 0) {
+        return (ListMP_spscGetHead(obj));
+    }
+
+    return (ListMP_getHeadGated(obj));
+}
+
+/*
+ *  ======== ListMP_getHeadGated ========
+ *  getHead of the gated list
+ */
+static Ptr ListMP_getHeadGated(ti_sdo_ipc_ListMP_Object *obj)
+{
     ti_sdo_ipc_ListMP_Attrs *attrs = obj->attrs;
     ListMP_Elem *elem;
     ListMP_Elem *localHeadNext;
@@ -419,6 +530,101 @@ leave:
     return (elem);
 }
 
+/*
+ *  ======== ListMP_getHeadList ========
+ */
+UInt ListMP_getHeadList(ListMP_Handle handle, ListMP_Elem *elems[], UInt num)
+{
+    ti_sdo_ipc_ListMP_Object *obj = (ti_sdo_ipc_ListMP_Object *)handle;
+    ti_sdo_ipc_ListMP_Attrs *attrs = obj->attrs;
+    ListMP_Elem *localHead;
+    ListMP_Elem *localNext;
+    Bool localNextIsCached;
+    UInt count;
+    IArg key;
+
+    if (obj->spscLength != 0) {
+        /* the ring doesn't take the gate anyway */
+        for (count = 0; count < num; count++) {
+            elems[count] = ListMP_spscGetHead(obj);
+            if (elems[count] == NULL) {
+                break;
+            }
+        }
+        return (count);
+    }
+
+    localHead = (ListMP_Elem *)(&(attrs->head));
+    count = 0;
+
+    /* prevent another thread or processor from modifying the ListMP */
+    key = GateMP_enter((GateMP_Handle)obj->gate);
+
+#if defined(xdc_target__isaCompatible_v7A) || defined(xdc_target__isaCompatible_v8A)
+    /* ARM speculative execution might have pulled attrs into cache */
+    if (obj->cacheEnabled) {
+        Cache_inv(attrs, sizeof(ti_sdo_ipc_ListMP_Attrs), Cache_Type_ALL, TRUE);
+    }
+#endif
+
+    if (ti_sdo_ipc_SharedRegion_translate == FALSE) {
+        localNext = (ListMP_Elem *)((UArg)attrs->head.next);
+    }
+    else {
+        localNext = SharedRegion_getPtr(attrs->head.next);
+    }
+
+    /* Walk the first num elements, only reading them */
+    while ((count < num) && (localNext != NULL) && (localNext != localHead)) {
+        if (SharedRegion_isCacheEnabled(SharedRegion_getId(localNext))) {
+            Cache_inv(localNext, sizeof(ListMP_Elem), Cache_Type_ALL, TRUE);
+        }
+
+        elems[count++] = localNext;
+
+        if (ti_sdo_ipc_SharedRegion_translate == FALSE) {
+            localNext = (ListMP_Elem *)((UArg)localNext->next);
+        }
+        else {
+            localNext = SharedRegion_getPtr(localNext->next);
+        }
+    }
+
+    /* Assert that pointer is not NULL */
+    Assert_isTrue(localNext != NULL, ti_sdo_ipc_Ipc_A_nullPointer);
+    /* Additional check to handle case when Assert is disabled */
+    if ((localNext == NULL) || (count == 0)) {
+        GateMP_leave((GateMP_Handle)obj->gate, key);
+        return (0);
+    }
+
+    /* Cut the walked elements off: the element after them is the first */
+    attrs->head.next = elems[count - 1]->next;
+
+    localNextIsCached = (localNext != localHead) &&
+            SharedRegion_isCacheEnabled(SharedRegion_getId(localNext));
+    if (localNextIsCached) {
+        Cache_inv(localNext, sizeof(ListMP_Elem), Cache_Type_ALL, TRUE);
+    }
+
+    /* Fix the prev pointer of the new first elem on the list */
+    localNext->prev = elems[0]->prev;
+    if (localNextIsCached) {
+        Cache_wbInv(localNext, sizeof(ListMP_Elem), Cache_Type_ALL, TRUE);
+    }
+
+    if (obj->cacheEnabled) {
+        Cache_wbInv(&(attrs->head), sizeof(ListMP_Elem), Cache_Type_ALL, TRUE);
+    }
+    else {
+        ListMP_barrier();
+    }
+
+    GateMP_leave((GateMP_Handle)obj->gate, key);
+
+    return (count);
+}
+
 /*
  *  ======== ListMP_getTail ========
  */
@@ -432,6 +638,12 @@ Ptr ListMP_getTail(ListMP_Handle handle)
     Bool localPrevIsCached;
     UInt key;
 
+    /* not supported by an SPSC list */
+    Assert_isTrue(obj->spscLength == 0, ti_sdo_ipc_Ipc_A_invParam);
+    if (obj->spscLength != 0) {
+        return (NULL);
+    }
+
     /* prevent another thread or processor from modifying the ListMP */
     key = GateMP_enter((GateMP_Handle)obj->gate);
 
@@ -527,6 +739,12 @@ Int ListMP_insert(ListMP_Handle handle, ListMP_Elem *newElem,
     SharedRegion_SRPtr sharedCurElem;
     Bool curElemIsCached, localPrevElemIsCached;
 
+    /* not supported by an SPSC list */
+    Assert_isTrue(obj->spscLength == 0, ti_sdo_ipc_Ipc_A_invParam);
+    if (obj->spscLength != 0) {
+        return (ListMP_E_INVALIDSTATE);
+    }
+
     /* prevent another thread or processor from modifying the ListMP */
     key = GateMP_enter((GateMP_Handle)obj->gate);
 
@@ -605,6 +823,12 @@ Ptr ListMP_next(ListMP_Handle handle, ListMP_Elem *elem)
     ListMP_Elem *retElem;  /* returned elem */
     Bool elemIsCached;
 
+    /* not supported by an SPSC list */
+    Assert_isTrue(obj->spscLength == 0, ti_sdo_ipc_Ipc_A_invParam);
+    if (obj->spscLength != 0) {
+        return (NULL);
+    }
+
     /* elem == NULL -> start at the head */
     if (elem == NULL) {
         /* Keep track of whether an extra Cache_inv is needed */
@@ -642,6 +866,12 @@ Ptr ListMP_prev(ListMP_Handle handle, ListMP_Elem *elem)
     ListMP_Elem *retElem;  /* returned elem */
     Bool elemIsCached;
 
+    /* not supported by an SPSC list */
+    Assert_isTrue(obj->spscLength == 0, ti_sdo_ipc_Ipc_A_invParam);
+    if (obj->spscLength != 0) {
+        return (NULL);
+    }
+
     /* elem == NULL -> start at the head */
     if (elem == NULL) {
         elemIsCached = obj->cacheEnabled;
@@ -683,6 +913,12 @@ Int ListMP_putHead(ListMP_Handle handle, ListMP_Elem *elem)
     SharedRegion_SRPtr sharedHead;
     Bool localNextElemIsCached;
 
+    /* not supported by an SPSC list */
+    Assert_isTrue(obj->spscLength == 0, ti_sdo_ipc_Ipc_A_invParam);
+    if (obj->spscLength != 0) {
+        return (ListMP_E_INVALIDSTATE);
+    }
+
     /* prevent another thread or processor from modifying the ListMP */
     key = GateMP_enter((GateMP_Handle)obj->gate);
 
@@ -753,6 +989,21 @@ Int ListMP_putHead(ListMP_Handle handle, ListMP_Elem *elem)
 Int ListMP_putTail(ListMP_Handle handle, ListMP_Elem *elem)
 {
     ti_sdo_ipc_ListMP_Object *obj = (ti_sdo_ipc_ListMP_Object *)handle;
+
+    if (obj->spscLength != 0) {
+        return (ListMP_spscPutTail(obj, elem));
+    }
+
+    return (ListMP_putTailGated(obj, elem));
+}
+
+/*
+ *  ======== ListMP_putTailGated ========
+ *  putTail on the gated list
+ */
+static Int ListMP_putTailGated(ti_sdo_ipc_ListMP_Object *obj,
+        ListMP_Elem *elem)
+{
     ti_sdo_ipc_ListMP_Attrs *attrs = obj->attrs;
     UInt key;
     UInt16  id;
@@ -825,6 +1076,124 @@ Int ListMP_putTail(ListMP_Handle handle, ListMP_Elem *elem)
     return (ListMP_S_SUCCESS);
 }
 
+/*
+ *  ======== ListMP_putTailList ========
+ */
+Int ListMP_putTailList(ListMP_Handle handle, ListMP_Elem *elems[], UInt num)
+{
+    ti_sdo_ipc_ListMP_Object *obj = (ti_sdo_ipc_ListMP_Object *)handle;
+    ti_sdo_ipc_ListMP_Attrs *attrs = obj->attrs;
+    ListMP_Elem *localPrevElem;
+    SharedRegion_SRPtr sharedHead;
+    SharedRegion_SRPtr sharedPrev;
+    SharedRegion_SRPtr sharedElem;
+    SharedRegion_SRPtr sharedNext;
+    SharedRegion_SRPtr sharedFirst;
+    Bool localPrevElemIsCached;
+    Int status;
+    IArg key;
+    UInt i;
+
+    if (num == 0) {
+        return (ListMP_S_SUCCESS);
+    }
+
+    if (obj->spscLength != 0) {
+        /* the ring doesn't take the gate anyway */
+        for (i = 0; i < num; i++) {
+            status = ListMP_spscPutTail(obj, elems[i]);
+            if (status < 0) {
+                return (status);
+            }
+        }
+        return (ListMP_S_SUCCESS);
+    }
+
+    sharedHead = SharedRegion_getSRPtr(&(attrs->head), obj->regionId);
+
+    /*
+     *  The new elements belong to the caller until they are spliced in, so
+     *  link them to each other before entering the gate.  Only elems[0]->prev
+     *  depends on the list.  Don't wait for the write-backs here, the last
+     *  one below will.
+     */
+    sharedPrev  = ti_sdo_ipc_SharedRegion_INVALIDSRPTR;
+    sharedElem  = SharedRegion_getSRPtr(elems[0],
+                                        SharedRegion_getId(elems[0]));
+    sharedFirst = sharedElem;
+
+    for (i = 0; i < num; i++) {
+        if (i + 1 < num) {
+            sharedNext = SharedRegion_getSRPtr(elems[i + 1],
+                    SharedRegion_getId(elems[i + 1]));
+        }
+        else {
+            sharedNext = sharedHead;
+        }
+
+        elems[i]->next = sharedNext;
+        if (i > 0) {
+            elems[i]->prev = sharedPrev;
+
+            if (SharedRegion_isCacheEnabled(SharedRegion_getId(elems[i]))) {
+                Cache_wbInv(elems[i], sizeof(ListMP_Elem), Cache_Type_ALL,
+                        FALSE);
+            }
+        }
+
+        sharedPrev = sharedElem;
+        sharedElem = sharedNext;
+    }
+
+    /* prevent another thread or processor from modifying the ListMP */
+    key = GateMP_enter((GateMP_Handle)obj->gate);
+
+#if defined(xdc_target__isaCompatible_v7A) || defined(xdc_target__isaCompatible_v8A)
+    /* ARM speculative execution might have pulled attrs into cache */
+    if (obj->cacheEnabled) {
+        Cache_inv(attrs, sizeof(ti_sdo_ipc_ListMP_Attrs), Cache_Type_ALL, TRUE);
+    }
+#endif
+
+    localPrevElem = SharedRegion_getPtr(attrs->head.prev);
+
+    /* Cross check if localPrevElem is NULL */
+    if (localPrevElem == NULL) {
+        GateMP_leave((GateMP_Handle)obj->gate, key);
+        return ListMP_E_FAIL;
+    }
+
+    localPrevElemIsCached = SharedRegion_isCacheEnabled(
+        SharedRegion_getId(localPrevElem));
+    if (localPrevElemIsCached) {
+        Cache_inv(localPrevElem, sizeof(ListMP_Elem), Cache_Type_ALL, TRUE);
+    }
+
+    /* splice the chain in, sharedPrev is the last new element */
+    elems[0]->prev = attrs->head.prev;
+    localPrevElem->next = sharedFirst;
+    attrs->head.prev = sharedPrev;
+
+    if (localPrevElemIsCached) {
+        /* Write-back because localPrevElem->next changed */
+        Cache_wbInv(localPrevElem, sizeof(ListMP_Elem), Cache_Type_ALL, TRUE);
+    }
+    if (obj->cacheEnabled) {
+        /* Write-back because attrs->head.prev changed */
+        Cache_wbInv(&(attrs->head), sizeof(ListMP_Elem), Cache_Type_ALL, TRUE);
+    }
+    if (SharedRegion_isCacheEnabled(SharedRegion_getId(elems[0]))) {
+        /* Write-back because elems[0]->next & elems[0]->prev changed */
+        Cache_wbInv(elems[0], sizeof(ListMP_Elem), Cache_Type_ALL, TRUE);
+    }
+    else
+        ListMP_barrier();
+
+    GateMP_leave((GateMP_Handle)obj->gate, key);
+
+    return (ListMP_S_SUCCESS);
+}
+
 /*
  *  ======== ListMP_remove ========
  */
@@ -836,6 +1205,12 @@ Int ListMP_remove(ListMP_Handle handle, ListMP_Elem *elem)
     ListMP_Elem *localNextElem;
     Bool localPrevElemIsCached, localNextElemIsCached;
 
+    /* not supported by an SPSC list */
+    Assert_isTrue(obj->spscLength == 0, ti_sdo_ipc_Ipc_A_invParam);
+    if (obj->spscLength != 0) {
+        return (ListMP_E_INVALIDSTATE);
+    }
+
     /* Prevent another thread or processor from modifying the ListMP */
     key = GateMP_enter((GateMP_Handle)obj->gate);
 
@@ -882,6 +1257,374 @@ Int ListMP_remove(ListMP_Handle handle, ListMP_Elem *elem)
     return (ListMP_S_SUCCESS);
 }
 
+/*
+ *************************************************************************
+ *                       SPSC functions
+ *************************************************************************
+ */
+
+/*
+ *  The producer only writes putIndex and the ring, the consumer only writes
+ *  getIndex.  Elements that find the ring full go to the gated list and are
+ *  counted in putIndex->overflow.  Each ring slot records that count when
+ *  it is filled, so the consumer knows how many gated elements must be
+ *  taken before it and elements come out in the order they were put.
+ */
+
+/*
+ *  ======== ListMP_spscInit ========
+ *  Carve the SPSC indices and ring out of the memory after the attrs
+ */
+static Void ListMP_spscInit(ti_sdo_ipc_ListMP_Object *obj)
+{
+    SizeT minAlign;
+
+    if (obj->spscLength == 0) {
+        obj->putIndex = NULL;
+        obj->getIndex = NULL;
+        obj->ring = NULL;
+        return;
+    }
+
+    /* must match ListMP_sharedMemReq() */
+    minAlign = Memory_getMaxDefaultTypeAlign();
+    if (obj->cacheLineSize > minAlign) {
+        minAlign = obj->cacheLineSize;
+    }
+
+    obj->putIndex = (ti_sdo_ipc_ListMP_SpscIndex *)((UArg)obj->attrs +
+            _Ipc_roundup(sizeof(ti_sdo_ipc_ListMP_Attrs), minAlign));
+    obj->getIndex = (ti_sdo_ipc_ListMP_SpscIndex *)((UArg)obj->putIndex +
+            _Ipc_roundup(sizeof(ti_sdo_ipc_ListMP_SpscIndex), minAlign));
+    obj->ring = (ti_sdo_ipc_ListMP_SpscSlot *)((UArg)obj->getIndex +
+            _Ipc_roundup(sizeof(ti_sdo_ipc_ListMP_SpscIndex), minAlign));
+}
+
+/*
+ *  ======== ListMP_spscEmpty ========
+ */
+static Bool ListMP_spscEmpty(ti_sdo_ipc_ListMP_Object *obj)
+{
+    Bool flag;
+
+    if (obj->cacheEnabled) {
+        Cache_inv(obj->putIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                Cache_Type_ALL, FALSE);
+        Cache_inv(obj->getIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                Cache_Type_ALL, TRUE);
+    }
+
+    flag = (obj->putIndex->count == obj->getIndex->count) &&
+           (obj->putIndex->overflow == obj->getIndex->overflow);
+
+    return (flag);
+}
+
+/*
+ *  ======== ListMP_spscGetHead ========
+ */
+static Ptr ListMP_spscGetHead(ti_sdo_ipc_ListMP_Object *obj)
+{
+    ti_sdo_ipc_ListMP_SpscIndex *getIndex = obj->getIndex;
+    ti_sdo_ipc_ListMP_SpscSlot *slot;
+    SharedRegion_SRPtr srPtr;
+    ListMP_Elem *elem;
+    UInt32 overflow;
+    UInt32 count;
+    UInt key;
+
+    /* only serializes local threads, the producer never writes getIndex */
+    key = Hwi_disable();
+
+    if (obj->cacheEnabled) {
+        Cache_inv(obj->putIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                Cache_Type_ALL, FALSE);
+        Cache_inv(getIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                Cache_Type_ALL, TRUE);
+    }
+
+    /*
+     *  With an empty ring, gated elements are taken only if they were
+     *  there before the ring was looked at. One put after that could be
+     *  newer than ring elements put in between.
+     */
+    overflow = obj->putIndex->overflow;
+    _Ipc_memoryBarrier();
+
+    count = getIndex->count;
+    while (count != obj->putIndex->count) {
+        /* the slot must not be read before the count that published it */
+        _Ipc_memoryBarrier();
+
+        slot = &(obj->ring[count & (obj->spscLength - 1)]);
+        if (obj->cacheEnabled) {
+            Cache_inv(slot, sizeof(ti_sdo_ipc_ListMP_SpscSlot),
+                    Cache_Type_ALL, TRUE);
+        }
+
+        if (slot->overflow != getIndex->overflow) {
+            /* gated elements put before this slot come first */
+            overflow = slot->overflow;
+            break;
+        }
+
+        /*
+         *  Claim the slot before reading the element, so the producer
+         *  taking it back (_ListMP_spscRetract) either sees the claim or
+         *  leaves its mark for the read below.
+         */
+        getIndex->claim = count + 1;
+        if (obj->cacheEnabled) {
+            Cache_wbInv(getIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                    Cache_Type_ALL, TRUE);
+            Cache_inv(slot, sizeof(ti_sdo_ipc_ListMP_SpscSlot),
+                    Cache_Type_ALL, TRUE);
+        }
+        _Ipc_memoryBarrier();
+
+        srPtr = slot->elem;
+        if (srPtr == ti_sdo_ipc_SharedRegion_INVALIDSRPTR) {
+            /*
+             *  The producer is taking it back, and puts it back if it saw
+             *  the claim.  It decides with interrupts off, so this is short.
+             */
+            do {
+                if (obj->cacheEnabled) {
+                    Cache_inv(obj->putIndex,
+                            sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                            Cache_Type_ALL, TRUE);
+                }
+            } while (obj->putIndex->claim == count + 1);
+
+            _Ipc_memoryBarrier();
+            if (obj->cacheEnabled) {
+                Cache_inv(slot, sizeof(ti_sdo_ipc_ListMP_SpscSlot),
+                        Cache_Type_ALL, TRUE);
+            }
+            srPtr = slot->elem;
+        }
+
+        /* hand the slot back to the producer once it has been read */
+        _Ipc_memoryBarrier();
+        count++;
+        getIndex->count = count;
+        if (obj->cacheEnabled) {
+            Cache_wbInv(getIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                    Cache_Type_ALL, TRUE);
+        }
+        else {
+            _Ipc_memoryBarrier();
+        }
+
+        /* skip an element the producer took back */
+        if (srPtr != ti_sdo_ipc_SharedRegion_INVALIDSRPTR) {
+            Hwi_restore(key);
+
+            return (SharedRegion_getPtr(srPtr));
+        }
+    }
+
+    Hwi_restore(key);
+
+    /* only look at the gated list if something older is there */
+    if (overflow == getIndex->overflow) {
+        return (NULL);
+    }
+
+    elem = ListMP_getHeadGated(obj);
+    if (elem != NULL) {
+        key = Hwi_disable();
+        if (obj->cacheEnabled) {
+            Cache_inv(getIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                    Cache_Type_ALL, TRUE);
+        }
+        getIndex->overflow++;
+        if (obj->cacheEnabled) {
+            Cache_wbInv(getIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                    Cache_Type_ALL, TRUE);
+        }
+        Hwi_restore(key);
+    }
+
+    return (elem);
+}
+
+/*
+ *  ======== ListMP_spscPutTail ========
+ */
+static Int ListMP_spscPutTail(ti_sdo_ipc_ListMP_Object *obj,
+        ListMP_Elem *elem)
+{
+    ti_sdo_ipc_ListMP_SpscIndex *putIndex = obj->putIndex;
+    ti_sdo_ipc_ListMP_SpscSlot *slot;
+    UInt32 count;
+    Int status;
+    UInt key;
+
+    /* only serializes local threads, the consumer never writes putIndex */
+    key = Hwi_disable();
+
+    if (obj->cacheEnabled) {
+        Cache_inv(obj->getIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                Cache_Type_ALL, FALSE);
+        Cache_inv(putIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                Cache_Type_ALL, TRUE);
+    }
+
+    count = putIndex->count;
+    if (count - obj->getIndex->count < obj->spscLength) {
+        /* the consumer must be done reading the slot before it is reused */
+        _Ipc_memoryBarrier();
+
+        slot = &(obj->ring[count & (obj->spscLength - 1)]);
+        slot->elem = SharedRegion_getSRPtr(elem, SharedRegion_getId(elem));
+        slot->overflow = putIndex->overflow;
+
+        /* the slot must land before the count that publishes it */
+        if (obj->cacheEnabled) {
+            Cache_wbInv(slot, sizeof(ti_sdo_ipc_ListMP_SpscSlot),
+                    Cache_Type_ALL, TRUE);
+        }
+        _Ipc_memoryBarrier();
+
+        putIndex->count = count + 1;
+        if (obj->cacheEnabled) {
+            Cache_wbInv(putIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                    Cache_Type_ALL, TRUE);
+        }
+        else {
+            _Ipc_memoryBarrier();
+        }
+
+        Hwi_restore(key);
+
+        return (ListMP_S_SUCCESS);
+    }
+
+    /* GateMP may block, so it can't be entered with interrupts disabled */
+    Hwi_restore(key);
+
+    /* ring is full */
+    status = ListMP_putTailGated(obj, elem);
+    if (status >= 0) {
+        key = Hwi_disable();
+        if (obj->cacheEnabled) {
+            Cache_inv(putIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                    Cache_Type_ALL, TRUE);
+        }
+        putIndex->overflow++;
+        if (obj->cacheEnabled) {
+            Cache_wbInv(putIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                    Cache_Type_ALL, TRUE);
+        }
+        Hwi_restore(key);
+    }
+
+    return (status);
+}
+
+/*
+ *  ======== _ListMP_spscRetract ========
+ *  Take back an element the producer put in the ring, if the consumer has
+ *  not started reading it.
+ *
+ *  The producer marks the slot with INVALIDSRPTR, then looks for the
+ *  consumer's claim; the consumer claims, then reads the slot.  With a
+ *  barrier between the two steps on both sides at least one of them sees
+ *  the other.  If the producer sees the claim it puts the element back,
+ *  and a consumer that found the mark waits for that decision.
+ *
+ *  Elements that went to the gated list can't be taken back, since the
+ *  ring slots after them count them.
+ */
+Bool _ListMP_spscRetract(ListMP_Handle handle, ListMP_Elem *elem)
+{
+    ti_sdo_ipc_ListMP_Object *obj = (ti_sdo_ipc_ListMP_Object *)handle;
+    ti_sdo_ipc_ListMP_SpscIndex *putIndex = obj->putIndex;
+    ti_sdo_ipc_ListMP_SpscSlot *slot = NULL;
+    SharedRegion_SRPtr srPtr;
+    UInt32 getCount;
+    UInt32 count;
+    Bool claimed;
+    UInt key;
+
+    if (obj->spscLength == 0) {
+        return (FALSE);
+    }
+
+    srPtr = SharedRegion_getSRPtr(elem, SharedRegion_getId(elem));
+
+    /* keeps local puts and retracts apart, the decision is short */
+    key = Hwi_disable();
+
+    if (obj->cacheEnabled) {
+        Cache_inv(obj->getIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                Cache_Type_ALL, FALSE);
+        Cache_inv(putIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                Cache_Type_ALL, TRUE);
+    }
+
+    /* look for it among the slots the consumer has not handed back */
+    getCount = obj->getIndex->count;
+    for (count = putIndex->count; count != getCount; count--) {
+        slot = &(obj->ring[(count - 1) & (obj->spscLength - 1)]);
+        if (obj->cacheEnabled) {
+            Cache_inv(slot, sizeof(ti_sdo_ipc_ListMP_SpscSlot),
+                    Cache_Type_ALL, TRUE);
+        }
+        if (slot->elem == srPtr) {
+            break;
+        }
+    }
+
+    if (count == getCount) {
+        Hwi_restore(key);
+        return (FALSE);
+    }
+
+    /* tell a consumer that finds the mark to wait */
+    putIndex->claim = count;
+    if (obj->cacheEnabled) {
+        Cache_wbInv(putIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                Cache_Type_ALL, TRUE);
+    }
+    _Ipc_memoryBarrier();
+
+    slot->elem = ti_sdo_ipc_SharedRegion_INVALIDSRPTR;
+    if (obj->cacheEnabled) {
+        Cache_wbInv(slot, sizeof(ti_sdo_ipc_ListMP_SpscSlot),
+                Cache_Type_ALL, TRUE);
+        Cache_inv(obj->getIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                Cache_Type_ALL, TRUE);
+    }
+    _Ipc_memoryBarrier();
+
+    /* 'count' is one past the slot, like the consumer's claim */
+    claimed = ((Int32)(obj->getIndex->claim - count) >= 0);
+    if (claimed) {
+        slot->elem = srPtr;
+        if (obj->cacheEnabled) {
+            Cache_wbInv(slot, sizeof(ti_sdo_ipc_ListMP_SpscSlot),
+                    Cache_Type_ALL, TRUE);
+        }
+        _Ipc_memoryBarrier();
+    }
+
+    /* ends the consumer's wait, far from any slot it could be reading */
+    putIndex->claim = count + 0x80000000;
+    if (obj->cacheEnabled) {
+        Cache_wbInv(putIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                Cache_Type_ALL, TRUE);
+    }
+    else {
+        _Ipc_memoryBarrier();
+    }
+
+    Hwi_restore(key);
+
+    return (!claimed);
+}
+
 /*
  *************************************************************************
  *                       Instance functions
@@ -931,9 +1674,21 @@ Int ti_sdo_ipc_ListMP_Instance_init(ti_sdo_ipc_ListMP_Object *obj,
             return (1);
         }
 
+        obj->spscLength = obj->attrs->spscLength;
+        ListMP_spscInit(obj);
+
         return (0);
     }
 
+    /* the ring is indexed with a mask */
+    Assert_isTrue((params->spscLength & (params->spscLength - 1)) == 0,
+                  ti_sdo_ipc_Ipc_A_invParam);
+    if ((params->spscLength & (params->spscLength - 1)) != 0) {
+        Error_raise(eb, ti_sdo_ipc_Ipc_E_internal, 0, 0);
+        return (5);
+    }
+    obj->spscLength = params->spscLength;
+
     /* init the gate */
     if (params->gate != NULL) {
         obj->gate = params->gate;
@@ -952,6 +1707,7 @@ Int ti_sdo_ipc_ListMP_Instance_init(ti_sdo_ipc_ListMP_Object *obj,
         /* Need to allocate from the heap */
         ListMP_Params_init(&sparams);
         sparams.regionId = params->regionId;
+        sparams.spscLength = params->spscLength;
         obj->allocSize = ListMP_sharedMemReq(&sparams);
 
         regionHeap = SharedRegion_getHeap(obj->regionId);
@@ -990,6 +1746,21 @@ Int ti_sdo_ipc_ListMP_Instance_init(ti_sdo_ipc_ListMP_Object *obj,
     /* store the GateMP sharedAddr in the Attrs */
     obj->attrs->gateMPAddr = ti_sdo_ipc_GateMP_getSharedAddr(obj->gate);
 
+    /* both sides of the ring start at 0 */
+    obj->attrs->spscLength = obj->spscLength;
+    ListMP_spscInit(obj);
+    if (obj->spscLength != 0) {
+        obj->putIndex->count = obj->putIndex->overflow = 0;
+        obj->getIndex->count = obj->getIndex->overflow = 0;
+        obj->putIndex->claim = obj->getIndex->claim = 0;
+        if (obj->cacheEnabled) {
+            Cache_wbInv(obj->putIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                    Cache_Type_ALL, FALSE);
+            Cache_wbInv(obj->getIndex, sizeof(ti_sdo_ipc_ListMP_SpscIndex),
+                    Cache_Type_ALL, FALSE);
+        }
+    }
+
     /* last thing, set the status */
     obj->attrs->status = ti_sdo_ipc_ListMP_CREATED;
 
@@ -41,6 +41,7 @@ var ListMP       = null;
 var SharedRegion = null;
 var MultiProc    = null;
 var NameServer   = null;
+var Hwi          = null;
 var instCount = 0;      /* use to determine if processing last instance */
 
 /*
@@ -55,6 +56,7 @@ function module$use()
     MultiProc    = xdc.useModule("ti.sdo.utils.MultiProc");
     NameServer   = xdc.useModule("ti.sdo.utils.NameServer");
     Cache        = xdc.useModule("ti.sysbios.hal.Cache");
+    Hwi          = xdc.useModule("ti.sysbios.hal.Hwi");
 
     ListMP.common$.fxntab = false;
 }
@@ -76,10 +76,18 @@ typedef struct {
     MessageQ_QueueIndex queueIndex;
 } MessageQ_Params_Version2;
 
+typedef struct {
+    Int __version;
+    Void *synchronizer;
+    MessageQ_QueueIndex queueIndex;
+    Bool syncRegister;
+} MessageQ_Params_Version3;
+
 #ifdef __ti__
     #pragma FUNC_EXT_CALLED(MessageQ_Params_init);
     #pragma FUNC_EXT_CALLED(MessageQ_Params2_init);
     #pragma FUNC_EXT_CALLED(MessageQ_alloc);
+    #pragma FUNC_EXT_CALLED(MessageQ_allocN);
     #pragma FUNC_EXT_CALLED(MessageQ_close);
     #pragma FUNC_EXT_CALLED(MessageQ_count);
     #pragma FUNC_EXT_CALLED(MessageQ_create);
@@ -146,6 +154,7 @@ Void MessageQ_Params_init(MessageQ_Params *params)
 Void MessageQ_Params_init__S(MessageQ_Params *params, Int version)
 {
     MessageQ_Params_Version2 *params2;
+    MessageQ_Params_Version3 *params3;
 
     switch (version) {
 
@@ -156,6 +165,14 @@ Void MessageQ_Params_init__S(MessageQ_Params *params, Int version)
             params2->queueIndex = MessageQ_ANY;
             break;
 
+        case MessageQ_Params_VERSION_3:
+            params3 = (MessageQ_Params_Version3 *)params;
+            params3->__version = MessageQ_Params_VERSION_3;
+            params3->synchronizer = NULL;
+            params3->queueIndex = MessageQ_ANY;
+            params3->syncRegister = FALSE;
+            break;
+
         default:
             Assert_isTrue(FALSE, 0);
             break;
@@ -211,6 +228,65 @@ MessageQ_Msg MessageQ_alloc(UInt16 heapId, UInt32 size)
     return (msg);
 }
 
+/*
+ *  ======== MessageQ_allocN ========
+ *  Allocate num messages, all or none.  A heap with a batch interface
+ *  (see MessageQ.allocNFxn) hands them out in a single critical section,
+ *  other heaps one at a time.
+ */
+Int MessageQ_allocN(UInt16 heapId, UInt32 size, MessageQ_Msg msgs[],
+        UInt num)
+{
+    IHeap_Handle heap;
+    Error_Block eb;
+    Int status = 1;
+    UInt i;
+
+    Assert_isTrue((heapId < MessageQ_module->numHeaps),
+                  ti_sdo_ipc_MessageQ_A_heapIdInvalid);
+
+    Assert_isTrue((MessageQ_module->heaps[heapId] != NULL),
+                  ti_sdo_ipc_MessageQ_A_heapIdInvalid);
+
+    heap = MessageQ_module->heaps[heapId];
+
+    if (ti_sdo_ipc_MessageQ_allocNFxn != NULL) {
+        status = ti_sdo_ipc_MessageQ_allocNFxn(heap, size, (Ptr *)msgs, num);
+        if (status < 0) {
+            return (MessageQ_E_MEMORY);
+        }
+    }
+
+    if (status > 0) {
+        /* Allocate the messages. No alignment requested */
+        Error_init(&eb);
+        for (i = 0; i < num; i++) {
+            msgs[i] = Memory_alloc(heap, size, 0, &eb);
+            if (msgs[i] == NULL) {
+                while (i > 0) {
+                    i--;
+                    Memory_free(heap, msgs[i], size);
+                }
+                return (MessageQ_E_MEMORY);
+            }
+        }
+    }
+
+    /* Fill in the fields of the messages */
+    for (i = 0; i < num; i++) {
+        MessageQ_msgInit(msgs[i]);
+        msgs[i]->msgSize = size;
+        msgs[i]->heapId  = heapId;
+
+        if (ti_sdo_ipc_MessageQ_traceFlag == TRUE) {
+            Log_write3(ti_sdo_ipc_MessageQ_LM_alloc, (UArg)(msgs[i]),
+                (UArg)(msgs[i]->seqNum), (UArg)(msgs[i]->srcProc));
+        }
+    }
+
+    return (MessageQ_S_SUCCESS);
+}
+
 /*
  *  ======== MessageQ_count ========
  */
@@ -280,6 +356,11 @@ MessageQ_Handle MessageQ_create(String name, const MessageQ_Params *pp)
             ps.synchronizer = ((MessageQ_Params_Version2 *)pp)->synchronizer;
             ps.queueIndex = ((MessageQ_Params_Version2 *)pp)->queueIndex;
         }
+        /* names are always registered synchronously, ignore syncRegister */
+        else if (pp->__version == MessageQ_Params_VERSION_3) {
+            ps.synchronizer = ((MessageQ_Params_Version3 *)pp)->synchronizer;
+            ps.queueIndex = ((MessageQ_Params_Version3 *)pp)->queueIndex;
+        }
         else {
             Assert_isTrue(FALSE, 0);
         }
@@ -378,6 +459,28 @@ Int MessageQ_free(MessageQ_Msg msg)
     return (MessageQ_S_SUCCESS);
 }
 
+/*
+ *  ======== _MessageQ_freeMayBlock ========
+ *  Whether freeing 'msg' can block, so transports know if they may free a
+ *  msg in a Hwi or Swi.  The free hook is not considered.
+ */
+Bool _MessageQ_freeMayBlock(MessageQ_Msg msg)
+{
+    IHeap_Handle heap;
+
+    if ((msg->heapId == ti_sdo_ipc_MessageQ_STATICMSG) ||
+        (msg->heapId >= MessageQ_module->numHeaps)) {
+        return (TRUE);
+    }
+
+    heap = MessageQ_module->heaps[msg->heapId];
+    if (heap == NULL) {
+        return (TRUE);
+    }
+
+    return (Memory_query(heap, Memory_Q_BLOCKING));
+}
+
 /*
  *  ======== MessageQ_get ========
  */
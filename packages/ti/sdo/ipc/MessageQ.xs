@@ -85,6 +85,22 @@ function module$use()
     }
 }
 
+/*
+ *  ======== module$close ========
+ */
+function module$close()
+{
+    /*
+     *  MessageQ_allocN() takes batches from HeapBufMP heaps, if the
+     *  application uses HeapBufMP.  Don't pull it in otherwise.  Every
+     *  module$use has run by now.
+     */
+    if (('ti.sdo.ipc.heaps.HeapBufMP' in xdc.om) &&
+            xdc.module('ti.sdo.ipc.heaps.HeapBufMP').$used) {
+        MessageQ.allocNFxn = '&_HeapBufMP_allocN';
+    }
+}
+
 /*
  *  ======== module$static$init ========
  *  Initialize module values.
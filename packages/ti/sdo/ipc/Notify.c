@@ -34,6 +34,7 @@
  */
 
 #include <xdc/std.h>
+#include <string.h>
 
 #include <xdc/runtime/Assert.h>
 #include <xdc/runtime/Gate.h>
@@ -43,9 +44,9 @@
 
 #include <ti/sdo/ipc/interfaces/INotifyDriver.h>
 
+#include <ti/sdo/ipc/_Ipc.h>
 #include <ti/sdo/ipc/_Notify.h>
 #include <ti/sdo/utils/_MultiProc.h>
-#include <ti/sdo/utils/List.h>
 
 #include <ti/sysbios/hal/Hwi.h>
 
@@ -59,6 +60,14 @@
 #define CLEAR_BIT(num,pos)          ((num) &= ~(1u << (pos)))
 #define TEST_BIT(num,pos)           ((num) & (1u << (pos)))
 
+/* Size of a ListenerArray holding 'num' callbacks */
+#define LISTENERSIZE(num) (sizeof(ti_sdo_ipc_Notify_ListenerArray) + \
+        ((num) * sizeof(ti_sdo_ipc_Notify_EventCallback)))
+
+static ti_sdo_ipc_Notify_ListenerArray *Notify_allocListeners(UInt num);
+static Void Notify_retireListeners(ti_sdo_ipc_Notify_Object *obj,
+        ti_sdo_ipc_Notify_ListenerArray *listeners);
+
 #ifdef __ti__
     #pragma FUNC_EXT_CALLED(Notify_attach);
     #pragma FUNC_EXT_CALLED(Notify_disable);
@@ -321,10 +330,9 @@ Int Notify_registerEvent(UInt16                 procId,
     Int                  status;
     ti_sdo_ipc_Notify_Object        *obj;
     UInt                 modKey;
-    List_Handle          eventList;
-    ti_sdo_ipc_Notify_EventListener *listener;
-    Bool                 listWasEmpty;
-    Error_Block          eb;
+    ti_sdo_ipc_Notify_ListenerArray *oldListeners;
+    ti_sdo_ipc_Notify_ListenerArray *newListeners;
+    UInt                 num;
 
     Assert_isTrue(procId < ti_sdo_utils_MultiProc_numProcessors &&
             lineId < ti_sdo_ipc_Notify_numLines, ti_sdo_ipc_Notify_A_invArgument);
@@ -332,8 +340,6 @@ Int Notify_registerEvent(UInt16                 procId,
             ti_sdo_ipc_Notify_A_invArgument);
     Assert_isTrue(ISRESERVED(eventId), ti_sdo_ipc_Notify_A_reservedEvent);
 
-    Error_init(&eb);
-
     modKey = Gate_enterModule();
 
     obj = (ti_sdo_ipc_Notify_Object *)
@@ -341,39 +347,35 @@ Int Notify_registerEvent(UInt16                 procId,
 
     Assert_isTrue(obj != NULL, ti_sdo_ipc_Notify_A_notRegistered);
 
-    /* Allocate a new EventListener */
-    listener = Memory_alloc(ti_sdo_ipc_Notify_Object_heap(),
-            sizeof(ti_sdo_ipc_Notify_EventListener), 0, &eb);
-    if (listener == NULL) {
+    oldListeners = obj->listeners[strippedEventId];
+    num = (oldListeners == NULL) ? 0 : oldListeners->num;
+
+    /* Copy the listeners into a new array with room for one more */
+    newListeners = Notify_allocListeners(num + 1);
+    if (newListeners == NULL) {
         /* Listener memory allocation failed.  Leave module gate & return */
         Gate_leaveModule(modKey);
 
         return (Notify_E_MEMORY);
     }
 
-    listener->callback.fnNotifyCbck = (Fxn)fnNotifyCbck;
-    listener->callback.cbckArg = cbckArg;
-
-    eventList = List_Object_get(obj->eventList, strippedEventId);
-    if (eventList == NULL) {
-        Gate_leaveModule(modKey);
-
-        return (Notify_E_RESOURCE);
+    if (num > 0) {
+        memcpy(newListeners->callbacks, oldListeners->callbacks,
+                num * sizeof(ti_sdo_ipc_Notify_EventCallback));
     }
+    newListeners->callbacks[num].fnNotifyCbck = (Fxn)fnNotifyCbck;
+    newListeners->callbacks[num].cbckArg = cbckArg;
 
     /*
-     *  Store whether the list was empty so we know whether to register the
-     *  callback
+     *  Publish the new array.  A single pointer store, so execMany sees
+     *  either the old or the new array and never needs the system gate.
+     *  The array must be filled before the store, execMany can run in an
+     *  interrupt right after it.
      */
-    listWasEmpty = List_empty(eventList);
+    _Ipc_compilerBarrier();
+    obj->listeners[strippedEventId] = newListeners;
 
-    /*
-     *  Need to atomically add to the list using the system gate because
-     *  Notify_exec might preempt List_remove.  List_put is atomic.
-     */
-    List_put(eventList, (List_Elem *)listener);
-
-    if (listWasEmpty) {
+    if (oldListeners == NULL) {
         /*
          *  Registering this event for the first time.  Need to register the
          *  callback function.
@@ -385,6 +387,9 @@ Int Notify_registerEvent(UInt16                 procId,
         Assert_isTrue(status == Notify_S_SUCCESS,
                 ti_sdo_ipc_Notify_A_internal);
     }
+    else {
+        Notify_retireListeners(obj, oldListeners);
+    }
 
     status = Notify_S_SUCCESS;
 
@@ -629,11 +634,11 @@ Int Notify_unregisterEvent(UInt16                 procId,
     UInt32  strippedEventId = (eventId & 0xFFFF);
     UInt16  clusterId = ti_sdo_utils_MultiProc_getClusterId(procId);
     Int     status;
-    UInt    sysKey, modKey;
+    UInt    modKey;
     ti_sdo_ipc_Notify_Object *obj;
-    List_Handle eventList;
-    ti_sdo_ipc_Notify_EventListener *listener;
-    UInt    count = 0;
+    ti_sdo_ipc_Notify_ListenerArray *oldListeners;
+    ti_sdo_ipc_Notify_ListenerArray *newListeners;
+    UInt    i;
 
     Assert_isTrue(procId < ti_sdo_utils_MultiProc_numProcessors && lineId <
             ti_sdo_ipc_Notify_numLines, ti_sdo_ipc_Notify_A_invArgument);
@@ -648,64 +653,59 @@ Int Notify_unregisterEvent(UInt16                 procId,
 
     Assert_isTrue(obj != NULL, ti_sdo_ipc_Notify_A_notRegistered);
 
-    eventList = List_Object_get(obj->eventList, strippedEventId);
-
-    if ( eventList == NULL) {
-        return (Notify_E_NOTFOUND);
-    }
+    oldListeners = obj->listeners[strippedEventId];
+    if (oldListeners == NULL) {
+        Gate_leaveModule(modKey);
 
-    if (List_empty(eventList)) {
         return (Notify_E_NOTFOUND);
     }
 
-    /* Get the first listener on the list */
-    listener = (ti_sdo_ipc_Notify_EventListener *)List_next(eventList, NULL);
-
-    while (listener != NULL) {
-        count++;
-        if (listener->callback.fnNotifyCbck == (Fxn)fnNotifyCbck &&
-                listener->callback.cbckArg == cbckArg ) {
+    for (i = 0; i < oldListeners->num; i++) {
+        if (oldListeners->callbacks[i].fnNotifyCbck == (Fxn)fnNotifyCbck &&
+                oldListeners->callbacks[i].cbckArg == cbckArg) {
             break;      /* found a match! */
         }
-        listener = (ti_sdo_ipc_Notify_EventListener *)
-            List_next(eventList, (List_Elem *)listener);
     }
 
-    if (listener == NULL) {
+    if (i == oldListeners->num) {
         /* Event listener not found */
         status = Notify_E_NOTFOUND;
     }
-    else {
-        if (count == 1 && List_next(eventList, (List_Elem *)listener) == NULL) {
-            /*
-             *  If only one element counted so far and the List_next returns
-             *  NULL, the list will be empty after unregistering.  Therefore,
-             *  unregister the callback function.
-             */
-            status = Notify_unregisterEventSingle(procId, lineId, eventId);
-            /* unregisterEvent should always suceed */
-            Assert_isTrue(status == Notify_S_SUCCESS,
-                    ti_sdo_ipc_Notify_A_internal);
+    else if (oldListeners->num == 1) {
+        /*
+         *  The last listener is going away, so unregister the callback
+         *  function.  execMany isn't called for the event after this.
+         */
+        status = Notify_unregisterEventSingle(procId, lineId, eventId);
+        /* unregisterEvent should always suceed */
+        Assert_isTrue(status == Notify_S_SUCCESS,
+                ti_sdo_ipc_Notify_A_internal);
 
-            /*  No need to protect the list removal: the event's unregistered */
-            List_remove(eventList, (List_Elem *)listener);
+        obj->listeners[strippedEventId] = NULL;
+        Notify_retireListeners(obj, oldListeners);
+
+        status = Notify_S_SUCCESS;
+    }
+    else {
+        /* Copy the other listeners into a new array and publish it */
+        newListeners = Notify_allocListeners(oldListeners->num - 1);
+        if (newListeners == NULL) {
+            status = Notify_E_MEMORY;
         }
         else {
-            /*
-             *  Need to atomically remove from the list using the system gate
-             *  because Notify_exec might preempt List_remove (the event is
-             *  still registered)
-             */
-            sysKey = Hwi_disable();
-            List_remove(eventList, (List_Elem *)listener);
-            Hwi_restore(sysKey);
-        }
+            memcpy(newListeners->callbacks, oldListeners->callbacks,
+                    i * sizeof(ti_sdo_ipc_Notify_EventCallback));
+            memcpy(&newListeners->callbacks[i], &oldListeners->callbacks[i + 1],
+                    (oldListeners->num - i - 1) *
+                    sizeof(ti_sdo_ipc_Notify_EventCallback));
 
-        /* Free the memory alloc'ed for the event listener */
-        Memory_free(ti_sdo_ipc_Notify_Object_heap(), listener,
-            sizeof(ti_sdo_ipc_Notify_EventListener));
+            /* filled before it is published, see Notify_registerEvent */
+            _Ipc_compilerBarrier();
+            obj->listeners[strippedEventId] = newListeners;
+            Notify_retireListeners(obj, oldListeners);
 
-        status = Notify_S_SUCCESS;
+            status = Notify_S_SUCCESS;
+        }
     }
 
     Gate_leaveModule(modKey);
@@ -760,9 +760,7 @@ Int ti_sdo_ipc_Notify_Instance_init(
         const ti_sdo_ipc_Notify_Params *params,
         Error_Block *eb)
 {
-    UInt        i;
     UInt16      clusterId = ti_sdo_utils_MultiProc_getClusterId(remoteProcId);
-    List_Handle eventList;
 
     Assert_isTrue(remoteProcId < ti_sdo_utils_MultiProc_numProcessors &&
                   lineId < ti_sdo_ipc_Notify_numLines, ti_sdo_ipc_Notify_A_invArgument);
@@ -781,18 +779,16 @@ Int ti_sdo_ipc_Notify_Instance_init(
         return (2);
     }
 
-    obj->eventList = Memory_alloc(ti_sdo_ipc_Notify_Object_heap(),
-        sizeof(List_Struct) * ti_sdo_ipc_Notify_numEvents, 0, eb);
-    if (obj->eventList == NULL) {
+    /* No event has listeners yet */
+    obj->listeners = Memory_calloc(ti_sdo_ipc_Notify_Object_heap(),
+        sizeof(ti_sdo_ipc_Notify_ListenerArray *) * ti_sdo_ipc_Notify_numEvents,
+        0, eb);
+    if (obj->listeners == NULL) {
         return (1);
     }
 
-    for (i = 0; i < ti_sdo_ipc_Notify_numEvents; i++) {
-        eventList = List_Object_get(obj->eventList, i);
-
-        /* Pass in NULL for eb since construct should never fail */
-        List_construct(List_struct(eventList), NULL);
-    }
+    obj->retired = NULL;
+    obj->dispatching = 0;
 
     /* Used solely for remote driver (NULL if remoteProcId == self) */
     obj->driverHandle = driverHandle;
@@ -821,14 +817,19 @@ Void ti_sdo_ipc_Notify_Instance_finalize(ti_sdo_ipc_Notify_Object *obj,
             /* Unregister the notify instance from the Notify module */
             Notify_module->notifyHandles[clusterId][obj->lineId] = NULL;
 
-            /* Destruct the event lists */
+            /* Free the listener arrays, nothing is dispatching anymore */
             for (i = 0; i < ti_sdo_ipc_Notify_numEvents; i++) {
-                List_destruct(List_struct(List_Object_get(obj->eventList, i)));
+                if (obj->listeners[i] != NULL) {
+                    Memory_free(ti_sdo_ipc_Notify_Object_heap(),
+                            obj->listeners[i],
+                            LISTENERSIZE(obj->listeners[i]->num));
+                }
             }
+            Notify_retireListeners(obj, NULL);
 
-            /* Free memory used for the List.Objects */
-            Memory_free(ti_sdo_ipc_Notify_Object_heap(), obj->eventList,
-                    sizeof(List_Struct) * ti_sdo_ipc_Notify_numEvents);
+            Memory_free(ti_sdo_ipc_Notify_Object_heap(), obj->listeners,
+                    sizeof(ti_sdo_ipc_Notify_ListenerArray *) *
+                    ti_sdo_ipc_Notify_numEvents);
 
             /* OK to fall through */
 
@@ -906,28 +907,90 @@ Void ti_sdo_ipc_Notify_execMany(UInt16 procId, UInt16 lineId, UInt32 eventId,
         UArg arg, UInt32 payload)
 {
     ti_sdo_ipc_Notify_Object *obj = (ti_sdo_ipc_Notify_Object *)arg;
-    List_Handle eventList;
-    ti_sdo_ipc_Notify_EventListener *listener;
+    ti_sdo_ipc_Notify_ListenerArray *listeners;
+    ti_sdo_ipc_Notify_EventCallback *callback;
+    UInt i;
+
+    /* Keeps registerEvent/unregisterEvent from freeing our array */
+    obj->dispatching++;
 
     /* Both loopback and the the event itself are enabled */
-    eventList = List_Object_get(obj->eventList, eventId);
+    listeners = obj->listeners[eventId];
+
+    if (listeners != NULL) {
+        callback = listeners->callbacks;
+        for (i = listeners->num; i > 0; i--, callback++) {
+            /* Execute the callback function */
+            callback->fnNotifyCbck(procId, lineId, eventId,
+                callback->cbckArg, payload);
+        }
+    }
+
+    obj->dispatching--;
+}
+
+/*
+ *  ======== Notify_allocListeners ========
+ *  Allocate a ListenerArray for 'num' callbacks.  Returns NULL if there
+ *  is no memory.
+ */
+static ti_sdo_ipc_Notify_ListenerArray *Notify_allocListeners(UInt num)
+{
+    ti_sdo_ipc_Notify_ListenerArray *listeners;
+    Error_Block eb;
+
+    Error_init(&eb);
+
+    listeners = Memory_alloc(ti_sdo_ipc_Notify_Object_heap(),
+            LISTENERSIZE(num), 0, &eb);
+    if (listeners != NULL) {
+        listeners->next = NULL;
+        listeners->num = num;
+        listeners->callbacks = (ti_sdo_ipc_Notify_EventCallback *)
+            (listeners + 1);
+    }
+
+    return (listeners);
+}
 
-    /* Check eventList Non Null */
-    Assert_isTrue(eventList != NULL, ti_sdo_ipc_Notify_A_internal);
-    /* Additional check to handle case when Assert is disabled */
-    if(eventList == NULL) {
+/*
+ *  ======== Notify_retireListeners ========
+ *  Called in the module gate after an array has been replaced.  The
+ *  replaced array is freed once no execMany that could still be walking
+ *  it is running, which is only possible when registerEvent or
+ *  unregisterEvent is called from a callback.  Passing NULL just frees
+ *  what can be freed.
+ */
+static Void Notify_retireListeners(ti_sdo_ipc_Notify_Object *obj,
+        ti_sdo_ipc_Notify_ListenerArray *listeners)
+{
+    ti_sdo_ipc_Notify_ListenerArray *next;
+    UInt hwiKey;
+
+    hwiKey = Hwi_disable();
+
+    if (listeners != NULL) {
+        listeners->next = obj->retired;
+        obj->retired = listeners;
+    }
+
+    /* execMany preempted by us holds the arrays it is walking */
+    if (obj->dispatching != 0) {
+        Hwi_restore(hwiKey);
         return;
     }
 
-    /* Use "NULL" to get the first EventListener on the list */
-    listener = (ti_sdo_ipc_Notify_EventListener *)List_next(eventList, NULL);
-    while (listener != NULL) {
-        /* Execute the callback function */
-        listener->callback.fnNotifyCbck(procId, lineId,
-            eventId, listener->callback.cbckArg, payload);
+    listeners = obj->retired;
+    obj->retired = NULL;
+
+    Hwi_restore(hwiKey);
 
-        listener = (ti_sdo_ipc_Notify_EventListener *)List_next(eventList,
-             (List_Elem *)listener);
+    /* execMany started after this only sees the published arrays */
+    while (listeners != NULL) {
+        next = listeners->next;
+        Memory_free(ti_sdo_ipc_Notify_Object_heap(), listeners,
+                LISTENERSIZE(listeners->num));
+        listeners = next;
     }
 }
 
@@ -37,7 +37,6 @@ var Notify      = null;
 var MultiProc   = null;
 var Memory      = null;
 var Ipc         = null;
-var List        = null;
 var Settings    = null;
 
 /*
@@ -48,7 +47,6 @@ function module$use()
     Notify      = this;
     Memory      = xdc.useModule('xdc.runtime.Memory');
     MultiProc   = xdc.useModule('ti.sdo.utils.MultiProc');
-    List        = xdc.useModule('ti.sdo.utils.List');
     Settings    = xdc.useModule('ti.sdo.ipc.family.Settings');
 
     /* Check for valid numEvents */
@@ -155,7 +153,7 @@ function viewInitBasic(view, obj)
 function viewInitData(view, obj)
 {
     var Notify  = xdc.useModule('ti.sdo.ipc.Notify');
-    var List    = xdc.useModule('ti.sdo.utils.List');
+    var ScalarStructs = xdc.useModule('xdc.rov.support.ScalarStructs');
     var modCfg = Program.getModuleConfig('ti.sdo.ipc.Notify');
 
     /* Display the instance label in the tree */
@@ -173,14 +171,14 @@ function viewInitData(view, obj)
         return;
     }
 
-    /* Fetch the eventList */
+    /* Fetch the per-event listener array pointers */
     try {
-        var eventList = Program.fetchArray(obj.eventList$fetchDesc,
-                                           obj.eventList,
+        var listeners = Program.fetchArray(ScalarStructs.S_Ptr$fetchDesc,
+                                           obj.listeners,
                                            modCfg.numEvents);
     }
     catch(e) {
-        Program.displayError(view, "eventId", "Problem retrieving eventList " +
+        Program.displayError(view, "eventId", "Problem retrieving listeners " +
                              " from instance state.");
         return;
     }
@@ -197,34 +195,25 @@ function viewInitData(view, obj)
         if (fxnName == "ti_sdo_ipc_Notify_execMany__I") {
             /* Multiple callbacks registered.  View all of them */
             try {
-                listView = Program.scanObjectView('ti.sdo.utils.List',
-                                                   eventList[eventId],
-                                                  'Basic');
-                }
+                var hdr = Program.fetchStruct(Notify.ListenerArray$fetchDesc,
+                                              Number(listeners[eventId].elem));
+                var listenerCallbacks = Program.fetchArray(
+                        Notify.EventCallback$fetchDesc, hdr.callbacks,
+                        hdr.num);
+            }
             catch (e) {
-                Program.displayError(view, "eventId", "Problem scanning ROV " +
-                    " for embedded event list object");
+                Program.displayError(view, "eventId", "Problem " +
+                    "retrieving event listeners");
                 return;
             }
-            for each (var listElemPtr in listView.elems) {
-                try {
-                    var eventListener = Program.fetchStruct(
-                            Notify.EventListener$fetchDesc,
-                            $addr(listElemPtr));
-                }
-                catch(e) {
-                    Program.displayError(view, "eventId", "Problem " +
-                        "retrieving event listener ");
-                    return;
-                }
-
+            for (var i = 0; i < hdr.num; i++) {
                 var elem = Program.newViewStruct('ti.sdo.ipc.Notify',
                                                  'EventListeners');
                 elem.eventId = eventId;
                 elem.fnNotifyCbck = Program.lookupFuncName(
-                    Number(eventListener.callback.fnNotifyCbck))[0];
+                    Number(listenerCallbacks[i].fnNotifyCbck))[0];
                 elem.cbckArg = "0x" +
-                    Number(eventListener.callback.cbckArg).toString(16);
+                    Number(listenerCallbacks[i].cbckArg).toString(16);
 
                 /* Create a new row in the instance data view */
                 view.elements.$add(elem);
@@ -68,6 +68,9 @@
     #pragma FUNC_EXT_CALLED(SharedRegion_invalidSRPtr);
 #endif
 
+static Void SharedRegion_buildIndex(Void);
+static Void SharedRegion_invalidate(ti_sdo_ipc_SharedRegion_Region *region);
+
 /*
  *************************************************************************
  *                       Common Header Functions
@@ -104,6 +107,10 @@ Int SharedRegion_clearEntry(UInt16 id)
     /* needs to be thread safe */
     key = Hwi_disable();
 
+    /* make lock-free getId() callers retry */
+    SharedRegion_module->generation++;
+    _Ipc_compilerBarrier();
+
     /* clear region to their defaults */
     region->entry.isValid       = FALSE;
     region->entry.base          = NULL;
@@ -116,6 +123,10 @@ Int SharedRegion_clearEntry(UInt16 id)
     region->reservedSize        = 0;
     region->heap                = NULL;
 
+    SharedRegion_buildIndex();
+    _Ipc_compilerBarrier();
+    SharedRegion_module->generation++;
+
     /* leave the gate */
     Hwi_restore(key);
 
@@ -213,28 +224,71 @@ SharedRegion_Entry *SharedRegion_getEntryPtr(UInt16 id)
 UInt16 SharedRegion_getId(Ptr addr)
 {
     ti_sdo_ipc_SharedRegion_Region *region;
-    UInt i;
-    UInt key;
-    UInt16 regionId = SharedRegion_INVALIDREGIONID;
+    UInt16 *sortedIds = SharedRegion_module->sortedIds;
+    UInt16 regionId;
+    UInt16 id;
+    Bits32 gen;
+    Int lo, hi, mid;
 
-    /* Try to find the entry that contains the address */
-    for (i = 0; i < ti_sdo_ipc_SharedRegion_numEntries; i++) {
-        region = &(SharedRegion_module->regions[i]);
+    /*
+     *  No gate is taken.  setEntry() and clearEntry() make generation odd
+     *  while they change the table, so retry if it was odd or moved.
+     */
+    for (;;) {
+        gen = SharedRegion_module->generation;
+        if (gen & 1) {
+            continue;
+        }
 
-        /* needs to be thread safe */
-        key = Hwi_disable();
+        /* the table isn't volatile, keep its reads after the first look */
+        _Ipc_compilerBarrier();
 
-        if ((region->entry.isValid) && (addr >= region->entry.base) &&
-            (addr < (Ptr)((uintptr_t)region->entry.base + (SizeT)region->entry.len))) {
-            regionId = i;
+        regionId = SharedRegion_INVALIDREGIONID;
 
-            /* leave the gate */
-            Hwi_restore(key);
+        /* usually the address is in the same region as last time */
+        id = SharedRegion_module->lastId;
+        region = &(SharedRegion_module->regions[id]);
+        if ((region->entry.isValid) &&
+            ((uintptr_t)addr >= (uintptr_t)region->entry.base) &&
+            ((uintptr_t)addr < (uintptr_t)region->entry.base +
+            (SizeT)region->entry.len)) {
+            regionId = id;
+        }
+        else {
+            /* find the last region whose base is not above addr */
+            lo = 0;
+            hi = (Int)SharedRegion_module->numSorted - 1;
+            while (lo <= hi) {
+                mid = (lo + hi) >> 1;
+                region = &(SharedRegion_module->regions[sortedIds[mid]]);
+                if ((uintptr_t)addr < (uintptr_t)region->entry.base) {
+                    hi = mid - 1;
+                }
+                else {
+                    lo = mid + 1;
+                }
+            }
+
+            if (hi >= 0) {
+                id = sortedIds[hi];
+                region = &(SharedRegion_module->regions[id]);
+                if ((region->entry.isValid) &&
+                    ((uintptr_t)addr < (uintptr_t)region->entry.base +
+                    (SizeT)region->entry.len)) {
+                    regionId = id;
+                }
+            }
+        }
+
+        /* ... and before the second */
+        _Ipc_compilerBarrier();
+        if (gen == SharedRegion_module->generation) {
             break;
         }
+    }
 
-        /* leave the gate */
-        Hwi_restore(key);
+    if (regionId != SharedRegion_INVALIDREGIONID) {
+        SharedRegion_module->lastId = regionId;
     }
 
     return (regionId);
@@ -445,6 +499,10 @@ Int SharedRegion_setEntry(UInt16 id, SharedRegion_Entry *entry)
         /* needs to be thread safe */
         key = Hwi_disable();
 
+        /* make lock-free getId() callers retry */
+        SharedRegion_module->generation++;
+        _Ipc_compilerBarrier();
+
         /* set specified region id to entry values */
         region->entry.base          = entry->base;
         region->entry.len           = (Ptr)entry->len;
@@ -455,6 +513,10 @@ Int SharedRegion_setEntry(UInt16 id, SharedRegion_Entry *entry)
         region->entry.name          = entry->name;
         region->entry.isValid       = entry->isValid;
 
+        SharedRegion_buildIndex();
+        _Ipc_compilerBarrier();
+        SharedRegion_module->generation++;
+
         /* leave gate */
         Hwi_restore(key);
 
@@ -483,7 +545,7 @@ Int SharedRegion_setEntry(UInt16 id, SharedRegion_Entry *entry)
 
                 heapHandle = HeapMemMP_create(&params);
                 if (heapHandle == NULL) {
-                    region->entry.isValid = FALSE;
+                    SharedRegion_invalidate(region);
                     return (SharedRegion_E_MEMORY);
                 }
 
@@ -503,7 +565,7 @@ Int SharedRegion_setEntry(UInt16 id, SharedRegion_Entry *entry)
                 if (HeapMemMP_openByAddr(sharedAddr, heapHandlePtr) !=
                     HeapMemMP_S_SUCCESS) {
                     status = SharedRegion_E_FAIL;
-                    region->entry.isValid = FALSE;
+                    SharedRegion_invalidate(region);
                 }
             }
         }
@@ -862,3 +924,60 @@ Int ti_sdo_ipc_SharedRegion_stop(Void)
 
     return (status);
 }
+
+/*
+ *************************************************************************
+ *                      Internal functions
+ *************************************************************************
+ */
+
+/*
+ *  ======== SharedRegion_buildIndex ========
+ *  Rebuild sortedIds from the valid regions, ordered by base address.
+ *  Called with interrupts disabled and generation odd.
+ */
+static Void SharedRegion_buildIndex(Void)
+{
+    ti_sdo_ipc_SharedRegion_Region *regions = SharedRegion_module->regions;
+    UInt16 *sortedIds = SharedRegion_module->sortedIds;
+    UInt16 num = 0;
+    UInt16 i;
+    Int j;
+
+    /* insertion sort, the table is small */
+    for (i = 0; i < ti_sdo_ipc_SharedRegion_numEntries; i++) {
+        if (!regions[i].entry.isValid) {
+            continue;
+        }
+
+        for (j = (Int)num - 1; (j >= 0) &&
+            ((uintptr_t)regions[sortedIds[j]].entry.base >
+            (uintptr_t)regions[i].entry.base); j--) {
+            sortedIds[j + 1] = sortedIds[j];
+        }
+        sortedIds[j + 1] = i;
+        num++;
+    }
+
+    SharedRegion_module->numSorted = num;
+}
+
+/*
+ *  ======== SharedRegion_invalidate ========
+ *  Mark a region invalid after setEntry() failed to create or open its heap.
+ */
+static Void SharedRegion_invalidate(ti_sdo_ipc_SharedRegion_Region *region)
+{
+    UInt key;
+
+    key = Hwi_disable();
+
+    SharedRegion_module->generation++;
+    _Ipc_compilerBarrier();
+    region->entry.isValid = FALSE;
+    SharedRegion_buildIndex();
+    _Ipc_compilerBarrier();
+    SharedRegion_module->generation++;
+
+    Hwi_restore(key);
+}
@@ -60,6 +60,7 @@ function module$meta$init()
     SharedRegion.entryCount = 0;
     SharedRegion.numOffsetBits = 0;
     SharedRegion.$object.regions.length = 0;
+    SharedRegion.$object.sortedIds.length = 0;
 }
 
 /*
@@ -146,6 +147,25 @@ function module$static$init(mod, params)
             regions[idArray[i]].entry.name          = entry.name;
         }
     }
+
+    /* build the getId() lookup index of the valid regions by base address */
+    var sorted = [];
+    for (var i = 0; i < params.numEntries; i++) {
+        if (regions[i].entry.isValid) {
+            sorted.push(i);
+        }
+    }
+    sorted.sort(function(a, b) {
+        return (Number(regions[a].entry.base) - Number(regions[b].entry.base));
+    });
+
+    mod.sortedIds.length = params.numEntries;
+    for (var i = 0; i < params.numEntries; i++) {
+        mod.sortedIds[i] = (i < sorted.length) ? sorted[i] : 0;
+    }
+    mod.numSorted  = sorted.length;
+    mod.lastId     = 0;
+    mod.generation = 0;
 }
 
 /*
@@ -34,6 +34,9 @@
  *  This file should only be used by Ipc modules
  */
 
+#ifndef ti_sdo_ipc__Ipc__include
+#define ti_sdo_ipc__Ipc__include
+
 #define ti_sdo_ipc_Ipc__nolocalnames
 
 /* include the xdc generated .h file */
@@ -48,3 +51,46 @@
 
 #define _Ipc_ptrRoundup(a, b) \
     ((UArg)((((UArg)(a)) + (((UArg)(b)) - 1)) & ~((UArg)(b) - 1)))
+
+/*
+ *  ======== _Ipc_memoryBarrier ========
+ *  Full barrier for lock-free handshakes in uncached shared memory. Loads
+ *  and stores before it are done, as seen by the other processors, before
+ *  any after it, and the compiler does not move accesses across it.
+ */
+static inline Void _Ipc_memoryBarrier(Void)
+{
+#if defined(xdc_target__isaCompatible_64P)
+    /* Use _mfence to make sure memory transactions are complete */
+    _mfence();
+    /* Second mfence needed due to errata: See C6670 Advisory 32 */
+    _mfence();
+#elif defined(xdc_target__isaCompatible_v7A) \
+    || defined(xdc_target__isaCompatible_v7R) \
+    || defined(xdc_target__isaCompatible_v7M) \
+    || defined(xdc_target__isaCompatible_v8A)
+#if defined(__ti__)
+    asm(" dmb");
+#else
+    __asm__ __volatile__ ("dmb sy" ::: "memory");
+#endif
+#elif defined(__GNUC__)
+    __sync_synchronize();
+#endif
+}
+
+/*
+ *  ======== _Ipc_compilerBarrier ========
+ *  Keeps the compiler from moving loads and stores across it, for data
+ *  that is only shared with threads on the same processor.
+ */
+static inline Void _Ipc_compilerBarrier(Void)
+{
+#if defined(__ti__)
+    asm("");
+#elif defined(__GNUC__)
+    __asm__ __volatile__ ("" ::: "memory");
+#endif
+}
+
+#endif
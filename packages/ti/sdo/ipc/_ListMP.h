@@ -41,3 +41,6 @@
 
 /* the common .h file */
 #include <ti/ipc/ListMP.h>
+
+/* take back an element put in an SPSC ring, see ListMP.c */
+Bool _ListMP_spscRetract(ListMP_Handle handle, ListMP_Elem *elem);
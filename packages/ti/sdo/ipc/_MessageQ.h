@@ -41,3 +41,6 @@
 
 /* the common .h file */
 #include <ti/ipc/MessageQ.h>
+
+/* whether MessageQ_free() of 'msg' can block, see MessageQ.c */
+Bool _MessageQ_freeMayBlock(MessageQ_Msg msg);
@@ -114,6 +114,29 @@ IArg GateAAMonitor_enter(GateAAMonitor_Object *obj)
     return (key);
 }
 
+/*
+ *  ======== GateAAMonitor_tryEnter ========
+ */
+Bool GateAAMonitor_tryEnter(GateAAMonitor_Object *obj, IArg *key)
+{
+    *key = IGateProvider_enter(obj->localGate);
+
+    /* If the gate object has already been entered, return the nested value */
+    obj->nested++;
+    if (obj->nested > 1) {
+        return (TRUE);
+    }
+
+    /* Make a single attempt at the monitor */
+    if (!GateAAMonitor_tryLock((Ptr)obj->sharedAddr)) {
+        obj->nested--; /* Restore state of delegate object */
+        IGateProvider_leave(obj->localGate, *key);
+        return (FALSE);
+    }
+
+    return (TRUE);
+}
+
 /*
  *  ======== GateAAMonitor_leave ========
  *  The sharedAddr must come from SL2 (shared L2 memory) so we only
@@ -122,6 +122,31 @@ IArg GateHWSem_enter(GateHWSem_Object *obj)
     return (key);
 }
 
+/*
+ *  ======== GateHWSem_tryEnter ========
+ */
+Bool GateHWSem_tryEnter(GateHWSem_Object *obj, IArg *key)
+{
+    volatile UInt32 *baseAddr = (volatile UInt32 *)GateHWSem_baseAddr;
+
+    *key = IGateProvider_enter(obj->localGate);
+
+    /* If the gate object has already been entered, return the nested value */
+    obj->nested++;
+    if (obj->nested > 1) {
+        return (TRUE);
+    }
+
+    /* Make a single attempt at the hardware lock */
+    if (baseAddr[obj->semNum] != 1) {
+        obj->nested--; /* Restore state of delegate object */
+        IGateProvider_leave(obj->localGate, *key);
+        return (FALSE);
+    }
+
+    return (TRUE);
+}
+
 /*
  *  ======== GateHWSem_leave ========
  */
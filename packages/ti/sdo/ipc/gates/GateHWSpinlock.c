@@ -148,6 +148,33 @@ IArg GateHWSpinlock_enter(GateHWSpinlock_Object *obj)
     return (key);
 }
 
+/*
+ *  ======== GateHWSpinlock_tryEnter ========
+ */
+Bool GateHWSpinlock_tryEnter(GateHWSpinlock_Object *obj, IArg *key)
+{
+    volatile UInt32 *baseAddr = (volatile UInt32 *)GateHWSpinlock_baseAddr;
+
+    *key = IGateProvider_enter(obj->localGate);
+
+    /* If the gate object has already been entered, return the nested value */
+    obj->nested++;
+    if (obj->nested > 1) {
+        return (TRUE);
+    }
+
+    /* Make a single attempt, reading a free spinlock takes it */
+    if (baseAddr[obj->lockNum] != 0) {
+        obj->nested--; /* Restore state of delegate object */
+        IGateProvider_leave(obj->localGate, *key);
+        return (FALSE);
+    }
+
+    Log_write2(GateHWSpinlock_LM_enter,(UArg)obj->lockNum, *key);
+
+    return (TRUE);
+}
+
 /*
  *  ======== GateHWSpinlock_leave ========
  */
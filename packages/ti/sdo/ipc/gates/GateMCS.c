@@ -0,0 +1,512 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== GateMCS.c ========
+ */
+
+#include <xdc/std.h>
+#include <xdc/runtime/Error.h>
+#include <xdc/runtime/Memory.h>
+#include <xdc/runtime/Assert.h>
+#include <xdc/runtime/IGateProvider.h>
+#include <xdc/runtime/Gate.h>
+#include <xdc/runtime/Log.h>
+
+#include <ti/sdo/ipc/interfaces/IGateMPSupport.h>
+
+#include <ti/sysbios/hal/Cache.h>
+
+#include "package/internal/GateMCS.xdc.h"
+
+#include <ti/sdo/ipc/_Ipc.h>
+#include <ti/sdo/utils/_MultiProc.h>
+#include <ti/sdo/ipc/_SharedRegion.h>
+
+/* Address of the 'locked' flag or 'next' link of processor 'id' */
+#define NODE(obj, base, id) \
+    ((volatile Bits32 *)((UArg)(base) + ((id) * (obj)->stride)))
+
+/* Address of flag[0], flag[1] (i = 0, 1) or turn (i = 2) of swap lock 'n' */
+#define SWAPNODE(obj, n, i) \
+    ((volatile Bits32 *)((UArg)((obj)->swap) + \
+    (((((n) - 1) * 3) + (i)) * (obj)->stride)))
+
+static UInt16 GateMCS_numLeaves(UInt16 numProcessors);
+static Void GateMCS_swapEnter(GateMCS_Object *obj);
+static Void GateMCS_swapLeave(GateMCS_Object *obj);
+
+/*
+ *************************************************************************
+ *                       Instance functions
+ *************************************************************************
+ */
+
+/*
+ *  ======== GateMCS_Instance_init ========
+ */
+Int GateMCS_Instance_init(GateMCS_Object *obj,
+                          IGateProvider_Handle localGate,
+                          const GateMCS_Params *params,
+                          Error_Block *eb)
+{
+    SizeT  minAlign = Memory_getMaxDefaultTypeAlign();
+
+    if (SharedRegion_getCacheLineSize(params->regionId) > minAlign) {
+        minAlign = SharedRegion_getCacheLineSize(params->regionId);
+    }
+
+    Assert_isTrue(params->sharedAddr != NULL, ti_sdo_ipc_Ipc_A_invParam);
+    Assert_isTrue(GateMCS_numInstances != 0, ti_sdo_ipc_Ipc_A_invParam);
+
+    obj->localGate      = localGate;
+    obj->cacheEnabled   = SharedRegion_isCacheEnabled(params->regionId);
+    obj->cacheLineSize  = SharedRegion_getCacheLineSize(params->regionId);
+    obj->nested  = 0;
+
+    /* Cluster aware initialization, selfId is 0-based within the cluster */
+    obj->numProcessors  = MultiProc_getNumProcsInCluster();
+    obj->selfId         = MultiProc_self() - MultiProc_getBaseIdOfCluster();
+
+    /* Assign shared memory addresses, one cache line per variable */
+    obj->stride = minAlign;
+    obj->tail   = (volatile Bits32 *)params->sharedAddr;
+    obj->locked = (volatile Bits32 *)((UArg)(params->sharedAddr) + minAlign);
+    obj->next   = (volatile Bits32 *)((UArg)(obj->locked) +
+            (obj->numProcessors * minAlign));
+    obj->swap   = (volatile Bits32 *)((UArg)(obj->next) +
+            (obj->numProcessors * minAlign));
+
+    /* Swap lock tree, processor i is leaf (leaves + i) */
+    obj->leaves = GateMCS_numLeaves(obj->numProcessors);
+    obj->levels = 0;
+    while ((1u << obj->levels) < obj->leaves) {
+        obj->levels++;
+    }
+
+    if (!params->openFlag) {
+        /* Creating. */
+        obj->objType = ti_sdo_ipc_Ipc_ObjType_CREATEDYNAMIC;
+        GateMCS_postInit(obj);
+    }
+    else {
+        /* Opening. */
+        obj->objType = ti_sdo_ipc_Ipc_ObjType_OPENDYNAMIC;
+    }
+
+    return (0);
+}
+
+/*
+ *  ======== GateMCS_Instance_finalize ========
+ */
+Void GateMCS_Instance_finalize(GateMCS_Object *obj, Int status)
+{
+}
+
+/*
+ *  ======== GateMCS_enter ========
+ */
+IArg GateMCS_enter(GateMCS_Object *obj)
+{
+    volatile Bits32 *locked;
+    volatile Bits32 *next;
+    Bits32 pred;
+    IArg key;
+
+    /* Enter local gate */
+    key = IGateProvider_enter(obj->localGate);
+
+    /* If the gate object has already been entered, return the key */
+    obj->nested++;
+    if (obj->nested > 1) {
+        return (key);
+    }
+
+    locked = NODE(obj, obj->locked, obj->selfId);
+    next   = NODE(obj, obj->next, obj->selfId);
+
+    /* Prepare our node before anyone can find it through the tail */
+    *locked = 1;
+    *next   = GateMCS_NONE;
+
+    if (obj->cacheEnabled) {
+        Cache_wbInv((Ptr)locked, obj->cacheLineSize, Cache_Type_ALL, FALSE);
+        Cache_wbInv((Ptr)next, obj->cacheLineSize, Cache_Type_ALL, TRUE);
+    }
+
+    /*
+     *  Append ourselves to the queue.  The swap of the tail and the link
+     *  from our predecessor are done together, so leave never sees a
+     *  successor that has not been linked yet.
+     */
+    GateMCS_swapEnter(obj);
+
+    if (obj->cacheEnabled) {
+        Cache_inv((Ptr)obj->tail, obj->cacheLineSize, Cache_Type_ALL, TRUE);
+    }
+
+    pred = *(obj->tail);
+    *(obj->tail) = obj->selfId;
+
+    if (pred != GateMCS_NONE) {
+        *NODE(obj, obj->next, pred) = obj->selfId;
+    }
+
+    if (obj->cacheEnabled) {
+        Cache_wbInv((Ptr)obj->tail, obj->cacheLineSize, Cache_Type_ALL,
+                FALSE);
+        if (pred != GateMCS_NONE) {
+            Cache_wbInv((Ptr)NODE(obj, obj->next, pred), obj->cacheLineSize,
+                    Cache_Type_ALL, FALSE);
+        }
+        Cache_wait();
+    }
+
+    GateMCS_swapLeave(obj);
+
+    if (pred != GateMCS_NONE) {
+        /* Wait for our predecessor to hand the gate over */
+        do {
+            if (obj->cacheEnabled) {
+                Cache_inv((Ptr)locked, obj->cacheLineSize, Cache_Type_ALL,
+                        TRUE);
+            }
+        } while (*locked != 0);
+    }
+
+    return (key);
+}
+
+/*
+ *  ======== GateMCS_tryEnter ========
+ */
+Bool GateMCS_tryEnter(GateMCS_Object *obj, IArg *key)
+{
+    Bool entered;
+
+    /* Enter local gate */
+    *key = IGateProvider_enter(obj->localGate);
+
+    /* If the gate object has already been entered, return the key */
+    obj->nested++;
+    if (obj->nested > 1) {
+        return (TRUE);
+    }
+
+    /*
+     *  The gate is free only if the queue is empty.  Taking it then leaves
+     *  us as the only node in the queue, so our node needs no 'locked'
+     *  flag, but leave expects 'next' to be clear.
+     */
+    *NODE(obj, obj->next, obj->selfId) = GateMCS_NONE;
+    if (obj->cacheEnabled) {
+        Cache_wbInv((Ptr)NODE(obj, obj->next, obj->selfId), obj->cacheLineSize,
+                Cache_Type_ALL, TRUE);
+    }
+
+    GateMCS_swapEnter(obj);
+
+    if (obj->cacheEnabled) {
+        Cache_inv((Ptr)obj->tail, obj->cacheLineSize, Cache_Type_ALL, TRUE);
+    }
+
+    entered = (*(obj->tail) == GateMCS_NONE);
+    if (entered) {
+        *(obj->tail) = obj->selfId;
+        if (obj->cacheEnabled) {
+            Cache_wbInv((Ptr)obj->tail, obj->cacheLineSize, Cache_Type_ALL,
+                    TRUE);
+        }
+    }
+
+    GateMCS_swapLeave(obj);
+
+    if (!entered) {
+        obj->nested--; /* Restore state of delegate object */
+        IGateProvider_leave(obj->localGate, *key);
+    }
+
+    return (entered);
+}
+
+/*
+ *  ======== GateMCS_leave ========
+ */
+Void GateMCS_leave(GateMCS_Object *obj, IArg key)
+{
+    volatile Bits32 *next;
+    Bits32 succ;
+
+    /* Release the resource and leave system gate. */
+    obj->nested--;
+    if (obj->nested == 0) {
+        next = NODE(obj, obj->next, obj->selfId);
+
+        /* Either dequeue the last node or find the linked successor */
+        GateMCS_swapEnter(obj);
+
+        if (obj->cacheEnabled) {
+            Cache_inv((Ptr)next, obj->cacheLineSize, Cache_Type_ALL, TRUE);
+        }
+
+        succ = *next;
+        if (succ == GateMCS_NONE) {
+            if (obj->cacheEnabled) {
+                Cache_inv((Ptr)obj->tail, obj->cacheLineSize, Cache_Type_ALL,
+                        TRUE);
+            }
+            Assert_isTrue(*(obj->tail) == obj->selfId,
+                    ti_sdo_ipc_Ipc_A_internal);
+
+            *(obj->tail) = GateMCS_NONE;
+            if (obj->cacheEnabled) {
+                Cache_wbInv((Ptr)obj->tail, obj->cacheLineSize,
+                        Cache_Type_ALL, TRUE);
+            }
+        }
+
+        GateMCS_swapLeave(obj);
+
+        if (succ != GateMCS_NONE) {
+            /* Hand the gate to the successor */
+            *NODE(obj, obj->locked, succ) = 0;
+            if (obj->cacheEnabled) {
+                Cache_wbInv((Ptr)NODE(obj, obj->locked, succ),
+                        obj->cacheLineSize, Cache_Type_ALL, TRUE);
+            }
+        }
+    }
+
+    /* Leave local gate */
+    IGateProvider_leave(obj->localGate, key);
+}
+
+/*
+ *************************************************************************
+ *                       Module functions
+ *************************************************************************
+ */
+
+/*
+ *  ======== GateMCS_getReservedMask ========
+ */
+Bits32 *GateMCS_getReservedMask()
+{
+    /* This gate doesn't allow reserving resources */
+    return (NULL);
+}
+
+/*
+ *  ======== GateMCS_sharedMemReq ========
+ */
+SizeT GateMCS_sharedMemReq(const IGateMPSupport_Params *params)
+{
+    SizeT  memReq;
+    UInt16 numProcessors = MultiProc_getNumProcsInCluster(); /* Cluster aware */
+    SizeT  minAlign = Memory_getMaxDefaultTypeAlign();
+
+    if (SharedRegion_getCacheLineSize(params->regionId) > minAlign) {
+        minAlign = SharedRegion_getCacheLineSize(params->regionId);
+    }
+
+    /*  Allocate aligned memory for shared state variables used in protocol
+     *      tail
+     *      locked[NUM_PROCESSORS]
+     *      next[NUM_PROCESSORS]
+     *      swap lock flag[0], flag[1] and turn, for each of the
+     *      (NUM_LEAVES - 1) nodes of the tree
+     */
+    memReq = ((2 * numProcessors) + 1 +
+            (3 * (GateMCS_numLeaves(numProcessors) - 1))) * minAlign;
+
+    return (memReq);
+}
+
+/*
+ *  ======== GateMCS_query ========
+ */
+Bool GateMCS_query(Int qual)
+{
+    Bool rc;
+
+    switch (qual) {
+        case IGateProvider_Q_BLOCKING:
+            /* GateMCS is never blocking */
+            rc = FALSE;
+            break;
+        case IGateProvider_Q_PREEMPTING:
+            rc = TRUE;
+            break;
+        default:
+            rc = FALSE;
+            break;
+    }
+
+    return (rc);
+}
+
+/*
+ *************************************************************************
+ *                       Internal functions
+ *************************************************************************
+ */
+/*
+ *  ======== GateMCS_postInit ========
+ *  Function to be called during
+ *  1. module startup to complete the initialization of all static instances
+ *  2. instance_init to complete the initialization of a dynamic instance
+ *
+ *  Main purpose is to set up shared memory
+ */
+Void GateMCS_postInit(GateMCS_Object *obj)
+{
+    UInt16 i;
+
+    /* Set up shared memory, the queue is empty and the swap lock free */
+    *(obj->tail) = GateMCS_NONE;
+
+    for (i = 0; i < obj->numProcessors; i++) {
+        *NODE(obj, obj->locked, i) = 0;
+        *NODE(obj, obj->next, i) = GateMCS_NONE;
+    }
+
+    for (i = 1; i < obj->leaves; i++) {
+        *SWAPNODE(obj, i, 0) = GateMCS_FREE;
+        *SWAPNODE(obj, i, 1) = GateMCS_FREE;
+        *SWAPNODE(obj, i, 2) = 0;
+    }
+
+    /*
+     * Write everything back to shared memory.
+     */
+    if (obj->cacheEnabled) {
+        Cache_wbInv((Ptr)(obj->tail), obj->stride *
+                ((2 * obj->numProcessors) + 1 + (3 * (obj->leaves - 1))),
+                Cache_Type_ALL, TRUE);
+    }
+}
+
+/*
+ *  ======== GateMCS_numLeaves ========
+ *  Number of leaves of the swap lock tree, a power of two not less than
+ *  the number of processors.  The tree has one node less.
+ */
+static UInt16 GateMCS_numLeaves(UInt16 numProcessors)
+{
+    UInt16 leaves = 1;
+
+    while (leaves < numProcessors) {
+        leaves <<= 1;
+    }
+
+    return (leaves);
+}
+
+/*
+ *  ======== GateMCS_swapEnter ========
+ *  Take the swap lock that protects 'tail' and the 'next' links.
+ *
+ *  The lock is a tournament of two-processor Peterson locks (as in
+ *  GatePeterson), one per node of a binary tree with a processor at each
+ *  leaf.  A processor takes the locks on the path from its leaf up to the
+ *  root; each node is contended by the winners of its two subtrees only.
+ *  It never waits for anything but a processor holding the swap lock, and
+ *  that processor holds it for a few shared memory accesses.
+ */
+static Void GateMCS_swapEnter(GateMCS_Object *obj)
+{
+    volatile Bits32 *flag;
+    volatile Bits32 *otherFlag;
+    volatile Bits32 *turn;
+    UInt pos;
+    UInt side;
+
+    for (pos = obj->leaves + obj->selfId; pos > 1; pos >>= 1) {
+        side = pos & 1;
+        flag = SWAPNODE(obj, pos >> 1, side);
+        otherFlag = SWAPNODE(obj, pos >> 1, side ^ 1);
+        turn = SWAPNODE(obj, pos >> 1, 2);
+
+        /* Indicate that we need the node, then give away the turn */
+        *flag = GateMCS_BUSY;
+        if (obj->cacheEnabled) {
+            Cache_wbInv((Ptr)flag, obj->cacheLineSize, Cache_Type_ALL, TRUE);
+        }
+
+        *turn = side ^ 1;
+        if (obj->cacheEnabled) {
+            Cache_wbInv((Ptr)turn, obj->cacheLineSize, Cache_Type_ALL, TRUE);
+            Cache_inv((Ptr)otherFlag, obj->cacheLineSize, Cache_Type_ALL,
+                    TRUE);
+        }
+
+        /* Our writes must be visible before we look at the other side */
+        _Ipc_memoryBarrier();
+
+        /* Wait while the other side wants the node and has the turn */
+        while ((*otherFlag == GateMCS_BUSY) && (*turn == (side ^ 1))) {
+            if (obj->cacheEnabled) {
+                Cache_inv((Ptr)otherFlag, obj->cacheLineSize, Cache_Type_ALL,
+                        FALSE);
+                Cache_inv((Ptr)turn, obj->cacheLineSize, Cache_Type_ALL,
+                        TRUE);
+            }
+        }
+
+        _Ipc_memoryBarrier();
+    }
+}
+
+/*
+ *  ======== GateMCS_swapLeave ========
+ *  Release the swap lock, from the root down.  Releasing a lower node
+ *  first would let the next winner of that subtree meet our still busy
+ *  flag further up, on our side of the node.
+ */
+static Void GateMCS_swapLeave(GateMCS_Object *obj)
+{
+    volatile Bits32 *flag;
+    UInt leaf = obj->leaves + obj->selfId;
+    UInt shift;
+
+    /* The tail and links must be written before the lock is seen free */
+    _Ipc_memoryBarrier();
+
+    for (shift = obj->levels; shift > 0; shift--) {
+        flag = SWAPNODE(obj, leaf >> shift, (leaf >> (shift - 1)) & 1);
+
+        *flag = GateMCS_FREE;
+        if (obj->cacheEnabled) {
+            Cache_wbInv((Ptr)flag, obj->cacheLineSize, Cache_Type_ALL, TRUE);
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2018 Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== GateMCS.xs ========
+ *
+ */
+
+var GateMCS      = null;
+var MultiProc    = null;
+var Cache        = null;
+var Ipc          = null;
+
+/*!
+ *  ======== module$use ========
+ */
+function module$use()
+{
+    GateMCS      = this;
+    MultiProc    = xdc.useModule('ti.sdo.utils.MultiProc');
+    Cache        = xdc.useModule('ti.sysbios.hal.Cache');
+    Ipc          = xdc.useModule('ti.sdo.ipc.Ipc');
+}
+
+/*!
+ *  ======== instance$static$init ========
+ */
+function instance$static$init(obj, params)
+{
+    GateMCS.$logError("Static instances not supported yet",
+            GateMCS.common$, GateMCS.common$.namedInstance);
+}
+
+/*!
+ *  ======== queryMeta ========
+ */
+function queryMeta(qual)
+{
+    var rc = false;
+    var IGateProvider = xdc.module('xdc.runtime.IGateProvider');
+
+    switch (qual) {
+        case IGateProvider.Q_BLOCKING:
+            rc = false;
+            break;
+        case IGateProvider.Q_PREEMPTING:
+            rc = true;
+            break;
+        default:
+           GateMCS.$logWarning("Invalid quality.", this, qual);
+           break;
+    }
+
+    return (rc);
+}
+
+/*
+ *  ======== getNumResources ========
+ */
+function getNumResources()
+{
+    return (this.numInstances);
+}
+
+/*
+ *************************************************************************
+ *                       ROV View functions
+ *************************************************************************
+ */
+
+/*
+ *  ======== getRemoteStatus$view ========
+ */
+function getRemoteStatus$view(handle)
+{
+    var Program         = xdc.useModule('xdc.rov.Program');
+
+    try {
+        var view = Program.scanHandleView('ti.sdo.ipc.gates.GateMCS',
+                                          $addr(handle), 'Basic');
+        if (view.gateOwner == "free") {
+            return (view.gateOwner);
+        }
+        return ("Last queued by " + view.gateOwner);
+    }
+    catch(e) {
+        throw("ERROR: Couldn't scan GateMCS handle view: " + e);
+    }
+}
+
+/*
+ *  ======== viewInitBasic ========
+ */
+function viewInitBasic(view, obj)
+{
+    var Program         = xdc.useModule('xdc.rov.Program');
+    var Ipc             = xdc.useModule('ti.sdo.ipc.Ipc');
+    var GateMCS         = xdc.useModule('ti.sdo.ipc.gates.GateMCS');
+    var ScalarStructs   = xdc.useModule('xdc.rov.support.ScalarStructs');
+
+    /* view.objType */
+    view.objType = Ipc.getObjTypeStr$view(obj.objType);
+
+    /* view.localGate */
+    view.localGate = obj.localGate;
+
+    /* view.nested */
+    view.nested = obj.nested;
+
+    /* view.gateOwner, the tail of the queue is the most recent arrival */
+    try {
+        var tail = Program.fetchStruct(ScalarStructs.S_Bits32$fetchDesc,
+                                       obj.tail);
+        if (tail.elem == GateMCS.NONE) {
+            view.gateOwner = "free";
+        }
+        else {
+            view.gateOwner = "core " + tail.elem + " of the cluster";
+        }
+    }
+    catch(e) {
+        view.$status["gateOwner"] =
+            "Error: could not fetch the queue tail from shared memory: " + e;
+    }
+}
@@ -81,6 +81,17 @@ IArg GateMPSupportNull_enter(GateMPSupportNull_Object *obj)
     return (0);
 }
 
+/*
+ *  ======== GateMPSupportNull_tryEnter ========
+ *  Never busy, behaves like enter.
+ */
+Bool GateMPSupportNull_tryEnter(GateMPSupportNull_Object *obj, IArg *key)
+{
+    *key = GateMPSupportNull_enter(obj);
+
+    return (TRUE);
+}
+
 /*
  *  ======== GateMPSupportNull_leave ========
  *  Only releases the gate if key == FIRST_ENTER.
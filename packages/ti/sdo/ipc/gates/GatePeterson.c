@@ -190,6 +190,49 @@ IArg GatePeterson_enter(GatePeterson_Object *obj)
     return (key);
 }
 
+/*
+ *  ======== GatePeterson_tryEnter ========
+ */
+Bool GatePeterson_tryEnter(GatePeterson_Object *obj, IArg *key)
+{
+    /* Enter local gate */
+    *key = IGateProvider_enter(obj->localGate);
+
+    /* If the gate object has already been entered, return the key */
+    obj->nested++;
+    if (obj->nested > 1) {
+        return (TRUE);
+    }
+
+    /* Indicate that we need to use the resource. */
+    *(obj->flag[obj->selfId]) = GatePeterson_BUSY ;
+    if (obj->cacheEnabled) {
+        Cache_wbInv((Ptr)obj->flag[obj->selfId], obj->cacheLineSize,
+            Cache_Type_ALL, TRUE);
+    }
+
+    /* Give away the turn. */
+    *(obj->turn) = obj->otherId;
+
+    if (obj->cacheEnabled) {
+        Cache_wbInv((Ptr)obj->turn, obj->cacheLineSize, Cache_Type_ALL, TRUE);
+        Cache_inv((Ptr)obj->flag[obj->otherId], obj->cacheLineSize,
+            Cache_Type_ALL, TRUE);
+    }
+
+    /*
+     *  Where enter would wait, withdraw instead.  Dropping the flag is
+     *  what leave does, so the other processor can go ahead.
+     */
+    if ((*(obj->flag[obj->otherId]) == GatePeterson_BUSY) &&
+        (*(obj->turn) == obj->otherId)) {
+        GatePeterson_leave(obj, *key);
+        return (FALSE);
+    }
+
+    return (TRUE);
+}
+
 /*
  *  ======== GatePeterson_leave ========
  */
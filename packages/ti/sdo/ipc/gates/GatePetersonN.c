@@ -196,6 +196,69 @@ IArg GatePetersonN_enter(GatePetersonN_Object *obj)
     return (key);
 }
 
+/*
+ *  ======== GatePetersonN_tryEnter ========
+ */
+Bool GatePetersonN_tryEnter(GatePetersonN_Object *obj, IArg *key)
+{
+    SizeT   numProcessors;
+    SizeT   myProcId;
+    Int32   curStage;
+    SizeT   proc;
+
+    /* Enter local gate */
+    *key = IGateProvider_enter(obj->localGate);
+
+    /* If the gate object has already been entered, return the key */
+    obj->nested++;
+    if (obj->nested > 1) {
+        return (TRUE);
+    }
+    numProcessors = obj->numProcessors;
+    myProcId      = obj->selfId;
+
+    for (curStage=0; curStage < ((Int32)numProcessors - 1); curStage++) {
+
+        *(obj->enteredStage[myProcId]) = curStage;
+        *(obj->lastProcEnteringStage[curStage]) = myProcId;
+
+        if (obj->cacheEnabled) {
+
+            Cache_wbInv((Ptr)obj->enteredStage[myProcId], obj->cacheLineSize,
+                    Cache_Type_ALL, FALSE);
+            Cache_wbInv((Ptr)obj->lastProcEnteringStage[curStage],
+                    obj->cacheLineSize, Cache_Type_ALL, TRUE);
+        }
+
+        for (proc=0; proc < numProcessors; proc++) {
+
+            if (proc != myProcId) {
+
+                if (obj->cacheEnabled) {
+
+                    Cache_inv((Ptr)obj->enteredStage[proc],
+                            obj->cacheLineSize, Cache_Type_ALL, FALSE);
+                    Cache_inv((Ptr)obj->lastProcEnteringStage[curStage],
+                            obj->cacheLineSize, Cache_Type_ALL, TRUE);
+                }
+
+                /*
+                 *  Where enter would wait, withdraw from all stages
+                 *  instead, the same way leave does.
+                 */
+                if ((*(obj->enteredStage[proc]) >= curStage) &&
+                    (*(obj->lastProcEnteringStage[curStage]) == myProcId)) {
+                    GatePetersonN_leave(obj, *key);
+                    return (FALSE);
+                }
+            }
+        }
+
+    } /* stages */
+
+    return (TRUE);
+}
+
 /*
  *  ======== GatePetersonN_leave ========
  */
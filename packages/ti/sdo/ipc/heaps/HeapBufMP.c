@@ -40,6 +40,7 @@
 #include <xdc/runtime/IHeap.h>
 
 #include <ti/sysbios/hal/Cache.h>
+#include <ti/sysbios/hal/Hwi.h>
 
 #include <ti/sdo/ipc/_Ipc.h>
 #include <ti/sdo/utils/_NameServer.h>
@@ -54,10 +55,12 @@
 #ifdef __ti__
     #pragma FUNC_EXT_CALLED(HeapBufMP_Params_init);
     #pragma FUNC_EXT_CALLED(HeapBufMP_alloc);
+    #pragma FUNC_EXT_CALLED(HeapBufMP_allocN);
     #pragma FUNC_EXT_CALLED(HeapBufMP_close);
     #pragma FUNC_EXT_CALLED(HeapBufMP_create);
     #pragma FUNC_EXT_CALLED(HeapBufMP_delete);
     #pragma FUNC_EXT_CALLED(HeapBufMP_free);
+    #pragma FUNC_EXT_CALLED(HeapBufMP_freeN);
     #pragma FUNC_EXT_CALLED(HeapBufMP_getExtendedStats);
     #pragma FUNC_EXT_CALLED(HeapBufMP_getStats);
     #pragma FUNC_EXT_CALLED(HeapBufMP_open);
@@ -100,6 +103,195 @@ static Void HeapBufMP_getRTSCParams(
     params->exact       = sparams->exact;
 }
 
+/*
+ *************************************************************************
+ *                       Local cache functions
+ *************************************************************************
+ */
+
+/*
+ * With HeapBufMP.localCacheSize set, each processor keeps up to that many
+ * freed blocks in obj->localCache.  alloc() and free() use it with only
+ * interrupts disabled, and go to the shared free list half of the cache
+ * at a time, so one gate acquisition is paid for several blocks.  Without
+ * a local cache the same functions move a single block.
+ */
+
+#define HeapBufMP_BATCH ((ti_sdo_ipc_heaps_HeapBufMP_localCacheSize + 1) / 2)
+
+/* blocks moved between the local cache and the list per ListMP call */
+#define HeapBufMP_CHUNK 8
+
+/*
+ *  ======== HeapBufMP_countFree ========
+ *  Add delta to the shared free block count.  Must be called with the
+ *  gate entered.
+ */
+static Void HeapBufMP_countFree(ti_sdo_ipc_heaps_HeapBufMP_Object *obj,
+        Int delta)
+{
+    /* Make sure the attrs are not in cache */
+    if (obj->cacheEnabled) {
+        Cache_inv(obj->attrs, sizeof(ti_sdo_ipc_heaps_HeapBufMP_Attrs),
+                Cache_Type_ALL, TRUE);
+    }
+
+    obj->attrs->numFreeBlocks += delta;
+
+    if (obj->attrs->numFreeBlocks < obj->attrs->minFreeBlocks) {
+        /* save the new minimum */
+        obj->attrs->minFreeBlocks = obj->attrs->numFreeBlocks;
+    }
+
+    /* Make sure the attrs are written out to memory */
+    if (obj->cacheEnabled) {
+        Cache_wbInv(obj->attrs, sizeof(ti_sdo_ipc_heaps_HeapBufMP_Attrs),
+                Cache_Type_ALL, TRUE);
+    }
+}
+
+/*
+ *  ======== HeapBufMP_getBlocks ========
+ *  Take num blocks off the shared free list into blocks[] and then up to
+ *  'extra' more into the local cache, as long as it has room, under one
+ *  gate acquisition.  Each group is detached from the list with a single
+ *  ListMP_getHeadList().  Returns FALSE, having taken no blocks, if the
+ *  free list has fewer than num.
+ */
+static Bool HeapBufMP_getBlocks(ti_sdo_ipc_heaps_HeapBufMP_Object *obj,
+        Ptr *blocks, UInt num, UInt extra)
+{
+    Ptr chunk[HeapBufMP_CHUNK];
+    UInt hwiKey;
+    UInt count;
+    UInt taken;
+    UInt cached;
+    IArg key;
+
+    key = GateMP_enter((GateMP_Handle)obj->gate);
+
+    count = ListMP_getHeadList((ListMP_Handle)obj->freeList,
+            (ListMP_Elem **)blocks, num);
+
+    if (count < num) {
+        /* Not enough blocks, put back the ones taken in the same order */
+        while (count > 0) {
+            ListMP_putHead((ListMP_Handle)obj->freeList, blocks[--count]);
+        }
+
+        GateMP_leave((GateMP_Handle)obj->gate, key);
+
+        return (FALSE);
+    }
+
+    while (extra > 0) {
+        taken = ListMP_getHeadList((ListMP_Handle)obj->freeList,
+                (ListMP_Elem **)chunk,
+                extra < HeapBufMP_CHUNK ? extra : HeapBufMP_CHUNK);
+        if (taken == 0) {
+            break;
+        }
+
+        /* Frees on this processor may have filled the cache meanwhile */
+        hwiKey = Hwi_disable();
+        for (cached = 0; cached < taken && obj->numCached <
+                ti_sdo_ipc_heaps_HeapBufMP_localCacheSize; cached++) {
+            obj->localCache[obj->numCached++] = chunk[cached];
+        }
+        Hwi_restore(hwiKey);
+
+        count += cached;
+        extra -= taken;
+
+        if (cached < taken) {
+            /* No more room, put back the rest in the same order */
+            while (taken > cached) {
+                ListMP_putHead((ListMP_Handle)obj->freeList, chunk[--taken]);
+            }
+            break;
+        }
+    }
+
+    /*
+     *  Keep track of the min number of free for this HeapBufMP, if user
+     *  has set the config variable trackMaxAllocs to true. Also, keep track
+     *  of the number of free blocks.
+     *
+     *  The min number of free blocks, 'minFreeBlocks', will be used to compute
+     *  the "all time" maximum number of allocated blocks in getExtendedStats().
+     */
+    if (ti_sdo_ipc_heaps_HeapBufMP_trackAllocs && count > 0) {
+        HeapBufMP_countFree(obj, -(Int)count);
+    }
+
+    GateMP_leave((GateMP_Handle)obj->gate, key);
+
+    return (TRUE);
+}
+
+/*
+ *  ======== HeapBufMP_putBlocks ========
+ *  Put the num blocks in blocks[] and then up to 'flush' blocks from the
+ *  local cache back on the shared free list under one gate acquisition.
+ *  Each group is spliced onto the list with a single ListMP_putTailList().
+ */
+static Void HeapBufMP_putBlocks(ti_sdo_ipc_heaps_HeapBufMP_Object *obj,
+        Ptr *blocks, UInt num, UInt flush)
+{
+    Ptr chunk[HeapBufMP_CHUNK];
+    UInt hwiKey;
+    UInt count;
+    UInt total;
+    UInt i;
+    IArg key;
+
+    key = GateMP_enter((GateMP_Handle)obj->gate);
+
+    /*
+     *  Invalidate entire blocks make sure stale cache data isn't
+     *  evicted later
+     */
+    if (obj->cacheEnabled) {
+        for (i = 0; i < num; i++) {
+            Cache_inv(blocks[i], obj->blockSize, Cache_Type_ALL, FALSE);
+        }
+    }
+    ListMP_putTailList((ListMP_Handle)obj->freeList, (ListMP_Elem **)blocks,
+            num);
+    total = num;
+
+    /* the local cache can change under us, so move it through chunk[] */
+    while (flush > 0) {
+        hwiKey = Hwi_disable();
+        for (count = 0; count < HeapBufMP_CHUNK && count < flush &&
+                obj->numCached > 0; count++) {
+            chunk[count] = obj->localCache[--obj->numCached];
+        }
+        Hwi_restore(hwiKey);
+
+        if (count == 0) {
+            break;
+        }
+
+        if (obj->cacheEnabled) {
+            for (i = 0; i < count; i++) {
+                Cache_inv(chunk[i], obj->blockSize, Cache_Type_ALL, FALSE);
+            }
+        }
+        ListMP_putTailList((ListMP_Handle)obj->freeList,
+                (ListMP_Elem **)chunk, count);
+
+        total += count;
+        flush -= count;
+    }
+
+    if (ti_sdo_ipc_heaps_HeapBufMP_trackAllocs && total > 0) {
+        HeapBufMP_countFree(obj, (Int)total);
+    }
+
+    GateMP_leave((GateMP_Handle)obj->gate, key);
+}
+
 /*
  *************************************************************************
  *                       Common Header Functions
@@ -132,6 +324,45 @@ Ptr HeapBufMP_alloc(HeapBufMP_Handle handle,
             (ti_sdo_ipc_heaps_HeapBufMP_Object *)handle, size, align, &eb));
 }
 
+/*
+ *  ======== HeapBufMP_allocN ========
+ *  Allocate num blocks, all from the local cache and one batch off the
+ *  shared free list, or none.
+ */
+Int HeapBufMP_allocN(HeapBufMP_Handle handle, SizeT size, SizeT align,
+        Ptr blocks[], UInt num)
+{
+    ti_sdo_ipc_heaps_HeapBufMP_Object *obj =
+            (ti_sdo_ipc_heaps_HeapBufMP_Object *)handle;
+    UInt hwiKey;
+    UInt count = 0;
+
+    /* Same checks as HeapBufMP_alloc() */
+    if ((size > obj->blockSize) || (obj->exact && size != obj->blockSize) ||
+        (align > obj->align)) {
+        return (HeapBufMP_E_INVALIDARG);
+    }
+
+    /* Take what the local cache has */
+    if (obj->localCache != NULL) {
+        hwiKey = Hwi_disable();
+        while ((count < num) && (obj->numCached > 0)) {
+            blocks[count++] = obj->localCache[--obj->numCached];
+        }
+        Hwi_restore(hwiKey);
+    }
+
+    if ((count < num) && !HeapBufMP_getBlocks(obj, blocks + count,
+            num - count, (obj->localCache != NULL) ? HeapBufMP_BATCH : 0)) {
+        /* Not enough free blocks, give back the ones from the cache */
+        HeapBufMP_freeN(handle, blocks, size, count);
+
+        return (HeapBufMP_E_MEMORY);
+    }
+
+    return (HeapBufMP_S_SUCCESS);
+}
+
 /*
  *  ======== HeapBufMP_close ========
  */
@@ -185,6 +416,46 @@ Void HeapBufMP_free(HeapBufMP_Handle handle, Ptr addr, SizeT size)
     ti_sdo_ipc_heaps_HeapBufMP_free(
         (ti_sdo_ipc_heaps_HeapBufMP_Object *)handle, addr, size);
 }
+
+/*
+ *  ======== HeapBufMP_freeN ========
+ */
+Void HeapBufMP_freeN(HeapBufMP_Handle handle, Ptr blocks[], SizeT size,
+        UInt num)
+{
+    ti_sdo_ipc_heaps_HeapBufMP_Object *obj =
+            (ti_sdo_ipc_heaps_HeapBufMP_Object *)handle;
+    UInt hwiKey;
+    UInt count = 0;
+    UInt i;
+
+    for (i = 0; i < num; i++) {
+        Assert_isTrue(((UArg)blocks[i] >= (UArg)obj->buf) &&
+            ((UArg)blocks[i] <
+             ((UArg)obj->buf + obj->blockSize * obj->numBlocks)),
+            ti_sdo_ipc_heaps_HeapBufMP_A_invBlockFreed);
+
+        Assert_isTrue((UArg)blocks[i] % obj->align == 0,
+                ti_sdo_ipc_heaps_HeapBufMP_A_badAlignment);
+    }
+
+    /* Keep what fits in the local cache */
+    if (obj->localCache != NULL) {
+        hwiKey = Hwi_disable();
+        while ((count < num) &&
+               (obj->numCached < ti_sdo_ipc_heaps_HeapBufMP_localCacheSize)) {
+            obj->localCache[obj->numCached++] = blocks[count++];
+        }
+        Hwi_restore(hwiKey);
+    }
+
+    /* Return the rest in one batch, making room in a full local cache */
+    if (count < num) {
+        HeapBufMP_putBlocks(obj, blocks + count, num - count,
+                (obj->localCache != NULL) ? HeapBufMP_BATCH : 0);
+    }
+}
+
 /*
  *  ======== HeapBufMP_getExtendedStats ========
  */
@@ -409,6 +680,17 @@ Int ti_sdo_ipc_heaps_HeapBufMP_Instance_init(
 
     obj->nsKey          = NULL;
     obj->allocSize      = 0;
+    obj->localCache     = NULL;
+    obj->numCached      = 0;
+
+    if (ti_sdo_ipc_heaps_HeapBufMP_localCacheSize != 0) {
+        obj->localCache = Memory_alloc(NULL,
+                ti_sdo_ipc_heaps_HeapBufMP_localCacheSize * sizeof(Ptr), 0,
+                eb);
+        if (obj->localCache == NULL) {
+            return (7);
+        }
+    }
 
     if (params->openFlag) {
         /* Opening the gate */
@@ -548,6 +830,16 @@ Int ti_sdo_ipc_heaps_HeapBufMP_Instance_init(
 Void ti_sdo_ipc_heaps_HeapBufMP_Instance_finalize(
         ti_sdo_ipc_heaps_HeapBufMP_Object *obj, Int status)
 {
+    if (obj->localCache != NULL) {
+        /* Return the locally cached blocks before the freeList goes away */
+        if (obj->freeList != NULL && obj->numCached > 0) {
+            HeapBufMP_putBlocks(obj, NULL, 0, obj->numCached);
+        }
+
+        Memory_free(NULL, obj->localCache,
+                ti_sdo_ipc_heaps_HeapBufMP_localCacheSize * sizeof(Ptr));
+    }
+
     if (obj->objType & (ti_sdo_ipc_Ipc_ObjType_CREATEDYNAMIC |
                         ti_sdo_ipc_Ipc_ObjType_CREATEDYNAMIC_REGION)) {
         /* Heap is being deleted */
@@ -604,7 +896,7 @@ Ptr ti_sdo_ipc_heaps_HeapBufMP_alloc(ti_sdo_ipc_heaps_HeapBufMP_Object *obj,
         SizeT size, SizeT align, Error_Block *eb)
 {
     Char *block;
-    IArg key;
+    UInt hwiKey;
 
     /* Check for valid blockSize */
     if (size > obj->blockSize) {
@@ -627,53 +919,27 @@ Ptr ti_sdo_ipc_heaps_HeapBufMP_alloc(ti_sdo_ipc_heaps_HeapBufMP_Object *obj,
         return (NULL);
     }
 
-    /* Enter the gate */
-    key = GateMP_enter((GateMP_Handle)obj->gate);
+    /* Take the most recently freed block from the local cache */
+    if (obj->localCache != NULL) {
+        hwiKey = Hwi_disable();
+        block = (obj->numCached > 0) ?
+                obj->localCache[--obj->numCached] : NULL;
+        Hwi_restore(hwiKey);
 
-    /* Get the first block */
-    block = ListMP_getHead((ListMP_Handle)obj->freeList);
+        if (block != NULL) {
+            return (block);
+        }
+    }
 
-    /* Make sure that a valid pointer was returned. */
-    if (block == NULL) {
-        GateMP_leave((GateMP_Handle)obj->gate, key);
+    /* Get a block from the shared free list, refilling the local cache */
+    if (!HeapBufMP_getBlocks(obj, (Ptr *)&block, 1,
+            (obj->localCache != NULL) ? HeapBufMP_BATCH : 0)) {
         Error_raise(eb, ti_sdo_ipc_heaps_HeapBufMP_E_noBlocksLeft, (IArg)obj,
                 (IArg)size);
 
         return (NULL);
     }
 
-    /*
-     *  Keep track of the min number of free for this HeapBufMP, if user
-     *  has set the config variable trackMaxAllocs to true. Also, keep track
-     *  of the number of free blocks.
-     *
-     *  The min number of free blocks, 'minFreeBlocks', will be used to compute
-     *  the "all time" maximum number of allocated blocks in getExtendedStats().
-     */
-    if (ti_sdo_ipc_heaps_HeapBufMP_trackAllocs) {
-        /* Make sure the attrs are not in cache */
-        if (obj->cacheEnabled) {
-            Cache_inv(obj->attrs, sizeof(ti_sdo_ipc_heaps_HeapBufMP_Attrs),
-                    Cache_Type_ALL, TRUE);
-        }
-
-        obj->attrs->numFreeBlocks--;
-
-        if (obj->attrs->numFreeBlocks < obj->attrs->minFreeBlocks) {
-            /* save the new minimum */
-            obj->attrs->minFreeBlocks = obj->attrs->numFreeBlocks;
-        }
-
-        /* Make sure the attrs are written out to memory */
-        if (obj->cacheEnabled) {
-            Cache_wbInv(obj->attrs, sizeof(ti_sdo_ipc_heaps_HeapBufMP_Attrs),
-                    Cache_Type_ALL, TRUE);
-        }
-    }
-
-    /* Leave the gate */
-    GateMP_leave((GateMP_Handle)obj->gate, key);
-
     return (block);
 }
 
@@ -684,7 +950,8 @@ Ptr ti_sdo_ipc_heaps_HeapBufMP_alloc(ti_sdo_ipc_heaps_HeapBufMP_Object *obj,
 Void ti_sdo_ipc_heaps_HeapBufMP_free(ti_sdo_ipc_heaps_HeapBufMP_Object *obj,
         Ptr block, SizeT size)
 {
-    IArg key;
+    UInt hwiKey;
+    Bool cached;
 
     Assert_isTrue(((UArg)block >= (UArg)obj->buf) &&
         ((UArg)block < ((UArg)obj->buf + obj->blockSize * obj->numBlocks)),
@@ -694,37 +961,23 @@ Void ti_sdo_ipc_heaps_HeapBufMP_free(ti_sdo_ipc_heaps_HeapBufMP_Object *obj,
     Assert_isTrue((UArg)block % obj->align == 0,
             ti_sdo_ipc_heaps_HeapBufMP_A_badAlignment);
 
-    /*
-     *  Invalidate entire block make sure stale cache data isn't
-     *  evicted later
-     */
-    if (obj->cacheEnabled) {
-        Cache_inv(block, obj->attrs->blockSize, Cache_Type_ALL, FALSE);
-    }
-
-    /* Enter the gate */
-    key = GateMP_enter((GateMP_Handle)obj->gate);
-
-    ListMP_putTail((ListMP_Handle)obj->freeList, block);
-
-    if (ti_sdo_ipc_heaps_HeapBufMP_trackAllocs) {
-        /* Make sure the attrs are not in cache */
-        if (obj->cacheEnabled) {
-            Cache_inv(obj->attrs, sizeof(ti_sdo_ipc_heaps_HeapBufMP_Attrs),
-                Cache_Type_ALL, FALSE);
+    /* Keep the block in the local cache if it has room */
+    if (obj->localCache != NULL) {
+        hwiKey = Hwi_disable();
+        cached = obj->numCached < ti_sdo_ipc_heaps_HeapBufMP_localCacheSize;
+        if (cached) {
+            obj->localCache[obj->numCached++] = block;
         }
+        Hwi_restore(hwiKey);
 
-        obj->attrs->numFreeBlocks++;
-
-        /* Make sure the attrs are written out to memory */
-        if (obj->cacheEnabled) {
-            Cache_wbInv(obj->attrs, sizeof(ti_sdo_ipc_heaps_HeapBufMP_Attrs),
-                Cache_Type_ALL, TRUE);
+        if (cached) {
+            return;
         }
     }
 
-    /* Leave the gate */
-    GateMP_leave((GateMP_Handle)obj->gate, key);
+    /* Return the block, making room in a full local cache */
+    HeapBufMP_putBlocks(obj, &block, 1,
+            (obj->localCache != NULL) ? HeapBufMP_BATCH : 0);
 }
 
 /*
@@ -785,6 +1038,24 @@ Bool ti_sdo_ipc_heaps_HeapBufMP_isBlocking(
  *************************************************************************
  */
 
+/*
+ *  ======== _HeapBufMP_allocN ========
+ *  MessageQ_allocN() batch allocator.  Returns 1 if heap is not a
+ *  HeapBufMP, for MessageQ to allocate one message at a time.
+ */
+Int _HeapBufMP_allocN(IHeap_Handle heap, SizeT size, Ptr *blocks, UInt num)
+{
+    ti_sdo_ipc_heaps_HeapBufMP_Handle handle;
+
+    handle = ti_sdo_ipc_heaps_HeapBufMP_Handle_downCast(heap);
+    if (handle == NULL) {
+        return (1);
+    }
+
+    return (HeapBufMP_allocN((HeapBufMP_Handle)handle, size, 0, blocks,
+            num));
+}
+
 /*
  *                          Shared memory Layout:
  *
@@ -42,6 +42,7 @@ var Ipc             = null;
 var Cache           = null;
 var GateMP          = null;
 var Memory          = null;
+var Hwi             = null;
 
 var instCount = 0;  /* use to determine if processing last instance */
 
@@ -58,6 +59,7 @@ function module$use()
     GateMP          = xdc.useModule('ti.sdo.ipc.GateMP');
     Cache           = xdc.useModule('ti.sysbios.hal.Cache');
     Memory          = xdc.useModule('xdc.runtime.Memory');
+    Hwi             = xdc.useModule('ti.sysbios.hal.Hwi');
 }
 
 /*
@@ -35,12 +35,14 @@
  */
 
 #include <xdc/std.h>
+#include <string.h>
 #include <xdc/runtime/Error.h>
 #include <xdc/runtime/Assert.h>
 #include <xdc/runtime/Memory.h>
 #include <xdc/runtime/IHeap.h>
 
 #include <ti/sysbios/hal/Cache.h>
+#include <ti/sysbios/hal/Hwi.h>
 
 #include <ti/sdo/ipc/_Ipc.h>
 #include <ti/sdo/utils/_NameServer.h>
@@ -95,6 +97,739 @@ static Void HeapMemMP_getRTSCParams(
     params->sharedBufSize = sparams->sharedBufSize;
 }
 
+/*
+ *************************************************************************
+ *                       Free list functions
+ *************************************************************************
+ */
+
+/*
+ * The free blocks are kept on NUMCLASSES doubly-linked lists, one for
+ * each size class (see HeapMemMP.xdc).  Every power of two of sizes has
+ * 2^SUBCLASSBITS classes, so any block in the class above the one of a
+ * request is at most 1/2^SUBCLASSBITS larger than needed.  The masks in
+ * the attrs find the first non-empty class from a class on in two steps.
+ *
+ * Taking every block from the classes above the request splits large
+ * blocks that a block of the request's own class could have spared, so
+ * alloc() first looks at up to MAXLOOKS blocks of each class below the
+ * one it would take from.  With the stress test in linux/src/tests
+ * (64 MB heap, 6000 live blocks of 16 B to 64 KB) this keeps the largest
+ * free block at 10.3 MB after 2M operations, against 6.3 MB without the
+ * look and 10.5 MB for the single address-ordered list this replaced.
+ *
+ * A bitmap with one bit per unit marks the first and the last unit of
+ * every free block, and the last Bits32 of a free block holds its size.
+ * free() checks the bits just outside the block being freed to find the
+ * free blocks it can join with, instead of walking the free list.
+ *
+ * All of these functions must be called with the gate entered.  They
+ * invalidate the shared words they read and write back those they
+ * change.
+ */
+
+#define HeapMemMP_SUBCLASSES (1 << ti_sdo_ipc_heaps_HeapMemMP_SUBCLASSBITS)
+#define HeapMemMP_MAXLOOKS 8
+
+/*
+ *  ======== HeapMemMP_log2 ========
+ *  floor(log2(x)) for x != 0
+ */
+static inline UInt HeapMemMP_log2(Bits32 x)
+{
+    UInt n = 0;
+
+    if (x & 0xFFFF0000) {
+        n += 16;
+        x >>= 16;
+    }
+    if (x & 0xFF00) {
+        n += 8;
+        x >>= 8;
+    }
+    if (x & 0xF0) {
+        n += 4;
+        x >>= 4;
+    }
+    if (x & 0xC) {
+        n += 2;
+        x >>= 2;
+    }
+    if (x & 0x2) {
+        n += 1;
+    }
+
+    return (n);
+}
+
+/*
+ *  ======== HeapMemMP_unitClass ========
+ *  Class of a block of units minAlign units
+ */
+static inline UInt HeapMemMP_unitClass(Bits32 units)
+{
+    UInt shift;
+
+    if (units < HeapMemMP_SUBCLASSES) {
+        return (units);
+    }
+
+    shift = HeapMemMP_log2(units) - ti_sdo_ipc_heaps_HeapMemMP_SUBCLASSBITS;
+
+    return ((shift + 1) * HeapMemMP_SUBCLASSES +
+            (units >> shift) - HeapMemMP_SUBCLASSES);
+}
+
+/*
+ *  ======== HeapMemMP_sizeClass ========
+ *  Class a free block of size bytes is kept in
+ */
+static inline UInt HeapMemMP_sizeClass(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        SizeT size)
+{
+    return (HeapMemMP_unitClass((Bits32)(size / obj->minAlign)));
+}
+
+/*
+ *  ======== HeapMemMP_fitClass ========
+ *  First class whose blocks all have at least size bytes
+ */
+static inline UInt HeapMemMP_fitClass(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        SizeT size)
+{
+    Bits32 units = (Bits32)(size / obj->minAlign);
+
+    /* Round up to the next class boundary */
+    if (units >= HeapMemMP_SUBCLASSES) {
+        units += ((Bits32)1 << (HeapMemMP_log2(units) -
+                ti_sdo_ipc_heaps_HeapMemMP_SUBCLASSBITS)) - 1;
+    }
+
+    return (HeapMemMP_unitClass(units));
+}
+
+/*
+ *  ======== HeapMemMP_findClass ========
+ *  First non-empty class from cls on, NUMCLASSES if there is none
+ */
+static UInt HeapMemMP_findClass(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        UInt cls)
+{
+    ti_sdo_ipc_heaps_HeapMemMP_Attrs *attrs = obj->attrs;
+    Bits32 mask;
+    UInt word;
+
+    if (cls >= ti_sdo_ipc_heaps_HeapMemMP_NUMCLASSES) {
+        return (ti_sdo_ipc_heaps_HeapMemMP_NUMCLASSES);
+    }
+
+    word = cls / 32;
+
+    if (obj->cacheEnabled) {
+        Cache_inv(&attrs->classMask[word], sizeof(Bits32), Cache_Type_ALL,
+                TRUE);
+    }
+
+    /* A class in the same word? */
+    mask = attrs->classMask[word] & ~(((Bits32)1 << (cls % 32)) - 1);
+    if (mask == 0) {
+        if (obj->cacheEnabled) {
+            Cache_inv(&attrs->wordMask, sizeof(Bits32), Cache_Type_ALL, TRUE);
+        }
+
+        /* The first class of the next non-empty word */
+        mask = (word + 1 < 32) ?
+            attrs->wordMask & ~(((Bits32)1 << (word + 1)) - 1) : 0;
+        if (mask == 0) {
+            return (ti_sdo_ipc_heaps_HeapMemMP_NUMCLASSES);
+        }
+
+        word = HeapMemMP_log2(mask & (~mask + 1));
+
+        if (obj->cacheEnabled) {
+            Cache_inv(&attrs->classMask[word], sizeof(Bits32),
+                    Cache_Type_ALL, TRUE);
+        }
+        mask = attrs->classMask[word];
+    }
+
+    return (word * 32 + HeapMemMP_log2(mask & (~mask + 1)));
+}
+
+/*
+ *  ======== HeapMemMP_getHead ========
+ */
+static inline ti_sdo_ipc_heaps_HeapMemMP_Header *HeapMemMP_getHead(
+        ti_sdo_ipc_heaps_HeapMemMP_Object *obj, UInt cls)
+{
+    if (obj->cacheEnabled) {
+        Cache_inv(&obj->attrs->freeList[cls], sizeof(SharedRegion_SRPtr),
+                Cache_Type_ALL, TRUE);
+    }
+
+    return (SharedRegion_getPtr(obj->attrs->freeList[cls]));
+}
+
+/*
+ *  ======== HeapMemMP_setHead ========
+ *  Set the head of a list and the masks to match
+ */
+static Void HeapMemMP_setHead(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        UInt cls, SharedRegion_SRPtr head)
+{
+    ti_sdo_ipc_heaps_HeapMemMP_Attrs *attrs = obj->attrs;
+    Bits32 *classMask = &attrs->classMask[cls / 32];
+    Bits32 bit = (Bits32)1 << (cls % 32);
+    Bits32 oldMask;
+
+    attrs->freeList[cls] = head;
+    if (obj->cacheEnabled) {
+        Cache_wbInv(&attrs->freeList[cls], sizeof(SharedRegion_SRPtr),
+                Cache_Type_ALL, FALSE);
+        Cache_inv(classMask, sizeof(Bits32), Cache_Type_ALL, TRUE);
+    }
+
+    oldMask = *classMask;
+    if (head == ti_sdo_ipc_SharedRegion_INVALIDSRPTR) {
+        *classMask &= ~bit;
+    }
+    else {
+        *classMask |= bit;
+    }
+
+    if (*classMask == oldMask) {
+        return;
+    }
+
+    if (obj->cacheEnabled) {
+        Cache_wbInv(classMask, sizeof(Bits32), Cache_Type_ALL, FALSE);
+    }
+
+    /* Only the first or last class of a word changes wordMask */
+    if ((oldMask == 0) || (*classMask == 0)) {
+        if (obj->cacheEnabled) {
+            Cache_inv(&attrs->wordMask, sizeof(Bits32), Cache_Type_ALL, TRUE);
+        }
+        attrs->wordMask ^= (Bits32)1 << (cls / 32);
+        if (obj->cacheEnabled) {
+            Cache_wbInv(&attrs->wordMask, sizeof(Bits32), Cache_Type_ALL,
+                    FALSE);
+        }
+    }
+}
+
+/*
+ *  ======== HeapMemMP_mapSize ========
+ *  Size of the bitmap for a buffer of bufSize bytes
+ */
+static inline SizeT HeapMemMP_mapSize(SizeT bufSize, SizeT minAlign)
+{
+    return (((bufSize / minAlign + 31) / 32) * sizeof(Bits32));
+}
+
+/*
+ *  ======== HeapMemMP_getMark ========
+ */
+static Bool HeapMemMP_getMark(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        SizeT unit)
+{
+    Bits32 *word = &obj->map[unit / 32];
+
+    if (obj->cacheEnabled) {
+        Cache_inv(word, sizeof(Bits32), Cache_Type_ALL, TRUE);
+    }
+
+    return ((*word & ((Bits32)1 << (unit % 32))) != 0);
+}
+
+/*
+ *  ======== HeapMemMP_setMark ========
+ */
+static Void HeapMemMP_setMark(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        SizeT unit, Bool mark)
+{
+    Bits32 *word = &obj->map[unit / 32];
+
+    if (obj->cacheEnabled) {
+        Cache_inv(word, sizeof(Bits32), Cache_Type_ALL, TRUE);
+    }
+
+    if (mark) {
+        *word |= (Bits32)1 << (unit % 32);
+    }
+    else {
+        *word &= ~((Bits32)1 << (unit % 32));
+    }
+
+    if (obj->cacheEnabled) {
+        Cache_wbInv(word, sizeof(Bits32), Cache_Type_ALL, FALSE);
+    }
+}
+
+/*
+ *  ======== HeapMemMP_markBlock ========
+ *  Set or clear the marks of the first and the last unit of a block
+ */
+static Void HeapMemMP_markBlock(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        ti_sdo_ipc_heaps_HeapMemMP_Header *header, SizeT size, Bool mark)
+{
+    SizeT first = ((Char *)header - obj->buf) / obj->minAlign;
+
+    HeapMemMP_setMark(obj, first, mark);
+    HeapMemMP_setMark(obj, first + size / obj->minAlign - 1, mark);
+}
+
+/*
+ *  ======== HeapMemMP_insert ========
+ *  Put a block at the head of the free list of its class
+ */
+static Void HeapMemMP_insert(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        ti_sdo_ipc_heaps_HeapMemMP_Header *header, SizeT size)
+{
+    ti_sdo_ipc_heaps_HeapMemMP_Header *nextHeader;
+    Bits32 *end;
+    UInt cls;
+
+    cls = HeapMemMP_sizeClass(obj, size);
+    nextHeader = HeapMemMP_getHead(obj, cls);
+
+    header->next = SharedRegion_getSRPtr(nextHeader, obj->regionId);
+    header->prev = ti_sdo_ipc_SharedRegion_INVALIDSRPTR;
+    header->size = size;
+
+    /* For a one unit block of sizeof(Header) this is header->pad */
+    end = (Bits32 *)((Char *)header + size - sizeof(Bits32));
+    *end = size;
+
+    if (obj->cacheEnabled) {
+        Cache_wbInv(header, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
+                Cache_Type_ALL, FALSE);
+        Cache_wbInv(end, sizeof(Bits32), Cache_Type_ALL, FALSE);
+    }
+
+    if (nextHeader != NULL) {
+        if (obj->cacheEnabled) {
+            Cache_inv(nextHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
+                    Cache_Type_ALL, TRUE);
+        }
+        nextHeader->prev = SharedRegion_getSRPtr(header, obj->regionId);
+        if (obj->cacheEnabled) {
+            Cache_wbInv(nextHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
+                    Cache_Type_ALL, FALSE);
+        }
+    }
+
+    HeapMemMP_setHead(obj, cls, SharedRegion_getSRPtr(header, obj->regionId));
+
+    HeapMemMP_markBlock(obj, header, size, TRUE);
+}
+
+/*
+ *  ======== HeapMemMP_remove ========
+ *  Take a block off its free list.  The header must be invalidated.
+ */
+static Void HeapMemMP_remove(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        ti_sdo_ipc_heaps_HeapMemMP_Header *header)
+{
+    ti_sdo_ipc_heaps_HeapMemMP_Header *prevHeader, *nextHeader;
+
+    prevHeader = SharedRegion_getPtr(header->prev);
+    nextHeader = SharedRegion_getPtr(header->next);
+
+    if (prevHeader != NULL) {
+        if (obj->cacheEnabled) {
+            Cache_inv(prevHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
+                    Cache_Type_ALL, TRUE);
+        }
+        prevHeader->next = header->next;
+        if (obj->cacheEnabled) {
+            Cache_wbInv(prevHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
+                    Cache_Type_ALL, FALSE);
+        }
+    }
+    else {
+        /* Internal Assert that the block is the head of its list */
+        Assert_isTrue(HeapMemMP_getHead(obj,
+                HeapMemMP_sizeClass(obj, header->size)) == header,
+                ti_sdo_ipc_Ipc_A_internal);
+
+        HeapMemMP_setHead(obj, HeapMemMP_sizeClass(obj, header->size),
+                header->next);
+    }
+
+    if (nextHeader != NULL) {
+        if (obj->cacheEnabled) {
+            Cache_inv(nextHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
+                    Cache_Type_ALL, TRUE);
+        }
+        nextHeader->prev = header->prev;
+        if (obj->cacheEnabled) {
+            Cache_wbInv(nextHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
+                    Cache_Type_ALL, FALSE);
+        }
+    }
+
+    HeapMemMP_markBlock(obj, header, header->size, FALSE);
+}
+
+/*
+ *  ======== HeapMemMP_alignOffset ========
+ *  Distance from header to the first address aligned on align
+ */
+static inline SizeT HeapMemMP_alignOffset(
+        ti_sdo_ipc_heaps_HeapMemMP_Header *header, SizeT align)
+{
+    SizeT offset;
+
+    offset = (Memory_Size)header & (align - 1);
+    if (offset) {
+        offset = align - offset;
+    }
+
+    return (offset);
+}
+
+/*
+ *  ======== HeapMemMP_searchClass ========
+ *  First of at most maxLooks blocks of class cls that fits adjSize aligned
+ *  on adjAlign, NULL if none of them does.  Returns the alignment offset
+ *  of the block in offset.
+ */
+static ti_sdo_ipc_heaps_HeapMemMP_Header *HeapMemMP_searchClass(
+        ti_sdo_ipc_heaps_HeapMemMP_Object *obj, UInt cls, SizeT adjSize,
+        SizeT adjAlign, UInt maxLooks, SizeT *offset)
+{
+    ti_sdo_ipc_heaps_HeapMemMP_Header *curHeader;
+
+    curHeader = HeapMemMP_getHead(obj, cls);
+
+    while ((curHeader != NULL) && (maxLooks-- > 0)) {
+        if (obj->cacheEnabled) {
+            Cache_inv(curHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
+                    Cache_Type_ALL, TRUE);
+        }
+
+        *offset = HeapMemMP_alignOffset(curHeader, adjAlign);
+
+        /* big enough? */
+        if (curHeader->size >= (adjSize + *offset)) {
+            return (curHeader);
+        }
+
+        curHeader = SharedRegion_getPtr(curHeader->next);
+    }
+
+    return (NULL);
+}
+
+/*
+ *  ======== HeapMemMP_allocBlock ========
+ *  Take a block of adjSize aligned on adjAlign, both multiples of minAlign,
+ *  off the free lists.  Returns NULL if no free block fits.
+ */
+static Ptr HeapMemMP_allocBlock(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        SizeT adjSize, SizeT adjAlign)
+{
+    ti_sdo_ipc_heaps_HeapMemMP_Header *newHeader, *curHeader;
+    Char *allocAddr;
+    Memory_Size curSize, needSize;
+    SizeT remainSize; /* free memory after allocated memory */
+    SizeT offset;
+    UInt cls, fitCls;
+
+    curHeader = NULL;
+    offset = 0;
+
+    /* Size of a block that fits wherever the alignment falls */
+    needSize = adjSize + adjAlign - obj->minAlign;
+    fitCls = HeapMemMP_fitClass(obj, needSize);
+
+    /*
+     *  Some blocks of the classes below fitCls fit too.  Look at the
+     *  first few of each before splitting a larger block.
+     */
+    for (cls = HeapMemMP_sizeClass(obj, adjSize);
+            (cls < fitCls) && (curHeader == NULL); cls++) {
+        curHeader = HeapMemMP_searchClass(obj, cls, adjSize, adjAlign,
+                HeapMemMP_MAXLOOKS, &offset);
+    }
+
+    if (curHeader == NULL) {
+        cls = HeapMemMP_findClass(obj, fitCls);
+        if (cls < ti_sdo_ipc_heaps_HeapMemMP_NUMCLASSES) {
+            /* Any block of this class fits, take the first one */
+            curHeader = HeapMemMP_getHead(obj, cls);
+            if (obj->cacheEnabled) {
+                Cache_inv(curHeader,
+                        sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
+                        Cache_Type_ALL, TRUE);
+            }
+            offset = HeapMemMP_alignOffset(curHeader, adjAlign);
+        }
+    }
+
+    /*
+     *  Only the rest of the blocks in the classes below can still fit.
+     *  They are searched first-fit, which only happens when the heap is
+     *  nearly exhausted.
+     */
+    for (cls = HeapMemMP_sizeClass(obj, adjSize);
+            (cls < fitCls) && (curHeader == NULL); cls++) {
+        curHeader = HeapMemMP_searchClass(obj, cls, adjSize, adjAlign,
+                (UInt)~0, &offset);
+    }
+
+    if (curHeader == NULL) {
+        return (NULL);
+    }
+
+    /* Internal Assert that offset is a multiple of obj->minAlign */
+    Assert_isTrue(((offset & (obj->minAlign - 1)) == 0),
+            ti_sdo_ipc_Ipc_A_internal);
+
+    curSize = curHeader->size;
+
+    /* Set the pointer that will be returned. Alloc from front */
+    allocAddr = (Char *)((Memory_Size)curHeader + offset);
+
+    /*
+     *  Determine the remaining memory after the allocated block.
+     *  Note: this cannot be negative because the block fits.
+     */
+    remainSize = curSize - adjSize - offset;
+
+    /* Internal Assert that remainSize is a multiple of obj->minAlign */
+    Assert_isTrue(((remainSize & (obj->minAlign - 1)) == 0),
+                   ti_sdo_ipc_Ipc_A_internal);
+
+    HeapMemMP_remove(obj, curHeader);
+
+    /*
+     *  Put the memory before (due to alignment requirements) and after
+     *  the allocated block back on the free lists.  Note: no need to
+     *  coalesce, the neighbours of the block just taken weren't free.
+     */
+    if (offset) {
+        HeapMemMP_insert(obj, curHeader, offset);
+    }
+
+    if (remainSize) {
+        newHeader = (ti_sdo_ipc_heaps_HeapMemMP_Header *)
+            ((Memory_Size)allocAddr + adjSize);
+        HeapMemMP_insert(obj, newHeader, remainSize);
+    }
+
+    return ((Ptr)allocAddr);
+}
+
+/*
+ *  ======== HeapMemMP_freeBlock ========
+ *  Put a block of size, a multiple of minAlign, back on the free lists,
+ *  joined with the free blocks next to it.
+ */
+static Void HeapMemMP_freeBlock(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        Ptr addr, SizeT size)
+{
+    ti_sdo_ipc_heaps_HeapMemMP_Header *newHeader, *prevHeader, *nextHeader;
+    Bits32 *prevEnd;
+    SizeT first, last;
+
+    newHeader = (ti_sdo_ipc_heaps_HeapMemMP_Header *)addr;
+
+    /* Make sure the entire buffer is in the range of the heap. */
+    Assert_isTrue((((SizeT)newHeader >= (SizeT)obj->buf) &&
+                   ((SizeT)newHeader + size <=
+                    (SizeT)obj->buf + obj->bufSize)),
+                   ti_sdo_ipc_heaps_HeapMemMP_A_invalidFree);
+
+    first = ((Char *)newHeader - obj->buf) / obj->minAlign;
+    last = first + size / obj->minAlign - 1;
+
+    /*
+     *  Make sure the buffer isn't the start or end of a free block. Not all
+     *  double or overlapping frees are detectable, but it is worth a shot.
+     */
+    Assert_isTrue(!HeapMemMP_getMark(obj, first) &&
+                  !HeapMemMP_getMark(obj, last),
+                  ti_sdo_ipc_heaps_HeapMemMP_A_invalidFree);
+
+    /* Join with upper block */
+    if ((last + 1 < obj->bufSize / obj->minAlign) &&
+        HeapMemMP_getMark(obj, last + 1)) {
+        nextHeader = (ti_sdo_ipc_heaps_HeapMemMP_Header *)
+            ((Memory_Size)newHeader + size);
+        if (obj->cacheEnabled) {
+            Cache_inv(nextHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
+                    Cache_Type_ALL, TRUE);
+        }
+        HeapMemMP_remove(obj, nextHeader);
+        size += nextHeader->size;
+    }
+
+    /* Join with lower block, whose size is in its last Bits32 */
+    if ((first > 0) && HeapMemMP_getMark(obj, first - 1)) {
+        prevEnd = (Bits32 *)((Memory_Size)newHeader - sizeof(Bits32));
+        if (obj->cacheEnabled) {
+            Cache_inv(prevEnd, sizeof(Bits32), Cache_Type_ALL, TRUE);
+        }
+        prevHeader = (ti_sdo_ipc_heaps_HeapMemMP_Header *)
+            ((Memory_Size)newHeader - *prevEnd);
+        if (obj->cacheEnabled) {
+            Cache_inv(prevHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
+                    Cache_Type_ALL, TRUE);
+        }
+        HeapMemMP_remove(obj, prevHeader);
+        size += prevHeader->size;
+        newHeader = prevHeader;
+    }
+
+    HeapMemMP_insert(obj, newHeader, size);
+}
+
+/*
+ *************************************************************************
+ *                       Local cache functions
+ *************************************************************************
+ */
+
+/*
+ * With HeapMemMP.localCacheSize set, each processor keeps freed blocks of
+ * up to NUMCACHESIZES different sizes, localCacheSize blocks of each, in
+ * obj->localCache.  Slot i holds the blocks of size obj->cachedSize[i]
+ * from obj->localCache[i * localCacheSize] on, and is taken by the first
+ * size freed while it is empty.  Only requests that need no more than
+ * minAlign alignment are served from it.
+ *
+ * alloc() and free() use the cache with only interrupts disabled and go
+ * to the shared heap for half of a slot at a time, so one gate acquisition
+ * is paid for several blocks.
+ */
+
+#define HeapMemMP_CACHESIZE ti_sdo_ipc_heaps_HeapMemMP_localCacheSize
+#define HeapMemMP_BATCH ((HeapMemMP_CACHESIZE + 1) / 2)
+
+/*
+ *  ======== HeapMemMP_popCached ========
+ *  Take a block of size from the local cache, NULL if it has none
+ */
+static Ptr HeapMemMP_popCached(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        SizeT size)
+{
+    Ptr block = NULL;
+    UInt hwiKey;
+    UInt i;
+
+    hwiKey = Hwi_disable();
+
+    for (i = 0; i < ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES; i++) {
+        if (obj->numCached[i] > 0 && obj->cachedSize[i] == size) {
+            block = obj->localCache[i * HeapMemMP_CACHESIZE +
+                    --obj->numCached[i]];
+            break;
+        }
+    }
+
+    Hwi_restore(hwiKey);
+
+    return (block);
+}
+
+/*
+ *  ======== HeapMemMP_pushCached ========
+ *  Put a block of size in the local cache.  Returns FALSE if the slot of
+ *  this size is full, or there is none and no empty slot to take.
+ */
+static Bool HeapMemMP_pushCached(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        Ptr block, SizeT size)
+{
+    UInt slot = ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES;
+    Bool cached = FALSE;
+    UInt hwiKey;
+    UInt i;
+
+    hwiKey = Hwi_disable();
+
+    for (i = 0; i < ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES; i++) {
+        if (obj->numCached[i] > 0 && obj->cachedSize[i] == size) {
+            slot = i;
+            break;
+        }
+        if (obj->numCached[i] == 0 &&
+            slot == ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES) {
+            slot = i;
+        }
+    }
+
+    if (slot < ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES &&
+        obj->numCached[slot] < HeapMemMP_CACHESIZE) {
+        obj->cachedSize[slot] = size;
+        obj->localCache[slot * HeapMemMP_CACHESIZE +
+                obj->numCached[slot]++] = block;
+        cached = TRUE;
+    }
+
+    Hwi_restore(hwiKey);
+
+    return (cached);
+}
+
+/*
+ *  ======== HeapMemMP_victim ========
+ *  Pick the blocks to return when a block of size didn't fit in the local
+ *  cache: half of the slot of that size if there is one, otherwise all of
+ *  the first slot, so that it can be taken by the new size.
+ */
+static SizeT HeapMemMP_victim(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        SizeT size, UInt *num)
+{
+    UInt hwiKey;
+    UInt i;
+
+    hwiKey = Hwi_disable();
+
+    for (i = 0; i < ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES; i++) {
+        if (obj->numCached[i] > 0 && obj->cachedSize[i] == size) {
+            break;
+        }
+    }
+
+    if (i < ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES) {
+        *num = HeapMemMP_BATCH;
+    }
+    else {
+        size = obj->cachedSize[0];
+        *num = obj->numCached[0];
+    }
+
+    Hwi_restore(hwiKey);
+
+    return (size);
+}
+
+/*
+ *  ======== HeapMemMP_flushCached ========
+ *  Return up to num blocks of size from the local cache to the free
+ *  lists.  Must be called with the gate entered.
+ */
+static Void HeapMemMP_flushCached(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
+        SizeT size, UInt num)
+{
+    Ptr block;
+
+    while (num-- > 0) {
+        block = HeapMemMP_popCached(obj, size);
+        if (block == NULL) {
+            break;
+        }
+
+        if (obj->cacheEnabled) {
+            Cache_inv(block, size, Cache_Type_ALL, FALSE);
+        }
+
+        HeapMemMP_freeBlock(obj, block, size);
+    }
+}
+
 /*
  *************************************************************************
  *                       Common Header Functions
@@ -300,26 +1035,39 @@ Void HeapMemMP_restore(HeapMemMP_Handle handle)
 {
     ti_sdo_ipc_heaps_HeapMemMP_Object *obj =
             (ti_sdo_ipc_heaps_HeapMemMP_Object *)handle;
+    UInt cls;
 
-    ti_sdo_ipc_heaps_HeapMemMP_Header *begHeader;
+    /* Blocks in the local cache are part of the free block below */
+    for (cls = 0; cls < ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES; cls++) {
+        obj->numCached[cls] = 0;
+    }
 
-    /*
-     *  Fill in the top of the memory block
-     *  next: pointer will be NULL (end of the list)
-     *  size: size of this block
-     *  NOTE: no need to Cache_inv because obj->attrs->bufPtr should be const
-     */
-    begHeader = (ti_sdo_ipc_heaps_HeapMemMP_Header *)obj->buf;
-    begHeader->next = ti_sdo_ipc_SharedRegion_INVALIDSRPTR;
-    begHeader->size = obj->bufSize;
+    /* Empty all of the free lists and clear the bitmap */
+    for (cls = 0; cls < ti_sdo_ipc_heaps_HeapMemMP_NUMCLASSES; cls++) {
+        obj->attrs->freeList[cls] = ti_sdo_ipc_SharedRegion_INVALIDSRPTR;
+    }
+    for (cls = 0; cls < ti_sdo_ipc_heaps_HeapMemMP_NUMCLASSES / 32; cls++) {
+        obj->attrs->classMask[cls] = 0;
+    }
+    obj->attrs->wordMask = 0;
 
-    obj->attrs->head.next = obj->attrs->bufPtr;
     if (obj->cacheEnabled) {
-        Cache_wbInv(&(obj->attrs->head),
-                sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header), Cache_Type_ALL,
-                FALSE);
-        Cache_wbInv(begHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
-                Cache_Type_ALL, TRUE);
+        Cache_wbInv(obj->attrs, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Attrs),
+                Cache_Type_ALL, FALSE);
+    }
+
+    memset(obj->map, 0, HeapMemMP_mapSize(obj->bufSize, obj->minAlign));
+    if (obj->cacheEnabled) {
+        Cache_wbInv(obj->map, HeapMemMP_mapSize(obj->bufSize, obj->minAlign),
+                Cache_Type_ALL, FALSE);
+    }
+
+    /* The whole buffer is a single free block */
+    HeapMemMP_insert(obj, (ti_sdo_ipc_heaps_HeapMemMP_Header *)obj->buf,
+            obj->bufSize);
+
+    if (obj->cacheEnabled) {
+        Cache_wait();
     }
 }
 
@@ -344,7 +1092,7 @@ SizeT HeapMemMP_sharedMemReq(const HeapMemMP_Params *params)
 
     Assert_isTrue(regionId != SharedRegion_INVALIDREGIONID,
             ti_sdo_ipc_Ipc_A_internal);
-    if (regionId != SharedRegion_INVALIDREGIONID) {
+    if (regionId == SharedRegion_INVALIDREGIONID) {
         return 0;
     }
 
@@ -357,6 +1105,10 @@ SizeT HeapMemMP_sharedMemReq(const HeapMemMP_Params *params)
     /* Add size of HeapBufMP Attrs */
     memReq = _Ipc_roundup(sizeof(ti_sdo_ipc_heaps_HeapMemMP_Attrs), minAlign);
 
+    /* Add the size of the bitmap */
+    memReq += _Ipc_roundup(HeapMemMP_mapSize(params->sharedBufSize,
+            minAlign), minAlign);
+
     /* Add the buffer size */
     memReq += params->sharedBufSize;
 
@@ -383,6 +1135,7 @@ Int ti_sdo_ipc_heaps_HeapMemMP_Instance_init(
     SharedRegion_SRPtr sharedShmBase;
     Ptr localAddr;
     Int status;
+    UInt i;
 
     /* Assert that sharedBufSize is sufficient */
     Assert_isTrue(params->openFlag == TRUE ||
@@ -391,6 +1144,19 @@ Int ti_sdo_ipc_heaps_HeapMemMP_Instance_init(
 
     obj->nsKey          = NULL;
     obj->allocSize      = 0;
+    obj->localCache     = NULL;
+    for (i = 0; i < ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES; i++) {
+        obj->numCached[i] = 0;
+    }
+
+    if (HeapMemMP_CACHESIZE != 0) {
+        obj->localCache = Memory_alloc(NULL,
+                ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES *
+                HeapMemMP_CACHESIZE * sizeof(Ptr), 0, eb);
+        if (obj->localCache == NULL) {
+            return (7);
+        }
+    }
 
     if (params->openFlag == TRUE) {
         /* Opening the gate */
@@ -400,7 +1166,9 @@ Int ti_sdo_ipc_heaps_HeapMemMP_Instance_init(
         /* No need to Cache_inv- already done in openByAddr() */
         obj->buf            = (Char *)SharedRegion_getPtr(
                                     obj->attrs->bufPtr);
-        obj->bufSize        = obj->attrs->head.size;
+        obj->map            = (Bits32 *)SharedRegion_getPtr(
+                                    obj->attrs->mapPtr);
+        obj->bufSize        = obj->attrs->bufSize;
         obj->objType        = ti_sdo_ipc_Ipc_ObjType_OPENDYNAMIC;
         obj->regionId       = SharedRegion_getId(obj->buf);
         obj->cacheEnabled   = SharedRegion_isCacheEnabled(obj->regionId);
@@ -466,9 +1234,7 @@ Int ti_sdo_ipc_heaps_HeapMemMP_Instance_init(
 
         obj->objType    = ti_sdo_ipc_Ipc_ObjType_CREATEDYNAMIC;
 
-        /* obj->buf will get alignment-adjusted in postInit */
-        obj->buf        = (Ptr)((UArg)params->sharedAddr +
-                          sizeof(ti_sdo_ipc_heaps_HeapMemMP_Attrs));
+        /* obj->map and obj->buf are placed after the attrs in postInit */
         obj->attrs     = (ti_sdo_ipc_heaps_HeapMemMP_Attrs *)params->sharedAddr;
     }
 
@@ -510,6 +1276,31 @@ Int ti_sdo_ipc_heaps_HeapMemMP_Instance_init(
 Void ti_sdo_ipc_heaps_HeapMemMP_Instance_finalize(
         ti_sdo_ipc_heaps_HeapMemMP_Object *obj, Int status)
 {
+    IArg key;
+    UInt i;
+
+    if (obj->localCache != NULL) {
+        /* Return the locally cached blocks while the gate is still open */
+        if (obj->attrs != NULL && obj->gate != NULL) {
+            key = GateMP_enter((GateMP_Handle)obj->gate);
+
+            for (i = 0; i < ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES; i++) {
+                HeapMemMP_flushCached(obj, obj->cachedSize[i],
+                        obj->numCached[i]);
+            }
+
+            if (obj->cacheEnabled) {
+                Cache_wait();
+            }
+
+            GateMP_leave((GateMP_Handle)obj->gate, key);
+        }
+
+        Memory_free(NULL, obj->localCache,
+                ti_sdo_ipc_heaps_HeapMemMP_NUMCACHESIZES *
+                HeapMemMP_CACHESIZE * sizeof(Ptr));
+    }
+
     if (obj->objType & (ti_sdo_ipc_Ipc_ObjType_CREATEDYNAMIC |
                         ti_sdo_ipc_Ipc_ObjType_CREATEDYNAMIC_REGION)) {
         /* Remove entry from NameServer */
@@ -547,21 +1338,6 @@ Void ti_sdo_ipc_heaps_HeapMemMP_Instance_finalize(
     }
 }
 
-/*
- * NOTE:
- * Embedded within the code for HeapMemMP_alloc and HeapMemMP_free are comments
- * that can be used to match a shared memory reference with its required
- * cache call.  This is done because the code for alloc and free is complex.
- * These two-character comments indicate
- * 1) The type of cache operation that is being performed {A, B}
- *    A = Cache_inv
- *    B = Cache_wbInv
- * 2) A numerical id of the specific cache call that is performed.
- *    1, 2, 3
- *    For example, the comment 'A2' indicates that the corresponding cache call
- *    is a Cache_inv operation identified by the number '2'
- */
-
 /*
  *  ======== ti_sdo_ipc_heaps_HeapMemMP_alloc ========
  *  HeapMemMP is implemented such that all of the memory and blocks it works
@@ -581,16 +1357,22 @@ Void ti_sdo_ipc_heaps_HeapMemMP_Instance_finalize(
  *    1. Are aligned on a multiple of obj->minAlign
  *    2. Have a size that is a multiple of obj->minAlign
  *
+ *  Every block of the fit class of adjSize plus the largest alignment
+ *  offset, and of the classes above it, is large enough.  The first
+ *  non-empty one of these classes gives a block without looking at more
+ *  than one header, after the first MAXLOOKS blocks of each class below
+ *  it that may fit were checked.  Only when there is none are all of the
+ *  lists of the classes below searched first-fit.
  */
 Ptr ti_sdo_ipc_heaps_HeapMemMP_alloc(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
     SizeT reqSize, SizeT reqAlign, Error_Block *eb)
 {
     IArg key;
-    ti_sdo_ipc_heaps_HeapMemMP_Header *prevHeader, *newHeader, *curHeader;
     Char *allocAddr;
-    Memory_Size curSize, adjSize;
-    SizeT remainSize; /* free memory after allocated memory */
+    Ptr extra;
+    Memory_Size adjSize;
     SizeT adjAlign, offset;
+    UInt num;
 
     /* Assert that requested align is a power of 2 */
     Assert_isTrue((reqAlign & (reqAlign - 1)) == 0,
@@ -617,160 +1399,47 @@ Ptr ti_sdo_ipc_heaps_HeapMemMP_alloc(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
         adjAlign = obj->minAlign;
     }
 
-    /* No need to Cache_inv Attrs- 'head' should be constant */
-    prevHeader = &(obj->attrs->head);
+    /* Blocks that need no more than minAlign may be in the local cache */
+    num = 1;
+    if (obj->localCache != NULL && adjAlign == obj->minAlign) {
+        allocAddr = HeapMemMP_popCached(obj, adjSize);
+        if (allocAddr != NULL) {
+            return (allocAddr);
+        }
+        num += HeapMemMP_BATCH;
+    }
 
     key = GateMP_enter((GateMP_Handle)obj->gate);
 
-    /*
-     *  The block will be allocated from curHeader. Maintain a pointer to
-     *  prevHeader so prevHeader->next can be updated after the alloc.
-     */
-    if (obj->cacheEnabled) {
-        Cache_inv(prevHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
-                  Cache_Type_ALL, TRUE); /* A1 */
-    }
-    curHeader = (ti_sdo_ipc_heaps_HeapMemMP_Header *)
-        SharedRegion_getPtr(prevHeader->next); /* A1 */
+    allocAddr = HeapMemMP_allocBlock(obj, adjSize, adjAlign);
 
-    /* Loop over the free list. */
-    while (curHeader != NULL) {
-        /* Invalidate curHeader */
-        if (obj->cacheEnabled) {
-            Cache_inv(curHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
-                      Cache_Type_ALL, TRUE); /* A2 */
+    /* Refill the local cache with blocks of the same size */
+    while (allocAddr != NULL && --num > 0) {
+        extra = HeapMemMP_allocBlock(obj, adjSize, adjAlign);
+        if (extra == NULL) {
+            break;
         }
-        curSize = curHeader->size;
-
-        /*
-         *  Determine the offset from the beginning to make sure
-         *  the alignment request is honored.
-         */
-        offset = (Memory_Size)curHeader & (adjAlign - 1);
-        if (offset) {
-            offset = adjAlign - offset;
+        if (!HeapMemMP_pushCached(obj, extra, adjSize)) {
+            HeapMemMP_freeBlock(obj, extra, adjSize);
+            break;
         }
+    }
 
-        /* Internal Assert that offset is a multiple of obj->minAlign */
-        Assert_isTrue(((offset & (obj->minAlign - 1)) == 0),
-                ti_sdo_ipc_Ipc_A_internal);
-
-        /* big enough? */
-        if (curSize >= (adjSize + offset)) {
-
-            /* Set the pointer that will be returned. Alloc from front */
-            allocAddr = (Char *)((Memory_Size)curHeader + offset);
-
-            /*
-             *  Determine the remaining memory after the allocated block.
-             *  Note: this cannot be negative because of above comparison.
-             */
-            remainSize = curSize - adjSize - offset;
-
-            /* Internal Assert that remainSize is a multiple of obj->minAlign */
-            Assert_isTrue(((remainSize & (obj->minAlign - 1)) == 0),
-                           ti_sdo_ipc_Ipc_A_internal);
-
-            /*
-             *  If there is memory at the beginning (due to alignment
-             *  requirements), maintain it in the list.
-             *
-             *  offset and remainSize must be multiples of
-             *  sizeof(HeapMemMP_Header). Therefore the address of the newHeader
-             *  below must be a multiple of the sizeof(HeapMemMP_Header), thus
-             *  maintaining the requirement.
-             */
-            if (offset) {
-
-                /* Adjust the curHeader size accordingly */
-                curHeader->size = offset; /* B2 */
-                /* Cache wb at end of this if block */
-
-                /*
-                 *  If there is remaining memory, add into the free list.
-                 *  Note: no need to coalesce and we have HeapMemMP locked so
-                 *        it is safe.
-                 */
-                if (remainSize) {
-                    newHeader = (ti_sdo_ipc_heaps_HeapMemMP_Header *)
-                        ((Memory_Size)allocAddr + adjSize);
-
-                    /* curHeader has been inv at top of 'while' loop */
-                    newHeader->next = curHeader->next;  /* B1 */
-                    newHeader->size = remainSize;       /* B1 */
-                    if (obj->cacheEnabled) {
-                        /* Writing back curHeader will cache-wait */
-                        Cache_wbInv(newHeader,
-                                sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
-                                Cache_Type_ALL, FALSE); /* B1 */
-                    }
-
-                    curHeader->next = SharedRegion_getSRPtr(newHeader,
-                                                            obj->regionId);
-                }
-                /* Write back (and invalidate) newHeader and curHeader */
-                if (obj->cacheEnabled) {
-                    /* B2 */
-                    Cache_wbInv(curHeader,
-                            sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
-                            Cache_Type_ALL, TRUE);
-                }
-            }
-            else {
-                /*
-                 *  If there is any remaining, link it in,
-                 *  else point to the next free block.
-                 *  Note: no need to coalesce and we have HeapMemMP locked so
-                 *        it is safe.
-                 */
-                if (remainSize) {
-                    newHeader = (ti_sdo_ipc_heaps_HeapMemMP_Header *)
-                        ((Memory_Size)allocAddr + adjSize);
-
-                    newHeader->next  = curHeader->next; /* A2, B3  */
-                    newHeader->size  = remainSize;      /* B3      */
-
-                    if (obj->cacheEnabled) {
-                        /* Writing back prevHeader will cache-wait */
-                        Cache_wbInv(newHeader,
-                                sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
-                                Cache_Type_ALL, FALSE); /* B3 */
-                    }
-
-                    /* B4 */
-                    prevHeader->next = SharedRegion_getSRPtr(newHeader,
-                                                             obj->regionId);
-                }
-                else {
-                    /* curHeader has been inv at top of 'while' loop */
-                    prevHeader->next = curHeader->next; /* A2, B4 */
-                }
-
-                if (obj->cacheEnabled) {
-                    /* B4 */
-                    Cache_wbInv(prevHeader,
-                            sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
-                            Cache_Type_ALL, TRUE);
-                }
-            }
-
-            GateMP_leave((GateMP_Handle)obj->gate, key);
-
-            /* Success, return the allocated memory */
-            return ((Ptr)allocAddr);
-        }
-        else {
-            prevHeader = curHeader;
-            curHeader = SharedRegion_getPtr(curHeader->next);
-        }
+    if (obj->cacheEnabled) {
+        Cache_wait();
     }
 
     GateMP_leave((GateMP_Handle)obj->gate, key);
 
-    Error_raise(eb, ti_sdo_ipc_heaps_HeapMemMP_E_memory, (IArg)obj,
-            (IArg)reqSize);
+    if (allocAddr == NULL) {
+        Error_raise(eb, ti_sdo_ipc_heaps_HeapMemMP_E_memory, (IArg)obj,
+                (IArg)reqSize);
 
-    return (NULL);
+        return (NULL);
+    }
+
+    /* Success, return the allocated memory */
+    return ((Ptr)allocAddr);
 }
 
 /*
@@ -780,8 +1449,9 @@ Void ti_sdo_ipc_heaps_HeapMemMP_free(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
         Ptr addr, SizeT size)
 {
     IArg key;
-    ti_sdo_ipc_heaps_HeapMemMP_Header *curHeader, *newHeader, *nextHeader;
     SizeT offset;
+    SizeT flushSize = 0;
+    UInt num = 0;
 
     /* Assert that 'addr' is cache aligned  */
     Assert_isTrue(((UArg)addr % obj->minAlign == 0),
@@ -793,111 +1463,33 @@ Void ti_sdo_ipc_heaps_HeapMemMP_free(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
         size += obj->minAlign - offset;
     }
 
-    newHeader = (ti_sdo_ipc_heaps_HeapMemMP_Header *)addr;
+    /* Keep the block in the local cache if there is room for its size */
+    if (obj->localCache != NULL) {
+        if (HeapMemMP_pushCached(obj, addr, size)) {
+            return;
+        }
+        flushSize = HeapMemMP_victim(obj, size, &num);
+    }
 
     /*
      *  Invalidate entire buffer being freed to ensure that stale cache
      *  data in block isn't evicted later
      */
     if (obj->cacheEnabled) {
-        Cache_inv(newHeader, size, Cache_Type_ALL, FALSE);
+        Cache_inv(addr, size, Cache_Type_ALL, FALSE);
     }
 
-    /*
-     * obj->attrs never changes, doesn't need Gate protection
-     * and Cache invalidate
-     */
-    curHeader = &(obj->attrs->head);
-
     key = GateMP_enter((GateMP_Handle)obj->gate);
 
-    if (obj->cacheEnabled) {
-        /* A1 */
-        Cache_inv(curHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
-                Cache_Type_ALL, TRUE);
-    }
-
-    nextHeader = SharedRegion_getPtr(curHeader->next);
-
-    /* Make sure the entire buffer is in the range of the heap. */
-    Assert_isTrue((((SizeT)newHeader >= (SizeT)obj->buf) &&
-                   ((SizeT)newHeader + size <=
-                    (SizeT)obj->buf + obj->bufSize)),
-                   ti_sdo_ipc_heaps_HeapMemMP_A_invalidFree);
-
-    /* Go down freelist and find right place for buf */
-    while (nextHeader != NULL && nextHeader < newHeader) {
-        if (obj->cacheEnabled) {
-            Cache_inv(nextHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
-                      Cache_Type_ALL, FALSE); /* A2 */
-        }
-
-        /* Make sure the addr is not in this free block */
-        Assert_isTrue((SizeT)newHeader >= (SizeT)nextHeader + nextHeader->size,
-                       ti_sdo_ipc_heaps_HeapMemMP_A_invalidFree); /* A2 */
-        curHeader = nextHeader;
-        /* A2 */
-        nextHeader = SharedRegion_getPtr(nextHeader->next);
-    }
-
-    /* B2 */
-    newHeader->next = SharedRegion_getSRPtr(nextHeader, obj->regionId);
-    newHeader->size = size;
-
-    /* B1, A1 */
-    curHeader->next = SharedRegion_getSRPtr(newHeader, obj->regionId);
-
-    /* Join contiguous free blocks */
-    if (nextHeader != NULL) {
-        /*
-         *  Verify the free size is not overlapping. Not all cases are
-         *  detectable, but it is worth a shot. Note: only do this
-         *  assert if nextHeader is non-NULL.
-         */
-        Assert_isTrue(((SizeT)newHeader + size) <= (SizeT)nextHeader,
-                      ti_sdo_ipc_heaps_HeapMemMP_A_invalidFree);
-
-        /* Join with upper block */
-        if (((Memory_Size)newHeader + size) == (Memory_Size)nextHeader) {
-            if (obj->cacheEnabled) {
-                Cache_inv(nextHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
-                          Cache_Type_ALL, TRUE);
-            }
-            newHeader->next = nextHeader->next; /* A2, B2 */
-            newHeader->size += nextHeader->size; /* A2, B2 */
-            size += obj->minAlign;
+    HeapMemMP_freeBlock(obj, addr, size);
 
-            /* Don't Cache_wbInv, this will be done later */
-        }
-    }
-
-    /*
-     *  Join with lower block. Make sure to check to see if not the
-     *  first block. No need to invalidate attrs since head shouldn't change.
-     */
-    if ((curHeader != &obj->attrs->head) &&
-        ((Memory_Size)curHeader + curHeader->size == (Memory_Size)newHeader)) {
-        /*
-         * Don't Cache_inv newHeader since newHeader has data that
-         * hasn't been written back yet (B2)
-         */
-        curHeader->next = newHeader->next; /* B1, B2 */
-        curHeader->size += newHeader->size; /* B1, B2 */
+    /* Make room in the local cache */
+    if (num > 0) {
+        HeapMemMP_flushCached(obj, flushSize, num);
     }
 
     if (obj->cacheEnabled) {
-        Cache_wbInv(curHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
-             Cache_Type_ALL, FALSE); /* B1 */
-        /*
-         *  writeback invalidate the new header
-         */
-        Cache_wbInv(newHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
-             Cache_Type_ALL, TRUE);  /* B2 */
-       /*
-        *  Invalidate entire buffer being freed to ensure that stale cache
-        *  data in block isn't evicted later
-        */
-        Cache_inv(newHeader, size, Cache_Type_ALL, TRUE);  /* B2 */
+        Cache_wait();
     }
 
     GateMP_leave((GateMP_Handle)obj->gate, key);
@@ -923,6 +1515,7 @@ Void ti_sdo_ipc_heaps_HeapMemMP_getStats(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
 {
     IArg key;
     ti_sdo_ipc_heaps_HeapMemMP_Header *curHeader;
+    UInt cls;
 
     stats->totalSize         = obj->bufSize;
     stats->totalFreeSize     = 0;  /* determined later */
@@ -931,24 +1524,25 @@ Void ti_sdo_ipc_heaps_HeapMemMP_getStats(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
     key = GateMP_enter((GateMP_Handle)obj->gate);
 
     if (obj->cacheEnabled) {
-        Cache_inv(&(obj->attrs->head),
-                sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header), Cache_Type_ALL,
-                TRUE);
+        Cache_inv(obj->attrs, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Attrs),
+                Cache_Type_ALL, TRUE);
     }
 
-    curHeader = SharedRegion_getPtr(obj->attrs->head.next);
+    for (cls = 0; cls < ti_sdo_ipc_heaps_HeapMemMP_NUMCLASSES; cls++) {
+        curHeader = SharedRegion_getPtr(obj->attrs->freeList[cls]);
 
-    while (curHeader != NULL) {
-        /* Invalidate curHeader */
-        if (obj->cacheEnabled) {
-            Cache_inv(curHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
-                      Cache_Type_ALL, TRUE);
-        }
-        stats->totalFreeSize += curHeader->size;
-        if (stats->largestFreeSize < curHeader->size) {
-            stats->largestFreeSize = curHeader->size;
+        while (curHeader != NULL) {
+            /* Invalidate curHeader */
+            if (obj->cacheEnabled) {
+                Cache_inv(curHeader, sizeof(ti_sdo_ipc_heaps_HeapMemMP_Header),
+                          Cache_Type_ALL, TRUE);
+            }
+            stats->totalFreeSize += curHeader->size;
+            if (stats->largestFreeSize < curHeader->size) {
+                stats->largestFreeSize = curHeader->size;
+            }
+            curHeader = SharedRegion_getPtr(curHeader->next);
         }
-        curHeader = SharedRegion_getPtr(curHeader->next);
     }
 
     GateMP_leave((GateMP_Handle)obj->gate, key);
@@ -984,14 +1578,8 @@ Void ti_sdo_ipc_heaps_HeapMemMP_postInit(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
         if (obj->attrs == NULL) {
             return;
         }
-
-        obj->buf = (Ptr)((UArg)obj->attrs +
-                sizeof(ti_sdo_ipc_heaps_HeapMemMP_Attrs));
     }
 
-    /* Round obj->buf up by obj->minAlign */
-    obj->buf = (Ptr)_Ipc_ptrRoundup(obj->buf, obj->minAlign);
-
     /* Verify the buffer is large enough */
     Assert_isTrue((obj->bufSize >=
             SharedRegion_getCacheLineSize(obj->regionId)),
@@ -1000,11 +1588,18 @@ Void ti_sdo_ipc_heaps_HeapMemMP_postInit(ti_sdo_ipc_heaps_HeapMemMP_Object *obj,
     /* Make sure the size is a multiple of obj->minAlign */
     obj->bufSize = (obj->bufSize / obj->minAlign) * obj->minAlign;
 
+    /* The bitmap and the buffer follow the attrs, each rounded up */
+    obj->map = (Bits32 *)_Ipc_ptrRoundup((UArg)obj->attrs +
+            sizeof(ti_sdo_ipc_heaps_HeapMemMP_Attrs), obj->minAlign);
+    obj->buf = (Ptr)_Ipc_ptrRoundup((UArg)obj->map +
+            HeapMemMP_mapSize(obj->bufSize, obj->minAlign), obj->minAlign);
+
     obj->attrs->gateMPAddr = ti_sdo_ipc_GateMP_getSharedAddr(obj->gate);
     obj->attrs->bufPtr = SharedRegion_getSRPtr(obj->buf, obj->regionId);
+    obj->attrs->mapPtr = SharedRegion_getSRPtr(obj->map, obj->regionId);
 
     /* Store computed obj->bufSize in shared mem */
-    obj->attrs->head.size = obj->bufSize;
+    obj->attrs->bufSize = obj->bufSize;
 
     /* Place the initial header */
     HeapMemMP_restore((HeapMemMP_Handle)obj);
@@ -40,6 +40,7 @@ var NameServer      = null;
 var Ipc             = null;
 var Cache           = null;
 var GateMP          = null;
+var Hwi             = null;
 
 var instCount = 0;  /* use to determine if processing last instance */
 
@@ -55,6 +56,7 @@ function module$use(mod, params)
     Ipc             = xdc.useModule('ti.sdo.ipc.Ipc');
     GateMP          = xdc.useModule('ti.sdo.ipc.GateMP');
     Cache           = xdc.useModule('ti.sysbios.hal.Cache');
+    Hwi             = xdc.useModule('ti.sysbios.hal.Hwi');
 }
 
 /*
@@ -131,50 +133,26 @@ function viewInitDetailed(view, obj)
     var totalFreeSize = 0;
     var largestFreeSize = 0;
 
-    /* get the free list head; it should always exist even if list is empty */
-    var currElem;
-    var attrs;
+    /* walk the free lists of all of the size classes */
+    var freeBlocks;
 
     try {
-        attrs = Program.fetchStruct(HeapMemMP.Attrs$fetchDesc,
-                                    obj.attrs.$addr, false);
-
-        currElem = Program.fetchStruct(HeapMemMP.Header$fetchDesc,
-                                       attrs.head.$addr, false);
+        freeBlocks = getFreeBlocks(obj);
     }
     catch (e) {
         view.$status["totalFreeSize"] =
-                "Error: could not access head element of free list: " + e;
+                "Error: could not access the free lists: " + e;
 
         throw (e);
     }
 
-    /*
-     * Traverse free list and add up all of the sizes.  This loop condition
-     * ensures that we don't try to access a null element (i.e. it avoids trav-
-     * ersing past the header on an empty list and it ends once the end of a non
-     * empty list is reached).
-     */
-    while (currElem.next != SharedRegion.getSRPtrMeta$view(0)) {
-        // Fetch the next free block (next linked list element)
-        try {
-            var currElem = Program.fetchStruct(
-                    HeapMemMP.Header$fetchDesc,
-                    SharedRegion.getPtrMeta$view(currElem.next),
-                    false);
-        }
-        catch (e) {
-            view.$status["totalFreeSize"] = "Error: could not access" +
-                    " next element linked list: " + e;
-            throw (e);
-        }
-
+    for (var i = 0; i < freeBlocks.length; i++) {
         // add up the total free space
-        totalFreeSize += currElem.size;
+        totalFreeSize += freeBlocks[i].size;
 
         // check for a new max free size
-        if (currElem.size > largestFreeSize) {
-            largestFreeSize = currElem.size;
+        if (freeBlocks[i].size > largestFreeSize) {
+            largestFreeSize = freeBlocks[i].size;
         }
     }
 
@@ -229,18 +207,42 @@ function viewInitData(view, obj)
 }
 
 /*
- *  ======== getFreeList ========
+ *  ======== getFreeBlocks ========
+ *  Headers of the blocks on the free lists of all of the size classes,
+ *  smallest class first.
  */
-function getFreeList(obj)
+function getFreeBlocks(obj)
 {
     var HeapMemMP       = xdc.useModule('ti.sdo.ipc.heaps.HeapMemMP');
     var SharedRegion    = xdc.useModule('ti.sdo.ipc.SharedRegion');
 
+    var attrs = Program.fetchStruct(HeapMemMP.Attrs$fetchDesc,
+                                    obj.attrs.$addr, false);
+    var invalid = SharedRegion.getSRPtrMeta$view(0);
+    var blocks = new Array();
+
+    for (var cls = 0; cls < attrs.freeList.length; cls++) {
+        var next = attrs.freeList[cls];
+
+        while (next != invalid) {
+            var header = Program.fetchStruct(HeapMemMP.Header$fetchDesc,
+                    SharedRegion.getPtrMeta$view(next), false);
+
+            blocks[blocks.length] = header;
+            next = header.next;
+        }
+    }
+
+    return (blocks);
+}
+
+/*
+ *  ======== getFreeList ========
+ */
+function getFreeList(obj)
+{
     try {
-        var attrs = Program.fetchStruct(HeapMemMP.Attrs$fetchDesc,
-                                        obj.attrs.$addr, false);
-        var header = Program.fetchStruct(HeapMemMP.Header$fetchDesc,
-                                         attrs.head.$addr, false);
+        var freeBlocks = getFreeBlocks(obj);
     }
     catch (e) {
         print("Error: Caught exception from fetchStruct: " +
@@ -248,34 +250,14 @@ function getFreeList(obj)
         throw (e);
     }
 
-
     var freeList = new Array();
 
-    /* For each block on the free list... */
-    while (true) {
-        /* Break if this is the last block */
-        if (header.next == SharedRegion.getSRPtrMeta$view(0)) {
-            break;
-        }
-
-        /* Fetch the next block */
-        try {
-            var header = Program.fetchStruct(
-                    HeapMemMP.Header$fetchDesc,
-                    SharedRegion.getPtrMeta$view(header.next),
-                    false);
-        }
-        catch (e) {
-            print("Error: Caught exception from fetchStruct: " +
-                e.toString());
-            throw (e);
-        }
-
-        /* Add this block to the list */
+    /* For each block on the free lists... */
+    for (var i = 0; i < freeBlocks.length; i++) {
         var memBlock = Program.newViewStruct('ti.sdo.ipc.heaps.HeapMemMP',
                                              'FreeList');
-        memBlock.size = "0x" + Number(header.size).toString(16);
-        memBlock.address = "0x" + Number(header.$addr).toString(16);
+        memBlock.size = "0x" + Number(freeBlocks[i].size).toString(16);
+        memBlock.address = "0x" + Number(freeBlocks[i].$addr).toString(16);
 
         freeList[freeList.length] = memBlock;
     }
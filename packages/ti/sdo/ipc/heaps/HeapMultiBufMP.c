@@ -126,6 +126,41 @@ static int HeapMultiBufMP_sizeAlignCompare(const void *a, const void *b)
     return (diff);
 }
 
+/*
+ *  ======== HeapMultiBufMP_initLookup ========
+ *  Build the size-to-bucket table used by alloc. Slot i covers the sizes
+ *  (i << lookupShift) + 1 through (i + 1) << lookupShift and holds the first
+ *  bucket whose blockSize fits the smallest of them. Only the read-only
+ *  blockSize fields of attrs are used, so this works for create and open.
+ */
+static Void HeapMultiBufMP_initLookup(
+        ti_sdo_ipc_heaps_HeapMultiBufMP_Object *obj)
+{
+    UInt i;
+    UInt index;
+    SizeT maxSize;
+    SizeT minSize;
+
+    maxSize = (obj->numBuckets == 0) ? 1 :
+        obj->attrs->buckets[obj->numBuckets - 1].blockSize;
+
+    obj->lookupShift = 0;
+    while (((maxSize - 1) >> obj->lookupShift) >=
+            ti_sdo_ipc_heaps_HeapMultiBufMP_LOOKUPSIZE) {
+        obj->lookupShift++;
+    }
+
+    index = 0;
+    for (i = 0; i < ti_sdo_ipc_heaps_HeapMultiBufMP_LOOKUPSIZE; i++) {
+        minSize = ((SizeT)i << obj->lookupShift) + 1;
+        while (index < obj->numBuckets &&
+               obj->attrs->buckets[index].blockSize < minSize) {
+            index++;
+        }
+        obj->lookup[i] = (UInt8)index;
+    }
+}
+
 /*
  *************************************************************************
  *                       Common Header Functions
@@ -264,6 +299,11 @@ Void HeapMultiBufMP_getExtendedStats(HeapMultiBufMP_Handle handle,
          */
         stats->numAllocatedBlocks[i] = obj->attrs->buckets[i].numBlocks
                                      - obj->attrs->buckets[i].numFreeBlocks;
+
+        /* hits/misses/spills are counted against the best fitting bucket */
+        stats->numHits[i]   = obj->attrs->buckets[i].numHits;
+        stats->numMisses[i] = obj->attrs->buckets[i].numMisses;
+        stats->numSpills[i] = obj->attrs->buckets[i].numSpills;
     }
 
     GateMP_leave((GateMP_Handle)obj->gate, key);
@@ -472,6 +512,8 @@ Int ti_sdo_ipc_heaps_HeapMultiBufMP_Instance_init(
             return (1);
         }
 
+        HeapMultiBufMP_initLookup(obj);
+
         /* Done opening */
         return (0);
     }
@@ -537,6 +579,8 @@ Int ti_sdo_ipc_heaps_HeapMultiBufMP_Instance_init(
     /* Set to NULL since optBucketEntries is on the stack */
     obj->bucketEntries = NULL;
 
+    HeapMultiBufMP_initLookup(obj);
+
     /* Add entry to NameServer */
     if (params->name != NULL) {
         /* We will store a shared pointer in the NameServer */
@@ -609,25 +653,27 @@ Ptr ti_sdo_ipc_heaps_HeapMultiBufMP_alloc(
 {
     ti_sdo_ipc_heaps_HeapMultiBufMP_Elem *block;
     UInt index;
+    UInt served;
+    UInt slot;
     IArg key;
-    Bool alignMatches, sizeMatches;
-
-    /* Read-only field, so no cache/gate concerns */
-    for (index = 0; index < obj->numBuckets; index++) {
-        sizeMatches = (size <= obj->attrs->buckets[index].blockSize);
-        alignMatches = (align <= obj->attrs->buckets[index].align);
-
-        if (sizeMatches && alignMatches) {
-            if (obj->exact && size != obj->attrs->buckets[index].blockSize) {
-                Error_raise(eb, ti_sdo_ipc_heaps_HeapMultiBufMP_E_exactFail,
-                            size, obj->attrs->buckets[index].blockSize);
-                return (NULL);
-            }
-            break;
-        }
+
+    /*
+     *  Read-only fields, so no cache/gate concerns. The lookup table gives
+     *  the first bucket large enough for the smallest size in this size's
+     *  slot; step over the (rare) buckets that are still too small for the
+     *  size or the alignment.
+     */
+    slot = (size == 0) ? 0 : (UInt)((size - 1) >> obj->lookupShift);
+    index = (slot < ti_sdo_ipc_heaps_HeapMultiBufMP_LOOKUPSIZE) ?
+        obj->lookup[slot] : obj->numBuckets;
+
+    while (index < obj->numBuckets &&
+           (size > obj->attrs->buckets[index].blockSize ||
+            align > obj->attrs->buckets[index].align)) {
+        index++;
     }
 
-    if (index == obj->attrs->numBuckets) {
+    if (index == obj->numBuckets) {
         /* Couldn't find a buffer with suitable size/align */
         Error_raise(eb, ti_sdo_ipc_heaps_HeapMultiBufMP_E_size,
                 size, align);
@@ -635,6 +681,12 @@ Ptr ti_sdo_ipc_heaps_HeapMultiBufMP_alloc(
         return (NULL);
     }
 
+    if (obj->exact && size != obj->attrs->buckets[index].blockSize) {
+        Error_raise(eb, ti_sdo_ipc_heaps_HeapMultiBufMP_E_exactFail,
+                    size, obj->attrs->buckets[index].blockSize);
+        return (NULL);
+    }
+
     /* At this point, we know the bucket number. Enter the gate */
     key = GateMP_enter((GateMP_Handle)obj->gate);
 
@@ -646,16 +698,59 @@ Ptr ti_sdo_ipc_heaps_HeapMultiBufMP_alloc(
 
     /* Get the first block */
     block = HeapMultiBufMP_getHead(obj, index);
+    served = index;
 
-    /* Make sure that a valid pointer was returned. */
     if (block == NULL) {
-        /* No more blocks left in the buffer */
-        GateMP_leave((GateMP_Handle)obj->gate, key);
-        Error_raise(eb, ti_sdo_ipc_heaps_HeapMultiBufMP_E_noBlocksLeft,
-                    obj->attrs->buckets[index].blockSize,
-                    obj->attrs->buckets[index].align);
+        obj->attrs->buckets[index].numMisses++;
 
-        return (NULL);
+        /*
+         *  Buckets are sorted by blockSize, so every later bucket fits the
+         *  size; only the alignment needs checking.
+         */
+        if (ti_sdo_ipc_heaps_HeapMultiBufMP_fallback ==
+                ti_sdo_ipc_heaps_HeapMultiBufMP_Fallback_SPILL &&
+                !obj->exact) {
+            for (served = index + 1; served < obj->numBuckets; served++) {
+                if (align > obj->attrs->buckets[served].align) {
+                    continue;
+                }
+                if (obj->cacheEnabled) {
+                    Cache_inv(&(obj->attrs->buckets[served]),
+                        sizeof(ti_sdo_ipc_heaps_HeapMultiBufMP_BucketAttrs),
+                        Cache_Type_ALL, TRUE);
+                }
+                block = HeapMultiBufMP_getHead(obj, served);
+                if (block != NULL) {
+                    break;
+                }
+            }
+        }
+
+        if (block != NULL) {
+            obj->attrs->buckets[index].numSpills++;
+        }
+
+        /* The counters of the preferred bucket changed */
+        if (obj->cacheEnabled) {
+            Cache_wbInv(&(obj->attrs->buckets[index]),
+                sizeof(ti_sdo_ipc_heaps_HeapMultiBufMP_BucketAttrs),
+                Cache_Type_ALL, TRUE);
+        }
+
+        if (block == NULL) {
+            /* No more blocks left in the buffer */
+            GateMP_leave((GateMP_Handle)obj->gate, key);
+            Error_raise(eb, ti_sdo_ipc_heaps_HeapMultiBufMP_E_noBlocksLeft,
+                        obj->attrs->buckets[index].blockSize,
+                        obj->attrs->buckets[index].align);
+
+            return (NULL);
+        }
+
+        index = served;
+    }
+    else {
+        obj->attrs->buckets[index].numHits++;
     }
 
     obj->attrs->buckets[index].numFreeBlocks--;
@@ -969,6 +1064,9 @@ Void ti_sdo_ipc_heaps_HeapMultiBufMP_postInit(
         obj->attrs->buckets[i].numBlocks     = obj->bucketEntries[i].numBlocks;
         obj->attrs->buckets[i].numFreeBlocks = obj->bucketEntries[i].numBlocks;
         obj->attrs->buckets[i].align         = obj->bucketEntries[i].align;
+        obj->attrs->buckets[i].numHits       = 0;
+        obj->attrs->buckets[i].numMisses     = 0;
+        obj->attrs->buckets[i].numSpills     = 0;
     }
 
     /* obj->buf should point to base of first buffer */
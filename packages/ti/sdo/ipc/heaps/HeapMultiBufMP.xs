@@ -162,6 +162,9 @@ function viewInitData(view, obj)
 
             elem.minFreeBlocks  = attrs.buckets[i].minFreeBlocks == 0xffffffff
                                   ? -1 : attrs.buckets[i].minFreeBlocks;
+            elem.numHits        = attrs.buckets[i].numHits;
+            elem.numMisses      = attrs.buckets[i].numMisses;
+            elem.numSpills      = attrs.buckets[i].numSpills;
 
             /* Add the element to the list. */
             view.elements.$add(elem);
@@ -39,3 +39,6 @@
 #include <ti/sdo/ipc/heaps/HeapBufMP.h>
 
 #include <ti/ipc/HeapBufMP.h>
+
+/* MessageQ.allocNFxn, see MessageQ.xdc */
+Int _HeapBufMP_allocN(IHeap_Handle heap, SizeT size, Ptr *blocks, UInt num);
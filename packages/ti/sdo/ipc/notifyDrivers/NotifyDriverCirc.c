@@ -40,6 +40,7 @@
 
 #include <ti/sysbios/hal/Hwi.h>
 #include <ti/sysbios/hal/Cache.h>
+#include <ti/sysbios/knl/Swi.h>
 
 #include <ti/sdo/ipc/interfaces/INotifyDriver.h>
 
@@ -72,6 +73,7 @@ Void NotifyDriverCirc_Instance_init(NotifyDriverCirc_Object *obj,
     UInt16 localIndex, remoteIndex;
     SizeT  regionCacheSize, minAlign;
     SizeT  ctrlSize, circBufSize, totalSelfSize;
+    Swi_Params swiParams;
 
    /*
     * Check whether remote proc ID has been set and isn't the same as the
@@ -142,6 +144,15 @@ Void NotifyDriverCirc_Instance_init(NotifyDriverCirc_Object *obj,
     obj->spinCount = 0;
     obj->spinWaitTime = 0;
 
+    /* counters for interrupt moderation statistics */
+    obj->intCount = 0;
+    obj->eventCount = 0;
+    obj->intSkipped = 0;
+
+    /* the interrupt is masked by disable() or while the swi polls */
+    obj->disabled = FALSE;
+    obj->polling = FALSE;
+
     /* calculate the circular buffer size one-way */
     circBufSize = _Ipc_roundup(
         sizeof(NotifyDriverCirc_EventEntry) * NotifyDriverCirc_numMsgs,
@@ -199,6 +210,15 @@ Void NotifyDriverCirc_Instance_init(NotifyDriverCirc_Object *obj,
                   Cache_Type_ALL, TRUE);
     }
 
+    /* the polling Swi drains the get buffer with the interrupt masked */
+    if (NotifyDriverCirc_moderateInterrupts) {
+        Swi_Params_init(&swiParams);
+        swiParams.arg0 = (UArg)obj;
+        Swi_construct(NotifyDriverCirc_Instance_State_swiObj(obj),
+                     (Swi_FuncPtr)NotifyDriverCirc_swiFxn,
+                     &swiParams, NULL);
+    }
+
     /* Register the incoming interrupt */
     NotifyDriverCirc_InterruptProxy_intRegister(obj->remoteProcId,
         &(obj->intInfo), (Fxn)NotifyDriverCirc_isr, (UArg)obj);
@@ -215,6 +235,10 @@ Void NotifyDriverCirc_Instance_finalize(NotifyDriverCirc_Object *obj)
     NotifyDriverCirc_InterruptProxy_intUnregister(obj->remoteProcId,
         &(obj->intInfo));
 
+    if (NotifyDriverCirc_moderateInterrupts) {
+        Swi_destruct(NotifyDriverCirc_Instance_State_swiObj(obj));
+    }
+
     /* cache inv the shared memory that is used for instance */
     if (obj->cacheEnabled) {
         if (obj->remoteProcId > MultiProc_self()) {
@@ -300,7 +324,7 @@ Int NotifyDriverCirc_sendEvent(NotifyDriverCirc_Object *obj,
      *  readIndex until out writeIndex wraps. Only need to invalidate
      *  once every N times [N = number of slots in buffer].
      */
-    readIndex = obj->putReadIndex[0];
+    readIndex = obj->putReadIndex[0] & NotifyDriverCirc_maxIndex;
 
     do {
         /* disable interrupts */
@@ -340,7 +364,7 @@ Int NotifyDriverCirc_sendEvent(NotifyDriverCirc_Object *obj,
         }
 
         /* re-read the get count */
-        readIndex = obj->putReadIndex[0];
+        readIndex = obj->putReadIndex[0] & NotifyDriverCirc_maxIndex;
 
         /* convey that the code has looped around */
         loop = TRUE;
@@ -397,6 +421,33 @@ Int NotifyDriverCirc_sendEvent(NotifyDriverCirc_Object *obj,
                  TRUE);
     }
 
+    /*
+     *  With moderateInterrupts, skip the interrupt while the remote
+     *  processor is polling.  It looks at the putWriteIndex again after it
+     *  stops advertising that it is polling, see swiFxn.
+     */
+    if (NotifyDriverCirc_moderateInterrupts) {
+        /*
+         *  The putWriteIndex store must be seen before the flag is read,
+         *  the remote does the same the other way around.
+         */
+        _Ipc_memoryBarrier();
+
+        if (obj->cacheEnabled) {
+            Cache_inv(obj->putReadIndex,
+                      sizeof(Bits32),
+                      Cache_Type_ALL,
+                      TRUE);
+        }
+
+        if (obj->putReadIndex[0] & NotifyDriverCirc_POLLING) {
+            if (NotifyDriverCirc_enableStats) {
+                obj->intSkipped++;
+            }
+            return (Notify_S_SUCCESS);
+        }
+    }
+
     /* Send an interrupt to the Remote Processor */
     NotifyDriverCirc_InterruptProxy_intSend(obj->remoteProcId, &(obj->intInfo),
                                             eventId);
@@ -409,9 +460,14 @@ Int NotifyDriverCirc_sendEvent(NotifyDriverCirc_Object *obj,
  */
 Void NotifyDriverCirc_disable(NotifyDriverCirc_Object *obj)
 {
-    /* Disable the incoming interrupt line */
+    UInt hwiKey;
+
+    /* Disable the incoming interrupt line, the swi must not unmask it */
+    hwiKey = Hwi_disable();
+    obj->disabled = TRUE;
     NotifyDriverCirc_InterruptProxy_intDisable(obj->remoteProcId,
                                               &(obj->intInfo));
+    Hwi_restore(hwiKey);
 }
 
 /*
@@ -419,8 +475,16 @@ Void NotifyDriverCirc_disable(NotifyDriverCirc_Object *obj)
  */
 Void NotifyDriverCirc_enable(NotifyDriverCirc_Object *obj)
 {
-    /* NotifyDriverCirc_enableEvent not supported by this driver */
-    Assert_isTrue(FALSE, NotifyDriverCirc_A_notSupported);
+    UInt hwiKey;
+
+    /* Enable the incoming interrupt line, unless the swi is polling */
+    hwiKey = Hwi_disable();
+    obj->disabled = FALSE;
+    if (!obj->polling) {
+        NotifyDriverCirc_InterruptProxy_intEnable(obj->remoteProcId,
+                                                 &(obj->intInfo));
+    }
+    Hwi_restore(hwiKey);
 }
 
 /*
@@ -437,9 +501,15 @@ Void NotifyDriverCirc_disableEvent(NotifyDriverCirc_Object *obj, UInt32 eventId)
  */
 Void NotifyDriverCirc_enableEvent(NotifyDriverCirc_Object *obj, UInt32 eventId)
 {
-    /* Enable the incoming interrupt line */
-    NotifyDriverCirc_InterruptProxy_intEnable(obj->remoteProcId,
-                                             &(obj->intInfo));
+    UInt hwiKey;
+
+    /* Enable the incoming interrupt line, unless disabled or polling */
+    hwiKey = Hwi_disable();
+    if ((!obj->disabled) && (!obj->polling)) {
+        NotifyDriverCirc_InterruptProxy_intEnable(obj->remoteProcId,
+                                                 &(obj->intInfo));
+    }
+    Hwi_restore(hwiKey);
 }
 
 /*
@@ -521,6 +591,35 @@ Void NotifyDriverCirc_isr(UArg arg)
     /* Make sure the NotifyDriverCirc_Object is not NULL */
     Assert_isTrue(obj != NULL, ti_sdo_ipc_Ipc_A_internal);
 
+    if (NotifyDriverCirc_enableStats) {
+        obj->intCount++;
+    }
+
+    /*
+     *  With moderateInterrupts mask the interrupt, tell the senders we are
+     *  polling and leave the events to the Swi.  A sender that misses the
+     *  flag just raises an interrupt that stays pending until the Swi
+     *  unmasks it.
+     */
+    if (NotifyDriverCirc_moderateInterrupts) {
+        NotifyDriverCirc_InterruptProxy_intClear(obj->remoteProcId,
+                                                &(obj->intInfo));
+        NotifyDriverCirc_InterruptProxy_intDisable(obj->remoteProcId,
+                                                  &(obj->intInfo));
+        obj->polling = TRUE;
+
+        obj->getReadIndex[0] |= NotifyDriverCirc_POLLING;
+        if (obj->cacheEnabled) {
+            Cache_wb(obj->getReadIndex,
+                     sizeof(Bits32),
+                     Cache_Type_ALL,
+                     FALSE);
+        }
+
+        Swi_post(NotifyDriverCirc_Instance_State_swiObj(obj));
+        return;
+    }
+
     /*
      *  Invalidate both getBuffer getWriteIndex from cache.
      *  Do the Cache_wait() below.
@@ -566,6 +665,10 @@ Void NotifyDriverCirc_isr(UArg arg)
                                    eventEntry->payload);
         }
 
+        if (NotifyDriverCirc_enableStats) {
+            obj->eventCount++;
+        }
+
         /* update the readIndex. */
         readIndex = ((readIndex + 1) & NotifyDriverCirc_maxIndex);
 
@@ -594,6 +697,132 @@ Void NotifyDriverCirc_isr(UArg arg)
     }
 }
 
+/*
+ *  ======== NotifyDriverCirc_swiFxn ========
+ *  Polls the get buffer while the interrupt is masked.  Runs at most
+ *  pollBudget callbacks, then re-posts itself if events remain.  Once the
+ *  buffer is empty it unmasks the interrupt and stops advertising that it
+ *  is polling.
+ */
+Void NotifyDriverCirc_swiFxn(UArg arg)
+{
+    NotifyDriverCirc_EventEntry *eventEntry;
+    NotifyDriverCirc_Object     *obj;
+    UInt32 writeIndex, readIndex;
+    UInt budget = NotifyDriverCirc_pollBudget;
+    UInt hwiKey;
+
+    obj = (NotifyDriverCirc_Object *)arg;
+
+    /* Make sure the NotifyDriverCirc_Object is not NULL */
+    Assert_isTrue(obj != NULL, ti_sdo_ipc_Ipc_A_internal);
+
+    readIndex = obj->getReadIndex[0] & NotifyDriverCirc_maxIndex;
+
+    while (TRUE) {
+        /* Invalidate both getBuffer and getWriteIndex from cache */
+        if (obj->cacheEnabled) {
+            Cache_inv(obj->getBuffer,
+                      obj->opCacheSize,
+                      Cache_Type_ALL,
+                      TRUE);
+        }
+
+        writeIndex = obj->getWriteIndex[0];
+
+        while ((writeIndex != readIndex) && (budget > 0)) {
+            eventEntry = &(obj->getBuffer[readIndex]);
+
+            /* an event that is not registered is lost */
+            if (TEST_BIT(obj->evtRegMask, eventEntry->eventid)) {
+                ti_sdo_ipc_Notify_exec(obj->notifyHandle,
+                                       eventEntry->eventid,
+                                       eventEntry->payload);
+            }
+
+            if (NotifyDriverCirc_enableStats) {
+                obj->eventCount++;
+            }
+
+            readIndex = ((readIndex + 1) & NotifyDriverCirc_maxIndex);
+            budget--;
+
+            /* still polling, publish the readIndex every N / 4 events */
+            obj->getReadIndex[0] = readIndex | NotifyDriverCirc_POLLING;
+            if ((obj->cacheEnabled) &&
+                ((readIndex % NotifyDriverCirc_modIndex) == 0)) {
+                Cache_wb(obj->getReadIndex,
+                         sizeof(Bits32),
+                         Cache_Type_ALL,
+                         FALSE);
+            }
+        }
+
+        if (writeIndex != readIndex) {
+            /* budget used up, let other Swis run and come back */
+            if (obj->cacheEnabled) {
+                Cache_wb(obj->getReadIndex,
+                         sizeof(Bits32),
+                         Cache_Type_ALL,
+                         FALSE);
+            }
+            Swi_post(NotifyDriverCirc_Instance_State_swiObj(obj));
+            return;
+        }
+
+        /*
+         *  Buffer is empty: unmask the interrupt and stop advertising
+         *  polling together so the isr can't interleave.  The interrupt
+         *  stays masked if disable() was called, enable() unmasks it.
+         *  Then look at the getWriteIndex again, a sender may have skipped
+         *  the interrupt right before it saw the flag cleared.
+         */
+        hwiKey = Hwi_disable();
+        obj->getReadIndex[0] = readIndex;
+        obj->polling = FALSE;
+        if (!obj->disabled) {
+            NotifyDriverCirc_InterruptProxy_intEnable(obj->remoteProcId,
+                                                     &(obj->intInfo));
+        }
+        Hwi_restore(hwiKey);
+
+        if (obj->cacheEnabled) {
+            Cache_wb(obj->getReadIndex,
+                     sizeof(Bits32),
+                     Cache_Type_ALL,
+                     TRUE);
+
+            Cache_inv(obj->getWriteIndex,
+                      sizeof(Bits32),
+                      Cache_Type_ALL,
+                      TRUE);
+        }
+
+        /* the flag must be seen cleared before the getWriteIndex is read */
+        _Ipc_memoryBarrier();
+
+        if (obj->getWriteIndex[0] == readIndex) {
+            return;
+        }
+
+        /* more events came in, go back to polling for them */
+        hwiKey = Hwi_disable();
+        NotifyDriverCirc_InterruptProxy_intDisable(obj->remoteProcId,
+                                                  &(obj->intInfo));
+        obj->polling = TRUE;
+        obj->getReadIndex[0] = readIndex | NotifyDriverCirc_POLLING;
+        Hwi_restore(hwiKey);
+
+        /* the sender must see the flag set again or it keeps interrupting */
+        if (obj->cacheEnabled) {
+            Cache_wb(obj->getReadIndex,
+                     sizeof(Bits32),
+                     Cache_Type_ALL,
+                     FALSE);
+        }
+    }
+}
+
 /*
  *  ======== NotifyDriverCirc_setNotifyHandle ========
  */
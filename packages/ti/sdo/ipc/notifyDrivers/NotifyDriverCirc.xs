@@ -100,6 +100,21 @@ function viewInitBasic(view, obj)
     view.bufSize      = modCfg.numMsgs;
     view.spinCount    = obj.spinCount;
     view.maxSpinWait  = obj.spinWaitTime;;
+    view.intCount     = obj.intCount;
+    view.eventCount   = obj.eventCount;
+    view.intSkipped   = obj.intSkipped;
+
+    /* the receiver advertises polling in its read index */
+    try {
+        var ScalarStructs = xdc.useModule('xdc.rov.support.ScalarStructs');
+        var getReadIndex = Program.fetchStruct(
+                ScalarStructs.S_Bits32$fetchDesc, obj.getReadIndex);
+        view.polling = (getReadIndex.elem & 0x80000000) != 0;
+    }
+    catch(e) {
+        Program.displayError(view, 'polling',
+                             "Problem fetching getReadIndex: " + e);
+    }
 }
 
 /*
@@ -207,9 +222,11 @@ function viewInitData(view, obj)
     }
 
     /* Get event data for the put buffer */
-    getEventData(view, obj, obj.putBuffer, putWriteIndex.elem, putReadIndex.elem);
+    getEventData(view, obj, obj.putBuffer, putWriteIndex.elem,
+            putReadIndex.elem & ~0x80000000);
 
     /* Get event data for the get buffer */
-    getEventData(view, obj, obj.getBuffer, getWriteIndex.elem, getReadIndex.elem);
+    getEventData(view, obj, obj.getBuffer, getWriteIndex.elem,
+            getReadIndex.elem & ~0x80000000);
 
 }
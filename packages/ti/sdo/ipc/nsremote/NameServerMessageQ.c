@@ -46,7 +46,6 @@
 #include <ti/sysbios/knl/Swi.h>
 #include <ti/sysbios/knl/Semaphore.h>
 #include <ti/sysbios/syncs/SyncSwi.h>
-#include <ti/sysbios/gates/GateMutex.h>
 
 #include "package/internal/NameServerMessageQ.xdc.h"
 
@@ -78,6 +77,17 @@ typedef struct NameServerMsg {
     Bits32  name[NAMEARRAYSIZE];
 } NameServerMsg;
 
+/* task waiting for the response to its request */
+typedef struct NameServerMessageQ_Waiter {
+    struct NameServerMessageQ_Waiter *next;
+    UInt32              seqNum;     /* sent in the 'reserved' field     */
+    NameServerMsg       *msg;       /* response, set by swiFxn          */
+    Semaphore_Struct    sem;        /* posted when msg is set           */
+} NameServerMessageQ_Waiter;
+
+static NameServerMessageQ_Waiter *NameServerMessageQ_removeWaiter(
+        UInt32 seqNum);
+
 /*
  *************************************************************************
  *                       Instance functions
@@ -221,14 +231,21 @@ Int NameServerMessageQ_get(NameServerMessageQ_Object *obj,
                            Error_Block *eb)
 {
     Int status;
-    IArg key;
+    UInt key;
+    Bits32 gen;
+    UInt32 cached;
     MessageQ_QueueId queueId;
     NameServerMsg    *msg;
-    Semaphore_Handle semRemoteWait = NameServerMessageQ_module->semRemoteWait;
-    GateMutex_Handle gateMutex = NameServerMessageQ_module->gateMutex;
+    NameServerMessageQ_Waiter waiter;
+    Semaphore_Params semParams;
 
-    /* enter gate - prevent multiple threads from entering */
-    key = GateMutex_enter(gateMutex);
+    /* a name found before doesn't need a round trip */
+    if (ti_sdo_utils_NameServer_getCached(obj->remoteProcId, instanceName,
+            name, &cached, &gen)) {
+        *valueLen = sizeof(Bits32);
+        memcpy(value, &cached, sizeof(Bits32));
+        return (NameServer_S_SUCCESS);
+    }
 
     /* alloc a message from specified heap */
     msg = (NameServerMsg *)MessageQ_alloc(NameServerMessageQ_heapId,
@@ -269,6 +286,21 @@ Int NameServerMessageQ_get(NameServerMessageQ_Object *obj,
         (MessageQ_Handle)NameServerMessageQ_module->msgHandle,
         (MessageQ_Msg)msg);
 
+    /* wait on our own semaphore, other tasks can have requests out too */
+    Semaphore_Params_init(&semParams);
+    Semaphore_construct(&waiter.sem, 0, &semParams);
+    waiter.msg = NULL;
+
+    /* queue up before sending, the response can come back right away */
+    key = Swi_disable();
+    waiter.seqNum = NameServerMessageQ_module->seqNum++;
+    waiter.next = NameServerMessageQ_module->waiters;
+    NameServerMessageQ_module->waiters = &waiter;
+    Swi_restore(key);
+
+    /* the remote processor sends this back in the response */
+    msg->reserved = waiter.seqNum;
+
     /* send message to remote processor. */
     status = MessageQ_put(queueId, (MessageQ_Msg)msg);
 
@@ -277,20 +309,37 @@ Int NameServerMessageQ_get(NameServerMessageQ_Object *obj,
         /* free the message */
         MessageQ_free((MessageQ_Msg)msg);
 
+        key = Swi_disable();
+        NameServerMessageQ_removeWaiter(waiter.seqNum);
+        Swi_restore(key);
+        Semaphore_destruct(&waiter.sem);
+
         return (NameServer_E_FAIL);
     }
 
     /* pend here until we get a response back from remote processor */
-    status = Semaphore_pend(semRemoteWait, NameServerMessageQ_timeout);
+    Semaphore_pend(Semaphore_handle(&waiter.sem), NameServerMessageQ_timeout);
+
+    /*
+     *  Stop waiting.  If swiFxn hasn't handed us the response by now it
+     *  frees it when it comes.
+     */
+    key = Swi_disable();
+    if (waiter.msg == NULL) {
+        NameServerMessageQ_removeWaiter(waiter.seqNum);
+    }
+    Swi_restore(key);
+
+    Semaphore_destruct(&waiter.sem);
+
+    /* get the message */
+    msg = waiter.msg;
 
-    if (status == FALSE) {
+    if (msg == NULL) {
         /* return timeout failure */
         return (NameServer_E_OSFAILURE);
     }
 
-    /* get the message */
-    msg = NameServerMessageQ_module->msg;
-
     if (msg->requestStatus) {
         /* name is found */
 
@@ -300,6 +349,10 @@ Int NameServerMessageQ_get(NameServerMessageQ_Object *obj,
         /* set the contents of value */
         memcpy(value, &(msg->value), sizeof(Bits32));
 
+        /* remember it, unless the remote flushed us in the meantime */
+        ti_sdo_utils_NameServer_addCached(obj->remoteProcId, instanceName,
+                name, msg->value, gen);
+
         /* set the status to success */
         status = NameServer_S_SUCCESS;
     }
@@ -313,13 +366,52 @@ Int NameServerMessageQ_get(NameServerMessageQ_Object *obj,
     /* free the message */
     MessageQ_free((MessageQ_Msg)msg);
 
-    /* leave the gate */
-    GateMutex_leave(gateMutex, key);
-
     /* return success status */
     return (status);
 }
 
+/*
+ *  ======== NameServerMessageQ_invalidate ========
+ *  Have the remote processor flush what it cached from instance
+ *  'instanceName' on this processor.  The message carries the instance's
+ *  cache key in 'value'.
+ */
+Void NameServerMessageQ_invalidate(NameServerMessageQ_Object *obj,
+        String instanceName)
+{
+    NameServerMsg    *msg;
+    MessageQ_QueueId queueId;
+    Error_Block      eb;
+
+    msg = (NameServerMsg *)MessageQ_alloc(NameServerMessageQ_heapId,
+                                          sizeof(NameServerMsg));
+    if (msg == NULL) {
+        Error_init(&eb);
+        Error_raise(&eb, NameServerMessageQ_E_outOfMemory,
+                    NameServerMessageQ_heapId, 0);
+        return;
+    }
+
+    msg->request = NameServerMessageQ_INVALIDATE;
+    msg->requestStatus = 0;
+    msg->value = ti_sdo_utils_NameServer_cacheKey(instanceName);
+
+    queueId = MessageQ_openQueueId(MESSAGEQ_INDEX, obj->remoteProcId);
+
+    if (MessageQ_put(queueId, (MessageQ_Msg)msg) < 0) {
+        MessageQ_free((MessageQ_Msg)msg);
+    }
+}
+
+/*
+ *  ======== NameServerMessageQ_announce ========
+ *  Misses are never cached, nothing to tell.
+ */
+Void NameServerMessageQ_announce(NameServerMessageQ_Object *obj,
+        String instanceName, String name)
+{
+}
+
 /*
  *  ======== NameServerMessageQ_sharedMemReq ========
  */
@@ -337,7 +429,7 @@ Void NameServerMessageQ_swiFxn(UArg arg0, UArg arg1)
     NameServer_Handle handle;
     MessageQ_QueueId  queueId;
     Int               status = NameServer_E_FAIL;
-    Semaphore_Handle  semRemoteWait = NameServerMessageQ_module->semRemoteWait;
+    NameServerMessageQ_Waiter *waiter;
 
     /* drain all messages in the messageQ */
     while (1) {
@@ -384,16 +476,50 @@ Void NameServerMessageQ_swiFxn(UArg arg0, UArg arg1)
             /* send response message to remote processor */
             MessageQ_put(queueId, (MessageQ_Msg)msg);
         }
-        else {
+        else if (msg->request == NameServerMessageQ_RESPONSE) {
             /*
-             *  This is a response message. At any given time, there is
-             *  only one of these outstanding because of semMultiBlock.
-             *  This allows us to safely set the Module state's msg pointer
-             *  and post semaphore.
+             *  This is a response message.  Hand it to the task that sent
+             *  the request, tasks only change the list with Swis disabled.
+             *  Nobody waits for it anymore if the request timed out.
              */
-            NameServerMessageQ_module->msg = msg;
-            Semaphore_post(semRemoteWait);
+            waiter = NameServerMessageQ_removeWaiter(msg->reserved);
+            if (waiter != NULL) {
+                waiter->msg = msg;
+                Semaphore_post(Semaphore_handle(&waiter->sem));
+            }
+            else {
+                MessageQ_free((MessageQ_Msg)msg);
+            }
+        }
+        else {
+            /* The remote processor removed a name from an instance */
+            ti_sdo_utils_NameServer_flushCached(msg->header.srcProc,
+                    msg->value);
+            MessageQ_free((MessageQ_Msg)msg);
         }
 
     }
 }
+
+/*
+ *  ======== NameServerMessageQ_removeWaiter ========
+ *  Take the task waiting for request 'seqNum' off the list.  Called with
+ *  Swis disabled or from swiFxn.
+ */
+static NameServerMessageQ_Waiter *NameServerMessageQ_removeWaiter(
+        UInt32 seqNum)
+{
+    NameServerMessageQ_Waiter **link;
+    NameServerMessageQ_Waiter *waiter;
+
+    link = (NameServerMessageQ_Waiter **)&NameServerMessageQ_module->waiters;
+    while ((waiter = *link) != NULL) {
+        if (waiter->seqNum == seqNum) {
+            *link = waiter->next;
+            break;
+        }
+        link = &waiter->next;
+    }
+
+    return (waiter);
+}
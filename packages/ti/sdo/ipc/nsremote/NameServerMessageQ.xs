@@ -40,7 +40,6 @@ var Swi = null;
 var Clock = null;
 var Ipc = null;
 var SyncSwi = null;
-var GateMutex = null;
 var MessageQ = null;
 
 /*
@@ -55,7 +54,6 @@ function module$use()
     Clock           = xdc.useModule("ti.sysbios.knl.Clock");
     Ipc             = xdc.useModule("ti.sdo.ipc.Ipc");
     SyncSwi         = xdc.useModule("ti.sysbios.syncs.SyncSwi");
-    GateMutex       = xdc.useModule("ti.sysbios.gates.GateMutex");
     MessageQ        = xdc.useModule("ti.sdo.ipc.MessageQ");
 }
 
@@ -66,7 +64,8 @@ function module$use()
 function module$static$init(mod, params)
 {
     mod.msgHandle = null;
-    mod.msg       = null;
+    mod.waiters   = null;
+    mod.seqNum    = 0;
 
     /* calculate the timeout value */
     if (NameServerMessageQ.timeoutInMicroSecs != ~(0)) {
@@ -86,12 +85,6 @@ function module$static$init(mod, params)
     var syncSwiParams = new SyncSwi.Params();
     syncSwiParams.swi = mod.swiHandle;
     mod.syncSwiHandle = SyncSwi.create(syncSwiParams);
-
-    /* create the semaphore to wait for a response message */
-    mod.semRemoteWait = Semaphore.create(0);
-
-    /* create GateMutex */
-    mod.gateMutex = GateMutex.create();
 }
 
 function module$validate()
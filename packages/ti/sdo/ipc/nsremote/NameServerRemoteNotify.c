@@ -46,6 +46,7 @@
 
 #include <ti/sysbios/BIOS.h>
 #include <ti/sysbios/hal/Cache.h>
+#include <ti/sysbios/hal/Hwi.h>
 #include <ti/sysbios/knl/Swi.h>
 #include <ti/sysbios/knl/Semaphore.h>
 
@@ -64,9 +65,24 @@
         ti_sdo_ipc_nsremote_NameServerRemoteNotify_notifyEventId + \
                     (UInt32)((UInt32)Notify_SYSTEMKEY << 16)
 
-/* private constant values */
+/*
+ *  Notify payload: message type in bits 0-7, the request slot in bits 8-15
+ *  and the request's sequence number in bits 16-31.  A response carries
+ *  the slot and sequence number of its request.
+ */
 #define NameServerRemoteNotify_RequestMsg       1
 #define NameServerRemoteNotify_ResponseMsg      2
+#define NameServerRemoteNotify_InvalidateMsg    3
+
+#define MSGTYPE(payload)    ((payload) & 0xFF)
+#define MSGSLOT(payload)    (((payload) >> 8) & 0xFF)
+#define MSGKEY(payload)     (((payload) >> 8) & 0xFFFF)
+
+/* task waiting for the response in a request slot */
+typedef struct NameServerRemoteNotify_Waiter {
+    UInt32              payload;    /* request sent from the slot       */
+    Semaphore_Struct    sem;        /* posted by the response           */
+} NameServerRemoteNotify_Waiter;
 
 /*
  *************************************************************************
@@ -79,11 +95,13 @@ Int NameServerRemoteNotify_Instance_init(NameServerRemoteNotify_Object *obj,
 {
     Int               offset = 0;
     Int               status;
+    UInt              i;
     Semaphore_Params  semParams;
     Semaphore_Handle  semHandle;
     Swi_Params        swiParams;
     Swi_Handle        swiHandle;
     SizeT          cacheLineSize;
+    NameServerRemoteNotify_Message *msg;
 
     /* Assert that a NameServerRemoteNotify_Params has been supplied */
     Assert_isTrue(params != NULL, Ipc_A_nullArgument);
@@ -115,21 +133,24 @@ Int NameServerRemoteNotify_Instance_init(NameServerRemoteNotify_Object *obj,
             NameServerRemoteNotify_A_messageSize);
     }
 
+    /* each side has numRequests request slots */
     obj->msg[0] = (NameServerRemoteNotify_Message *)(params->sharedAddr);
-    obj->msg[1] = (NameServerRemoteNotify_Message *)((UArg)obj->msg[0] +
-                          sizeof(NameServerRemoteNotify_Message));
+    obj->msg[1] = obj->msg[0] + NameServerRemoteNotify_numRequests;
     obj->gate = params->gate;
     obj->remoteProcId = remoteProcId;
+    obj->seqNum = 0;
+    obj->requests = 0;
 
-    /* construct the remoteWait semaphore */
-    semHandle = NameServerRemoteNotify_Instance_State_semRemoteWait(obj);
-    Semaphore_Params_init(&semParams);
-    Semaphore_construct(Semaphore_struct(semHandle), 0, &semParams);
+    for (i = 0; i < NameServerRemoteNotify_MAXREQUESTS; i++) {
+        obj->waiters[i] = NULL;
+        obj->requestIds[i] = 0;
+    }
 
-    /* construct the multiBlock semaphore */
+    /* construct the multiBlock semaphore, it counts the free slots */
     semHandle = NameServerRemoteNotify_Instance_State_semMultiBlock(obj);
     Semaphore_Params_init(&semParams);
-    Semaphore_construct(Semaphore_struct(semHandle), 1, &semParams);
+    Semaphore_construct(Semaphore_struct(semHandle),
+            NameServerRemoteNotify_numRequests, &semParams);
 
     /* construct swi which handles the request message */
     swiHandle = NameServerRemoteNotify_Instance_State_swiRequest(obj);
@@ -140,30 +161,24 @@ Int NameServerRemoteNotify_Instance_init(NameServerRemoteNotify_Object *obj,
              (ti_sysbios_knl_Swi_FuncPtr)NameServerRemoteNotify_swiFxnRequest,
              &swiParams, eb);
 
-    /* construct swi which handles the response message */
-    swiHandle = NameServerRemoteNotify_Instance_State_swiResponse(obj);
-    Swi_Params_init(&swiParams);
-    swiParams.arg0 = (UArg)obj;
-    swiParams.priority = 0; /* lowest priority */
-    Swi_construct(Swi_struct(swiHandle),
-             (ti_sysbios_knl_Swi_FuncPtr)NameServerRemoteNotify_swiFxnResponse,
-             &swiParams, eb);
+    /* initialize own side of message structs only */
+    for (i = 0; i < NameServerRemoteNotify_numRequests; i++) {
+        msg = obj->msg[offset] + i;
 
-    /* initialize own side of message struct only */
-    obj->msg[offset]->requestStatus = 0;
-    obj->msg[offset]->value = 0;
-    obj->msg[offset]->valueLen = 0;
+        msg->requestStatus = 0;
+        msg->value = 0;
+        msg->valueLen = 0;
 
-    memset(obj->msg[offset]->instanceName, 0,
-               sizeof(obj->msg[offset]->instanceName));
-    memset(obj->msg[offset]->name, 0,
-               sizeof(obj->msg[offset]->name));
+        memset(msg->instanceName, 0, sizeof(msg->instanceName));
+        memset(msg->name, 0, sizeof(msg->name));
+    }
 
     /* determine cacheability of the object from the regionId */
     obj->cacheEnable = SharedRegion_isCacheEnabled(obj->regionId);
     if (obj->cacheEnable) {
         /* write back shared memory that was modified */
-        Cache_wbInv(obj->msg[offset], sizeof(NameServerRemoteNotify_Message),
+        Cache_wbInv(obj->msg[offset], NameServerRemoteNotify_numRequests *
+                    sizeof(NameServerRemoteNotify_Message),
                     Cache_Type_ALL, TRUE);
     }
 
@@ -203,11 +218,6 @@ Void NameServerRemoteNotify_Instance_finalize(
                 NameServerRemoteNotify_notifyEventId);
     }
 
-    semHandle = NameServerRemoteNotify_Instance_State_semRemoteWait(obj);
-    if (semHandle != NULL) {
-        Semaphore_destruct(Semaphore_struct(semHandle));
-    }
-
     semHandle = NameServerRemoteNotify_Instance_State_semMultiBlock(obj);
     if (semHandle != NULL) {
         Semaphore_destruct(Semaphore_struct(semHandle));
@@ -217,11 +227,6 @@ Void NameServerRemoteNotify_Instance_finalize(
     if (swiHandle != NULL) {
         Swi_destruct(Swi_struct(swiHandle));
     }
-
-    swiHandle = NameServerRemoteNotify_Instance_State_swiResponse(obj);
-    if (swiHandle != NULL) {
-        Swi_destruct(Swi_struct(swiHandle));
-    }
 }
 
 /*
@@ -272,36 +277,51 @@ Void NameServerRemoteNotify_cbFxn(UInt16 procId, UInt16 lineId, UInt32 eventId,
         UArg arg, UInt32 payload)
 {
     NameServerRemoteNotify_Object *obj;
-    Swi_Handle swiHandle = NULL;
+    NameServerRemoteNotify_Waiter *waiter;
+    UInt slot = MSGSLOT(payload);
 
     obj = (NameServerRemoteNotify_Object *)arg;
 
-
-    switch (payload)
+    switch (MSGTYPE(payload))
     {
         case NameServerRemoteNotify_RequestMsg:
-            swiHandle = NameServerRemoteNotify_Instance_State_swiRequest(obj);
+            Assert_isTrue(slot < NameServerRemoteNotify_numRequests,
+                    Ipc_A_internal);
+
+            /* swiFxnRequest answers it, and returns the payload */
+            obj->requestIds[slot] = payload;
+            obj->requests |= (1 << slot);
 
             /* set object state (used by ROV) */
             obj->remoteState = NameServerRemoteNotify_RECEIVE_REQUEST;
+
+            Swi_post(NameServerRemoteNotify_Instance_State_swiRequest(obj));
             break;
 
         case NameServerRemoteNotify_ResponseMsg:
-            swiHandle = NameServerRemoteNotify_Instance_State_swiResponse(obj);
+            Assert_isTrue(slot < NameServerRemoteNotify_numRequests,
+                    Ipc_A_internal);
 
             /* set object state (used by ROV) */
             obj->localState = NameServerRemoteNotify_RECEIVE_RESPONSE;
+
+            /* wake the task, unless it stopped waiting for this request */
+            waiter = (NameServerRemoteNotify_Waiter *)obj->waiters[slot];
+            if ((waiter != NULL) && ((waiter->payload >> 8) == (payload >> 8))) {
+                Semaphore_post(Semaphore_handle(&waiter->sem));
+            }
+            break;
+
+        case NameServerRemoteNotify_InvalidateMsg:
+            /* the remote processor removed a name from an instance */
+            ti_sdo_utils_NameServer_flushCached(obj->remoteProcId,
+                    MSGKEY(payload));
             break;
 
         default:
             /* We should never get here but assert if we do */
-            Assert_isTrue(swiHandle != NULL, Ipc_A_internal);
-    }
-    if (swiHandle == NULL) {
-        return;
+            Assert_isTrue(FALSE, Ipc_A_internal);
     }
-
-    Swi_post(swiHandle);
 }
 
 /*
@@ -341,44 +361,70 @@ Int NameServerRemoteNotify_get(NameServerRemoteNotify_Object *obj,
     Int offset = 0;
     Int status;
     Int notifyStatus;
-    Semaphore_Handle semRemoteWait;
+    UInt key;
+    UInt slot;
+    Bits32 gen;
+    UInt32 cached;
     Semaphore_Handle semMultiBlock;
+    Semaphore_Params semParams;
+    NameServerRemoteNotify_Waiter waiter;
+    NameServerRemoteNotify_Message *msg;
 
     Assert_isTrue(*valueLen <= 300, NameServerRemoteNotify_A_invalidValueLen);
 
-    semRemoteWait = NameServerRemoteNotify_Instance_State_semRemoteWait(obj);
+    /* a name found before doesn't need a round trip */
+    if ((*valueLen == sizeof(UInt32)) &&
+            ti_sdo_utils_NameServer_getCached(obj->remoteProcId,
+            instanceName, name, &cached, &gen)) {
+        memcpy(value, &cached, sizeof(UInt32));
+        return (NameServer_S_SUCCESS);
+    }
+
     semMultiBlock = NameServerRemoteNotify_Instance_State_semMultiBlock(obj);
 
-    /* prevent multiple threads from entering */
+    /* wait for a free request slot */
     Semaphore_pend(semMultiBlock, BIOS_WAIT_FOREVER);
 
+    Semaphore_Params_init(&semParams);
+    Semaphore_construct(&waiter.sem, 0, &semParams);
+
+    /* take the slot, cbFxn looks at the waiters too */
+    key = Hwi_disable();
+    for (slot = 0; obj->waiters[slot] != NULL; slot++) {
+    }
+    obj->waiters[slot] = &waiter;
+    waiter.payload = NameServerRemoteNotify_RequestMsg | (slot << 8) |
+            ((UInt32)obj->seqNum++ << 16);
+    Hwi_restore(key);
+
     if (MultiProc_self() > obj->remoteProcId) {
         offset = 1;
     }
+    msg = obj->msg[offset] + slot;
 
     if (obj->cacheEnable) {
         /* Make sure there's no outstanding message */
-        Cache_inv(obj->msg[offset], sizeof(NameServerRemoteNotify_Message),
+        Cache_inv(msg, sizeof(NameServerRemoteNotify_Message),
                   Cache_Type_ALL, TRUE);
     }
 
     /* this is a request message */
-    obj->msg[offset]->requestStatus = 0;
-    obj->msg[offset]->valueLen = *valueLen;
+    msg->requestStatus = 0;
+    msg->valueLen = *valueLen;
 
     /* copy the name of instance into shared memory */
     len = strlen(instanceName);
-    strncpy((Char *)obj->msg[offset]->instanceName, instanceName, len + 1);
+    strncpy((Char *)msg->instanceName, instanceName, len + 1);
 
     /* copy the name of nameserver entry into shared memory */
     len = strlen(name);
-    strncpy((Char *)obj->msg[offset]->name, name, len + 1);
+    strncpy((Char *)msg->name, name, len + 1);
 
     /* set object state (used by ROV) */
     obj->localState = NameServerRemoteNotify_SEND_REQUEST;
 
     if (obj->cacheEnable) {
-        Cache_wbInv(obj->msg[offset], sizeof(NameServerRemoteNotify_Message),
+        Cache_wbInv(msg, sizeof(NameServerRemoteNotify_Message),
                     Cache_Type_ALL, TRUE);
     }
 
@@ -387,47 +433,55 @@ Int NameServerRemoteNotify_get(NameServerRemoteNotify_Object *obj,
      *  we hold the GateMP.
      */
     notifyStatus = Notify_sendEvent(obj->remoteProcId, 0,
-            NameServerRemoteNotify_notifyEventId,
-            NameServerRemoteNotify_RequestMsg, TRUE);
+            NameServerRemoteNotify_notifyEventId, waiter.payload, TRUE);
 
     if (notifyStatus < 0) {
         /* undo previous options */
-        obj->msg[offset]->valueLen = 0;
-
-        /* post the semaphore to make sure it doesn't block */
-        Semaphore_post(semMultiBlock);
+        msg->valueLen = 0;
+        status = FALSE;
+    }
+    else {
+        /* pend here until we get a notification back from remote processor */
+        status = Semaphore_pend(Semaphore_handle(&waiter.sem),
+                NameServerRemoteNotify_timeout);
 
-        return (retval);
+        if (status == FALSE) {
+            retval = NameServer_E_TIMEOUT;
+        }
     }
 
-    /* pend here until we get a notification back from remote processor */
-    status = Semaphore_pend(semRemoteWait, NameServerRemoteNotify_timeout);
+    /* give up the slot, a late response for it no longer finds us */
+    key = Hwi_disable();
+    obj->waiters[slot] = NULL;
+    Hwi_restore(key);
 
-    if (status == FALSE) {
-        retval = NameServer_E_TIMEOUT;
-    }
-    else {
+    Semaphore_destruct(&waiter.sem);
+
+    if (status != FALSE) {
         /* getting here means we got the notification back */
 
         if (obj->cacheEnable) {
-            Cache_inv(obj->msg[offset], sizeof(NameServerRemoteNotify_Message),
+            Cache_inv(msg, sizeof(NameServerRemoteNotify_Message),
                     Cache_Type_ALL, TRUE);
         }
 
         /* if successful request then copy to value */
-        if (obj->msg[offset]->requestStatus == TRUE) {
+        if (msg->requestStatus == TRUE) {
 
             /* copy to value */
-            if (obj->msg[offset]->valueLen == sizeof(UInt32)) {
-                memcpy(value, &(obj->msg[offset]->value), sizeof(UInt32));
+            if (msg->valueLen == sizeof(UInt32)) {
+                memcpy(value, &(msg->value), sizeof(UInt32));
+
+                /* remember it, unless the remote flushed us meanwhile */
+                ti_sdo_utils_NameServer_addCached(obj->remoteProcId,
+                        instanceName, name, msg->value, gen);
             }
             else {
-                memcpy(value, &(obj->msg[offset]->valueBuf),
-                       obj->msg[offset]->valueLen);
+                memcpy(value, &(msg->valueBuf), msg->valueLen);
             }
 
             /* set length to amount of data that was copied */
-            *valueLen = obj->msg[offset]->valueLen;
+            *valueLen = msg->valueLen;
 
             /* set the status */
             retval = NameServer_S_SUCCESS;
@@ -437,22 +491,48 @@ Int NameServerRemoteNotify_get(NameServerRemoteNotify_Object *obj,
         obj->localState = NameServerRemoteNotify_IDLE;
     }
 
+    /* post the semaphore to free the slot for another task */
     Semaphore_post(semMultiBlock);
 
     return (retval);
 }
 
+/*
+ *  ======== NameServerRemoteNotify_invalidate ========
+ *  Have the remote processor flush what it cached from instance
+ *  'instanceName' on this processor.  The payload carries the instance's
+ *  cache key above the message type.
+ */
+Void NameServerRemoteNotify_invalidate(NameServerRemoteNotify_Object *obj,
+        String instanceName)
+{
+    Notify_sendEvent(obj->remoteProcId, 0,
+            NameServerRemoteNotify_notifyEventId,
+            NameServerRemoteNotify_InvalidateMsg |
+            (ti_sdo_utils_NameServer_cacheKey(instanceName) << 8), TRUE);
+}
+
+/*
+ *  ======== NameServerRemoteNotify_announce ========
+ *  Misses are never cached, nothing to tell.
+ */
+Void NameServerRemoteNotify_announce(NameServerRemoteNotify_Object *obj,
+        String instanceName, String name)
+{
+}
+
 /*
  *  ======== NameServerRemoteNotify_sharedMemReq ========
  */
 SizeT NameServerRemoteNotify_sharedMemReq(Ptr sharedAddr)
 {
     /*
-     *  Two Message structs are required.
+     *  Two Message structs are required per request slot.
      *  One for sending request and one for sending response.
      */
     if (ti_sdo_utils_MultiProc_numProcessors > 1) {
-        return (2 * sizeof(NameServerRemoteNotify_Message));
+        return (2 * NameServerRemoteNotify_numRequests *
+                sizeof(NameServerRemoteNotify_Message));
     }
 
     return (0);
@@ -463,11 +543,15 @@ SizeT NameServerRemoteNotify_sharedMemReq(Ptr sharedAddr)
  */
 Void NameServerRemoteNotify_swiFxnRequest(UArg arg)
 {
-    Int count = NameServer_E_FAIL;
+    Int count;
     Int remoteId;
     UInt32 valueLen;
+    UInt key;
+    UInt slot;
+    Bits32 requests;
     NameServer_Handle handle;
     NameServerRemoteNotify_Object *obj;
+    NameServerRemoteNotify_Message *msg;
 #ifndef xdc_runtime_Assert_DISABLE_ALL
     Int status;
 #endif
@@ -477,75 +561,75 @@ Void NameServerRemoteNotify_swiFxnRequest(UArg arg)
     /* compute index to remote message */
     remoteId = (MultiProc_self() > obj->remoteProcId) ? 0 : 1;
 
-    if (obj->cacheEnable) {
-        Cache_inv(obj->msg[remoteId], sizeof(NameServerRemoteNotify_Message),
-                Cache_Type_ALL, TRUE);
-    }
+    /* take the requests cbFxn has seen so far */
+    key = Hwi_disable();
+    requests = obj->requests;
+    obj->requests = 0;
+    Hwi_restore(key);
 
-    /* get the NameServer handle */
-    handle = NameServer_getHandle((String)obj->msg[remoteId]->instanceName);
-    valueLen = obj->msg[remoteId]->valueLen;
+    for (slot = 0; requests != 0; slot++, requests >>= 1) {
+        if ((requests & 1) == 0) {
+            continue;
+        }
+
+        msg = obj->msg[remoteId] + slot;
+        count = NameServer_E_FAIL;
 
-    if (handle != NULL) {
-        /* Search for the NameServer entry */
-        if (valueLen == sizeof(UInt32)) {
-            count = NameServer_getLocalUInt32(handle,
-                (String)obj->msg[remoteId]->name, &obj->msg[remoteId]->value);
+        if (obj->cacheEnable) {
+            Cache_inv(msg, sizeof(NameServerRemoteNotify_Message),
+                    Cache_Type_ALL, TRUE);
         }
-        else {
-            count = NameServer_getLocal(handle,
-                (String)obj->msg[remoteId]->name,
-                &obj->msg[remoteId]->valueBuf, &valueLen);
+
+        /* get the NameServer handle */
+        handle = NameServer_getHandle((String)msg->instanceName);
+        valueLen = msg->valueLen;
+
+        if (handle != NULL) {
+            /* Search for the NameServer entry */
+            if (valueLen == sizeof(UInt32)) {
+                count = NameServer_getLocalUInt32(handle,
+                    (String)msg->name, &msg->value);
+            }
+            else {
+                count = NameServer_getLocal(handle,
+                    (String)msg->name, &msg->valueBuf, &valueLen);
+            }
         }
-    }
 
-    /*
-     *  If an entry was found, set requestStatus to TRUE
-     *  and valueLen to the size of data that was copied.
-     */
-    if (count == NameServer_S_SUCCESS) {
-        obj->msg[remoteId]->requestStatus = TRUE;
-        obj->msg[remoteId]->valueLen = valueLen;
-    }
+        /*
+         *  If an entry was found, set requestStatus to TRUE
+         *  and valueLen to the size of data that was copied.
+         */
+        if (count == NameServer_S_SUCCESS) {
+            msg->requestStatus = TRUE;
+            msg->valueLen = valueLen;
+        }
 
-    /* set object state (used by ROV) */
-    obj->remoteState = NameServerRemoteNotify_SEND_RESPONSE;
+        /* set object state (used by ROV) */
+        obj->remoteState = NameServerRemoteNotify_SEND_RESPONSE;
 
-    if (obj->cacheEnable) {
-        Cache_wbInv(obj->msg[remoteId], sizeof(NameServerRemoteNotify_Message),
-                Cache_Type_ALL, TRUE);
-    }
+        if (obj->cacheEnable) {
+            Cache_wbInv(msg, sizeof(NameServerRemoteNotify_Message),
+                    Cache_Type_ALL, TRUE);
+        }
 
-    /* must wait to prevent dropped events, even though this is a swi */
+        /* must wait to prevent dropped events, even though this is a swi */
 #ifndef xdc_runtime_Assert_DISABLE_ALL
-    status =
+        status =
 #endif
-    Notify_sendEvent(obj->remoteProcId, 0,
-            NameServerRemoteNotify_notifyEventId,
-            NameServerRemoteNotify_ResponseMsg, TRUE);
+        Notify_sendEvent(obj->remoteProcId, 0,
+                NameServerRemoteNotify_notifyEventId,
+                (obj->requestIds[slot] & ~0xFF) |
+                NameServerRemoteNotify_ResponseMsg, TRUE);
 
-    /* The NS query could fail, but the reply should never fail */
-    Assert_isTrue(status >= 0, Ipc_A_internal);
+        /* The NS query could fail, but the reply should never fail */
+        Assert_isTrue(status >= 0, Ipc_A_internal);
+    }
 
     /* set object state (used by ROV) */
     obj->remoteState = NameServerRemoteNotify_IDLE;
 }
 
-/*
- *  ======== NameServerRemoteNotify_swiFxnResponse ========
- */
-Void NameServerRemoteNotify_swiFxnResponse(UArg arg)
-{
-    NameServerRemoteNotify_Object *obj;
-    Semaphore_Handle  sem;
-
-    obj = (NameServerRemoteNotify_Object *)arg;
-
-    /* post the semaphore to unblock waiting task */
-    sem = NameServerRemoteNotify_Instance_State_semRemoteWait(obj);
-    Semaphore_post(sem);
-}
-
 /*
  *  ======== NameServerRemoteNotify_getHandle ========
  */
@@ -92,6 +92,16 @@ function module$validate()
                 ") is too big: Notify.numEvents = " + Notify.numEvents,
                 NameServerRemoteNotify);
     }
+
+    if ((NameServerRemoteNotify.numRequests < 1) ||
+        (NameServerRemoteNotify.numRequests >
+            NameServerRemoteNotify.MAXREQUESTS)) {
+        NameServerRemoteNotify.$logFatal(
+                "NameServerRemoteNotify.numRequests (" +
+                NameServerRemoteNotify.numRequests + ") must be between 1 " +
+                "and " + NameServerRemoteNotify.MAXREQUESTS,
+                NameServerRemoteNotify);
+    }
 }
 
 /*
@@ -91,21 +91,47 @@ Void TransportShm_swiFxn(UArg arg)
     UInt32 queueId;
     TransportShm_Object *obj = (TransportShm_Object *)arg;
     MessageQ_Msg msg = NULL;
+    MessageQ_Msg next;
+
+    if (TransportShm_spscLength != 0) {
+        /*
+         *  While there are messages, get them out and send them to
+         *  their final destination. getHead doesn't take the gate.
+         */
+        msg = (MessageQ_Msg)ListMP_getHead((ListMP_Handle)obj->localList);
+        while (msg != NULL) {
+            /* Get the destination message queue Id */
+            queueId = MessageQ_getDstQueue(msg);
+
+            /* put the message to the destination queue */
+            MessageQ_put(queueId, msg);
+
+            /* check to see if there are more messages */
+            msg = (MessageQ_Msg)ListMP_getHead((ListMP_Handle)obj->localList);
+        }
+
+        return;
+    }
 
     /*
-     *  While there are messages, get them out and send them to
-     *  their final destination.
+     *  Take all queued messages with one gate entry and send them to
+     *  their final destination. Repeat for any that arrived meanwhile.
      */
-    msg = (MessageQ_Msg)ListMP_getHead((ListMP_Handle)obj->localList);
-    while (msg != NULL) {
-        /* Get the destination message queue Id */
-        queueId = MessageQ_getDstQueue(msg);
+    while ((msg = (MessageQ_Msg)ListMP_getAll(
+            (ListMP_Handle)obj->localList)) != NULL) {
+        while (msg != NULL) {
+            /* MessageQ_put reuses the links, so get the next one first */
+            next = (MessageQ_Msg)ListMP_next((ListMP_Handle)obj->localList,
+                    (ListMP_Elem *)msg);
 
-        /* put the message to the destination queue */
-        MessageQ_put(queueId, msg);
+            /* Get the destination message queue Id */
+            queueId = MessageQ_getDstQueue(msg);
 
-        /* check to see if there are more messages */
-        msg = (MessageQ_Msg)ListMP_getHead((ListMP_Handle)obj->localList);
+            /* put the message to the destination queue */
+            MessageQ_put(queueId, msg);
+
+            msg = next;
+        }
     }
 }
 
@@ -211,11 +237,13 @@ Int TransportShm_Instance_init(TransportShm_Object *obj,
 
     ListMP_Params_init(&(listMPParams[0]));
     listMPParams[0].gate = (GateMP_Handle)obj->gate;
+    listMPParams[0].spscLength = TransportShm_spscLength;
     listMPParams[0].sharedAddr = (UInt32 *)((UArg)(obj->other) +
         (_Ipc_roundup(sizeof(TransportShm_Attrs), minAlign)));
 
     ListMP_Params_init(&listMPParams[1]);
     listMPParams[1].gate = (GateMP_Handle)obj->gate;
+    listMPParams[1].spscLength = TransportShm_spscLength;
     listMPParams[1].sharedAddr = (UInt32 *)((UArg)(listMPParams[0].sharedAddr)
         + ListMP_sharedMemReq(&listMPParams[0]));
 
@@ -401,6 +429,33 @@ Bool TransportShm_put(TransportShm_Object *obj, Ptr msg)
             TRUE);
     }
 
+    if (TransportShm_spscLength != 0) {
+        /*
+         *  This processor is the only producer of remoteList, so the put
+         *  doesn't need the GateMP.
+         */
+        status = ListMP_putTail((ListMP_Handle)obj->remoteList,
+            (ListMP_Elem *)msg);
+        if (status < 0) {
+            return (FALSE);
+        }
+
+        status = Notify_sendEvent(obj->remoteProcId, 0,
+            TransportShm_notifyEventId, 0, FALSE);
+
+        /*
+         *  Take the message back and return 'FALSE', unless the remote is
+         *  already reading it or it went to the gated list.  Then it is
+         *  picked up with the next event.
+         */
+        if (status < 0) {
+            retval = !_ListMP_spscRetract((ListMP_Handle)obj->remoteList,
+                (ListMP_Elem *)msg);
+        }
+
+        return (retval);
+    }
+
     /* make sure ListMP_put and sendEvent are done before remote executes */
     key = GateMP_enter((GateMP_Handle)obj->gate);
 
@@ -534,6 +589,7 @@ SizeT TransportShm_sharedMemReq(const TransportShm_Params *params)
 
     ListMP_Params_init(&listMPParams);
     listMPParams.regionId = regionId;
+    listMPParams.spscLength = TransportShm_spscLength;
 
     /* for localListMP */
     memReq += ListMP_sharedMemReq(&listMPParams);
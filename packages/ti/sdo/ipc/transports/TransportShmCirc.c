@@ -34,11 +34,13 @@
  */
 
 #include <xdc/std.h>
+#include <string.h>
 
 #include <xdc/runtime/Assert.h>
 #include <xdc/runtime/Error.h>
 #include <xdc/runtime/Memory.h>
 
+#include <ti/sysbios/BIOS.h>
 #include <ti/sysbios/hal/Cache.h>
 #include <ti/sysbios/hal/Hwi.h>
 #include <ti/sysbios/knl/Swi.h>
@@ -58,12 +60,30 @@
 #define CLEAR_BIT(num,pos)          ((num) &= ~(1u << (pos)))
 #define TEST_BIT(num,pos)           ((num) & (1u << (pos)))
 
+/* Address of slot 'index' in a put or get buffer */
+#define TransportShmCirc_slot(buf, index) \
+        ((UInt32 *)((UArg)(buf) + ((index) * TransportShmCirc_slotSize)))
+
+/*
+ *  Whether put() copies the message into the slot instead of its SRPtr.
+ *  put() then frees it, so unless 'canBlock' only msgs whose free can't
+ *  block are copied.
+ */
+#define TransportShmCirc_isInline(msg, canBlock) \
+        ((TransportShmCirc_inlineMsgSize != 0) && \
+        (((MessageQ_Msg)(msg))->msgSize <= TransportShmCirc_inlineMsgSize) && \
+        (((MessageQ_Msg)(msg))->heapId != ti_sdo_ipc_MessageQ_STATICMSG) && \
+        ((canBlock) || !_MessageQ_freeMayBlock((MessageQ_Msg)(msg))))
+
 /* Need to use reserved notify events */
 #undef TransportShmCirc_notifyEventId
 #define TransportShmCirc_notifyEventId \
         ti_sdo_ipc_transports_TransportShmCirc_notifyEventId + \
                     (UInt32)((UInt32)Notify_SYSTEMKEY << 16)
 
+static Int TransportShmCirc_putMsgs(TransportShmCirc_Object *obj,
+        Ptr *msgs, UInt num);
+
 /*
  *************************************************************************
  *                       Instance functions
@@ -128,7 +148,8 @@ Int TransportShmCirc_Instance_init(TransportShmCirc_Object *obj,
 
     /* calculate the circular buffer size one-way */
     circBufSize =
-        _Ipc_roundup(sizeof(Bits32) * TransportShmCirc_numMsgs, minAlign);
+        _Ipc_roundup(TransportShmCirc_slotSize * TransportShmCirc_numMsgs,
+        minAlign);
 
     /* calculate the control size one-way */
     ctrlSize = _Ipc_roundup(sizeof(Bits32), minAlign);
@@ -157,7 +178,7 @@ Int TransportShmCirc_Instance_init(TransportShmCirc_Object *obj,
     /*
      *  Calculate the size for cache inv in isr.
      *  This size is the circular buffer + putWriteIndex.
-     *  [sizeof(Ptr) * numMsgs] + [the sizeof(Ptr)]
+     *  [slotSize * numMsgs] + [the sizeof(Ptr)]
      *  aligned to a cache line.
      */
     obj->opCacheSize = ((UArg)obj->putReadIndex - (UArg)obj->putBuffer);
@@ -194,6 +215,8 @@ Int TransportShmCirc_Instance_init(TransportShmCirc_Object *obj,
     /* init the putWrite and putRead Index to 0 */
     obj->putWriteIndex[0] = 0;
     obj->putReadIndex[0] = 0;
+    obj->reserveIndex = 0;
+    obj->numFilling = 0;
 
     /* cache wb the putWrite/Read Index but no need to inv them */
     if (obj->cacheEnabled) {
@@ -235,132 +258,26 @@ Void TransportShmCirc_Instance_finalize(TransportShmCirc_Object *obj, Int status
  */
 Bool TransportShmCirc_put(TransportShmCirc_Object *obj, Ptr msg)
 {
-    Int status;
-    UInt hwiKey;
-    SharedRegion_SRPtr msgSRPtr;
-    UInt32 *eventEntry;
-    UInt32 writeIndex, readIndex;
-    Bool loop       = FALSE;
-    UInt16 regionId = SharedRegion_INVALIDREGIONID;
-
-    /*
-     *  If translation is disabled and we always have to write back the
-     *  message then we can avoid calling SharedRegion_getId(). The wait
-     *  flag is "FALSE" here because we do other cache calls below.
-     */
-    if (ti_sdo_ipc_SharedRegion_translate ||
-        !TransportShmCirc_alwaysWriteBackMsg ) {
-        regionId = SharedRegion_getId(msg);
-        if (SharedRegion_isCacheEnabled(regionId)) {
-            Cache_wbInv(msg, ((MessageQ_Msg)(msg))->msgSize, Cache_Type_ALL,
-                        FALSE);
-        }
-    }
-    else {
-        Cache_wbInv(msg, ((MessageQ_Msg)(msg))->msgSize, Cache_Type_ALL, FALSE);
-    }
-
-    /*
-     *  Get the msg's SRPtr.  OK if (regionId == SharedRegion_INVALIDID &&
-     *  SharedRegion_translate == FALSE)
-     */
-    msgSRPtr = SharedRegion_getSRPtr(msg, regionId);
-
-    /*
-     *  Retrieve the get Index. No need to cache inv the
-     *  readIndex until the writeIndex wraps. Only need to invalidate
-     *  once every N times [N = number of messages].
-     */
-    readIndex = obj->putReadIndex[0];
-
-    do {
-        /* disable interrupts */
-        hwiKey = Hwi_disable();
-
-        /* retrieve the put index */
-        writeIndex = obj->putWriteIndex[0];
-
-        /* if slot available 'break' out of loop */
-        if (((writeIndex + 1) & TransportShmCirc_maxIndex) != readIndex) {
-            break;
-        }
-
-        /* restore interrupts */
-        Hwi_restore(hwiKey);
-
-        /* check to make sure code has looped */
-        if (loop) {
-            /* if no slot available */
-            return (FALSE);
-        }
-
-        /* cache invalidate the putReadIndex */
-        if (obj->cacheEnabled) {
-            Cache_inv(obj->putReadIndex,
-                      sizeof(Bits32),
-                      Cache_Type_ALL,
-                      TRUE);
-        }
-
-        /* re-read the putReadIndex */
-        readIndex = obj->putReadIndex[0];
-
-        /* convey that the code has looped around */
-        loop = TRUE;
-    } while (1);
-
-    /* interrupts are disabled at this point */
-
-    /* calculate the next available entry */
-    eventEntry = (UInt32 *)(
-        (UArg)obj->putBuffer + (writeIndex * sizeof(Ptr)));
-
-    /* Set the eventId field and payload for the entry */
-    eventEntry[0] = msgSRPtr;
-
-    /*
-     *  Writeback the event entry. No need to invalidate since
-     *  only one processor ever writes here. No need to wait for
-     *  cache operation since another cache operation is done below.
-     */
-    if (obj->cacheEnabled) {
-        Cache_wb(eventEntry,
-                 sizeof(Ptr),
-                 Cache_Type_ALL,
-                 FALSE);
-    }
-
-    /* update the putWriteIndex */
-    obj->putWriteIndex[0] = (writeIndex + 1) & TransportShmCirc_maxIndex;
-
-    /* restore interrupts */
-    Hwi_restore(hwiKey);
+    return (TransportShmCirc_putMsgs(obj, &msg, 1) == 1);
+}
 
-    /*
-     *  Writeback the putWriteIndex.
-     *  No need to invalidate since only one processor
-     *  ever writes here.
-     */
-    if (obj->cacheEnabled) {
-        Cache_wb(obj->putWriteIndex,
-                 sizeof(Bits32),
-                 Cache_Type_ALL,
-                 TRUE);
-    }
+/*
+ *  ======== TransportShmCirc_putBatch ========
+ */
+Int TransportShmCirc_putBatch(TransportShmCirc_Object *obj, UInt32 queueId,
+        Ptr *msgs, UInt num)
+{
+    UInt i;
 
-    /* Notify the remote processor */
-    status = Notify_sendEvent(
-                 obj->remoteProcId,
-                 0,
-                 TransportShmCirc_notifyEventId,
-                 0,
-                 FALSE);
+    Assert_isTrue((msgs != NULL) || (num == 0), ti_sdo_ipc_Ipc_A_nullArgument);
 
-    if (status < 0) {
-        return (FALSE);
+    /* address the messages the same way MessageQ_put() does */
+    for (i = 0; i < num; i++) {
+        ((MessageQ_Msg)(msgs[i]))->dstId   = (UInt16)(queueId);
+        ((MessageQ_Msg)(msgs[i]))->dstProc = (UInt16)(queueId >> 16);
     }
 
-    return (TRUE);
+    return (TransportShmCirc_putMsgs(obj, msgs, num));
 }
 
 /*
@@ -414,6 +331,7 @@ Void TransportShmCirc_swiFxn(UArg arg)
     UInt32 queueId;
     MessageQ_Msg msg;
     UInt32 writeIndex, readIndex;
+    UInt16 heapId;
 
     obj = (TransportShmCirc_Object *)arg;
 
@@ -439,24 +357,42 @@ Void TransportShmCirc_swiFxn(UArg arg)
     readIndex = obj->getReadIndex[0];
 
     /* get the next entry to be processed */
-    eventEntry = (UInt32 *)&(obj->getBuffer[readIndex]);
+    eventEntry = TransportShmCirc_slot(obj->getBuffer, readIndex);
 
     while (writeIndex != readIndex) {
-        /* get the msg (convert SRPtr to Ptr) */
-        msg = SharedRegion_getPtr((SharedRegion_SRPtr)eventEntry[0]);
-
-        /* Make sure the msg Ptr is not NULL */
-        Assert_isTrue(msg != NULL, ti_sdo_ipc_Ipc_A_internal);
-        /* Additional check to handle case when Assert is disabled */
-        if (msg == NULL) {
-            return;
+        if ((TransportShmCirc_inlineMsgSize != 0) && (eventEntry[1] != 0)) {
+            /* copy the inlined msg out of the slot into a local msg */
+            msg = MessageQ_alloc(TransportShmCirc_inlineHeapId, eventEntry[1]);
+
+            Assert_isTrue(msg != NULL,
+                ti_sdo_ipc_transports_TransportShmCirc_A_inlineAllocFailed);
+
+            if (msg != NULL) {
+                heapId = msg->heapId;
+                memcpy(msg, &eventEntry[2], eventEntry[1]);
+                msg->heapId = heapId;
+            }
+        }
+        else {
+            /* get the msg (convert SRPtr to Ptr) */
+            msg = SharedRegion_getPtr((SharedRegion_SRPtr)eventEntry[0]);
+
+            /* Make sure the msg Ptr is not NULL */
+            Assert_isTrue(msg != NULL, ti_sdo_ipc_Ipc_A_internal);
+            /* Additional check to handle case when Assert is disabled */
+            if (msg == NULL) {
+                return;
+            }
         }
 
-        /* get the queue id */
-        queueId = MessageQ_getDstQueue(msg);
+        /* a msg that could not be allocated is dropped */
+        if (msg != NULL) {
+            /* get the queue id */
+            queueId = MessageQ_getDstQueue(msg);
 
-        /* put message on local queue */
-        MessageQ_put(queueId, msg);
+            /* put message on local queue */
+            MessageQ_put(queueId, msg);
+        }
 
         /* update the local readIndex. */
         readIndex = ((readIndex + 1) & TransportShmCirc_maxIndex);
@@ -483,7 +419,31 @@ Void TransportShmCirc_swiFxn(UArg arg)
         }
 
         /* get the next entry */
-        eventEntry = (UInt32 *)&(obj->getBuffer[readIndex]);
+        eventEntry = TransportShmCirc_slot(obj->getBuffer, readIndex);
+
+        /*
+         *  With doorbellOnEmpty the sender does not notify while we are
+         *  draining.  Before going idle publish the readIndex and wait for
+         *  it, then look at the getWriteIndex again so a message put in
+         *  the meantime is not left behind.
+         */
+        if ((TransportShmCirc_doorbellOnEmpty) && (writeIndex == readIndex)) {
+            if (obj->cacheEnabled) {
+                Cache_wb(obj->getReadIndex,
+                         sizeof(Bits32),
+                         Cache_Type_ALL,
+                         TRUE);
+
+                Cache_inv(obj->getBuffer,
+                          obj->opCacheSize,
+                          Cache_Type_ALL,
+                          TRUE);
+            }
+
+            /* the getReadIndex store must be seen before this read */
+            _Ipc_memoryBarrier();
+            writeIndex = obj->getWriteIndex[0];
+        }
     }
 }
 
@@ -507,10 +467,10 @@ SizeT TransportShmCirc_sharedMemReq(const TransportShmCirc_Params *params)
 
     /*
      *  Amount of shared memory:
-     *  1 putBuffer with numMsgs (rounded to CLS) +
+     *  1 putBuffer with numMsgs slots (rounded to CLS) +
      *  1 putWriteIndex ptr (rounded to CLS) +
      *  1 putReadIndex put (rounded to CLS) +
-     *  1 getBuffer with numMsgs (rounded to CLS) +
+     *  1 getBuffer with numMsgs slots (rounded to CLS) +
      *  1 getWriteIndex ptr (rounded to CLS) +
      *  1 getReadIndex put (rounded to CLS) +
      *
@@ -520,7 +480,8 @@ SizeT TransportShmCirc_sharedMemReq(const TransportShmCirc_Params *params)
      *  Note: CLS means Cache Line Size
      */
     memReq = 2 * (
-        (_Ipc_roundup(sizeof(Ptr) * TransportShmCirc_numMsgs, minAlign)) +
+        (_Ipc_roundup(TransportShmCirc_slotSize * TransportShmCirc_numMsgs,
+        minAlign)) +
         ( 2 * _Ipc_roundup(sizeof(Bits32), minAlign)));
 
     return (memReq);
@@ -533,3 +494,241 @@ Void TransportShmCirc_setErrFxn(TransportShmCirc_ErrFxn errFxn)
 {
     /* Ignore the errFxn */
 }
+
+/*
+ *************************************************************************
+ *                       Internal functions
+ *************************************************************************
+ */
+
+/*
+ *  ======== TransportShmCirc_putMsgs ========
+ *  Copy up to 'num' messages, or their SRPtrs, into the put buffer, write
+ *  back the put index once and notify the remote processor once.  Returns
+ *  the number of messages sent.
+ *
+ *  The slots are reserved with interrupts disabled and filled with them
+ *  enabled.  Task and Swi puts run with Swis disabled, so only a Hwi put
+ *  can come in between.  Such a put leaves its slots to the one it
+ *  interrupted, which publishes every slot reserved so far.
+ */
+static Int TransportShmCirc_putMsgs(TransportShmCirc_Object *obj,
+        Ptr *msgs, UInt num)
+{
+    UInt hwiKey;
+    UInt swiKey = 0;
+    UInt i;
+    UInt16 regionId;
+    UInt32 *eventEntry;
+    UInt32 writeIndex, readIndex, firstIndex, prevIndex = 0;
+    UInt32 avail, tail;
+    Bool isHwi;
+    Bool canBlock;
+    Bool notify = FALSE;
+
+    /* an inlined msg is freed here, in a Hwi or Swi only if that can't block */
+    isHwi = (BIOS_getThreadType() == BIOS_ThreadType_Hwi);
+    canBlock = (BIOS_getThreadType() == BIOS_ThreadType_Task) ||
+               (BIOS_getThreadType() == BIOS_ThreadType_Main);
+
+    /*
+     *  Write back the messages outside of the Hwi gate.  If translation is
+     *  disabled and we always have to write back the message then we can
+     *  avoid calling SharedRegion_getId(). The wait flag is "FALSE" here
+     *  because we do other cache calls below.
+     */
+    for (i = 0; i < num; i++) {
+        /* an inlined msg is copied into the slot instead */
+        if (TransportShmCirc_isInline(msgs[i], canBlock)) {
+            continue;
+        }
+
+        if (ti_sdo_ipc_SharedRegion_translate ||
+            !TransportShmCirc_alwaysWriteBackMsg) {
+            regionId = SharedRegion_getId(msgs[i]);
+            if (SharedRegion_isCacheEnabled(regionId)) {
+                Cache_wbInv(msgs[i], ((MessageQ_Msg)(msgs[i]))->msgSize,
+                            Cache_Type_ALL, FALSE);
+            }
+        }
+        else {
+            Cache_wbInv(msgs[i], ((MessageQ_Msg)(msgs[i]))->msgSize,
+                        Cache_Type_ALL, FALSE);
+        }
+    }
+
+    /*
+     *  Retrieve the get Index. No need to cache inv the
+     *  readIndex until the writeIndex wraps. Only need to invalidate
+     *  once every N times [N = number of messages].
+     */
+    readIndex = obj->putReadIndex[0];
+
+    if (!isHwi) {
+        swiKey = Swi_disable();
+    }
+
+    /* disable interrupts */
+    hwiKey = Hwi_disable();
+
+    /* the next slot not yet handed out */
+    writeIndex = obj->reserveIndex;
+    avail = (readIndex - writeIndex - 1) & TransportShmCirc_maxIndex;
+
+    if (avail < num) {
+        /* restore interrupts */
+        Hwi_restore(hwiKey);
+
+        /* cache invalidate the putReadIndex and re-read it once */
+        if (obj->cacheEnabled) {
+            Cache_inv(obj->putReadIndex,
+                      sizeof(Bits32),
+                      Cache_Type_ALL,
+                      TRUE);
+        }
+        readIndex = obj->putReadIndex[0];
+
+        hwiKey = Hwi_disable();
+        writeIndex = obj->reserveIndex;
+        avail = (readIndex - writeIndex - 1) & TransportShmCirc_maxIndex;
+
+        if (avail < num) {
+            num = avail;
+        }
+    }
+
+    if (num == 0) {
+        /* if no slot available */
+        Hwi_restore(hwiKey);
+        if (!isHwi) {
+            Swi_restore(swiKey);
+        }
+        return (0);
+    }
+
+    /* reserve the slots */
+    firstIndex = writeIndex;
+    obj->reserveIndex = (writeIndex + num) & TransportShmCirc_maxIndex;
+    obj->numFilling++;
+
+    /* restore interrupts */
+    Hwi_restore(hwiKey);
+
+    for (i = 0; i < num; i++) {
+        eventEntry = TransportShmCirc_slot(obj->putBuffer, writeIndex);
+
+        if (TransportShmCirc_isInline(msgs[i], canBlock)) {
+            /* small msg: the slot carries a copy of it */
+            eventEntry[0] = ti_sdo_ipc_SharedRegion_INVALIDSRPTR;
+            eventEntry[1] = ((MessageQ_Msg)(msgs[i]))->msgSize;
+            memcpy(&eventEntry[2], msgs[i], eventEntry[1]);
+        }
+        else {
+            /* the SRPtr; translation is one compare on a SharedRegion hit */
+            regionId = ti_sdo_ipc_SharedRegion_translate ?
+                SharedRegion_getId(msgs[i]) : SharedRegion_INVALIDREGIONID;
+
+            eventEntry[0] = SharedRegion_getSRPtr(msgs[i], regionId);
+            if (TransportShmCirc_inlineMsgSize != 0) {
+                eventEntry[1] = 0;
+            }
+        }
+
+        writeIndex = (writeIndex + 1) & TransportShmCirc_maxIndex;
+    }
+
+    /*
+     *  Writeback the event entries, in two pieces if they wrapped. No need
+     *  to invalidate since only one processor ever writes here. No need to
+     *  wait for cache operation since another cache operation is done
+     *  below.
+     */
+    if (obj->cacheEnabled) {
+        tail = TransportShmCirc_numMsgs - firstIndex;
+        if (num <= tail) {
+            Cache_wb(TransportShmCirc_slot(obj->putBuffer, firstIndex),
+                     num * TransportShmCirc_slotSize, Cache_Type_ALL, FALSE);
+        }
+        else {
+            Cache_wb(TransportShmCirc_slot(obj->putBuffer, firstIndex),
+                     tail * TransportShmCirc_slotSize, Cache_Type_ALL, FALSE);
+            Cache_wb(obj->putBuffer, (num - tail) * TransportShmCirc_slotSize,
+                     Cache_Type_ALL, FALSE);
+        }
+    }
+    else {
+        /* the slots must land before the putWriteIndex */
+        _Ipc_memoryBarrier();
+    }
+
+    /* the last put still filling publishes every reserved slot */
+    hwiKey = Hwi_disable();
+    obj->numFilling--;
+    if (obj->numFilling == 0) {
+        prevIndex = obj->putWriteIndex[0];
+        obj->putWriteIndex[0] = obj->reserveIndex;
+        notify = TRUE;
+    }
+    Hwi_restore(hwiKey);
+
+    if (!isHwi) {
+        Swi_restore(swiKey);
+    }
+
+    /*
+     *  Writeback the putWriteIndex.
+     *  No need to invalidate since only one processor
+     *  ever writes here.
+     */
+    if ((notify) && (obj->cacheEnabled)) {
+        Cache_wb(obj->putWriteIndex,
+                 sizeof(Bits32),
+                 Cache_Type_ALL,
+                 TRUE);
+    }
+
+    /*
+     *  With doorbellOnEmpty only ring if the remote processor has already
+     *  consumed everything before these messages.  Otherwise it is still
+     *  draining and re-reads the putWriteIndex after publishing its read
+     *  index, see swiFxn.
+     */
+    if ((notify) && (TransportShmCirc_doorbellOnEmpty)) {
+        /*
+         *  The putWriteIndex store must be seen before the putReadIndex is
+         *  read, the remote does the same the other way around.
+         */
+        _Ipc_memoryBarrier();
+
+        if (obj->cacheEnabled) {
+            Cache_inv(obj->putReadIndex,
+                      sizeof(Bits32),
+                      Cache_Type_ALL,
+                      TRUE);
+        }
+
+        notify = (obj->putReadIndex[0] == prevIndex);
+    }
+
+    if (notify) {
+        /*
+         *  Notify the remote processor.  The msgs are already in the buffer
+         *  and the remote may be reading them, so they can't be taken back
+         *  if this fails.  They are picked up with the next event and are
+         *  reported as sent.
+         */
+        Notify_sendEvent(obj->remoteProcId, 0, TransportShmCirc_notifyEventId,
+                0, FALSE);
+    }
+
+    /* the inlined msgs were copied into the slots, free them now */
+    if (TransportShmCirc_inlineMsgSize != 0) {
+        for (i = 0; i < num; i++) {
+            if (TransportShmCirc_isInline(msgs[i], canBlock)) {
+                MessageQ_free((MessageQ_Msg)(msgs[i]));
+            }
+        }
+    }
+
+    return ((Int)num);
+}
@@ -62,6 +62,15 @@ function module$static$init(mod, params)
 {
     TransportShmCirc.maxIndex = TransportShmCirc.numMsgs - 1;
     TransportShmCirc.modIndex = TransportShmCirc.numMsgs / 4;
+
+    /* an SRPtr, or an 8 byte header plus the inlined message */
+    if (TransportShmCirc.inlineMsgSize == 0) {
+        TransportShmCirc.slotSize = 4;
+    }
+    else {
+        TransportShmCirc.slotSize =
+            (8 + TransportShmCirc.inlineMsgSize + 7) & ~7;
+    }
 }
 
 /*
@@ -75,6 +84,15 @@ function module$validate()
                 ") is too big: Notify.numEvents = " + Notify.numEvents,
                 TransportShmNotify);
     }
+
+    /* an inlined message must at least hold a MessageQ header */
+    if ((TransportShmCirc.inlineMsgSize != 0) &&
+        (TransportShmCirc.inlineMsgSize < 32)) {
+        TransportShmCirc.$logError("TransportShmCirc.inlineMsgSize (" +
+                TransportShmCirc.inlineMsgSize +
+                ") must be 0 or at least the 32 byte MessageQ header",
+                TransportShmCirc, "inlineMsgSize");
+    }
 }
 
 /*
@@ -122,10 +140,13 @@ function getEventData(view, obj, bufferPtr, putIndex, getIndex)
         var bufferName = "get";
     }
 
+    /* number of Bits32 words per slot */
+    var stride = modCfg.slotSize / 4;
+
     try {
         var putBuffer = Program.fetchArray(ScalarStructs.S_Bits32$fetchDesc,
                                            bufferPtr,
-                                           modCfg.numMsgs);
+                                           modCfg.numMsgs * stride);
     }
     catch(e) {
         throw (new Error("Error fetching putBuffer struct from shared memory"));
@@ -139,10 +160,19 @@ function getEventData(view, obj, bufferPtr, putIndex, getIndex)
                 'ti.sdo.ipc.transports.TransportShmCirc',
                 'Events');
 
+        var slot = putBuffer[i * stride];
+
         elem.index = i;
         elem.buffer = bufferName;
-        elem.addr = utils.toHex(putBuffer[i].$addr);
-        elem.message = utils.toHex(putBuffer[i].elem);
+        elem.addr = utils.toHex(slot.$addr);
+
+        /* an inlined message is shown at its address in the slot */
+        if ((stride > 1) && (putBuffer[i * stride + 1].elem != 0)) {
+            elem.message = utils.toHex(Number(slot.$addr) + 8);
+        }
+        else {
+            elem.message = utils.toHex(slot.elem);
+        }
 
         /* Create a new row in the instance data view */
         view.elements.$add(elem);
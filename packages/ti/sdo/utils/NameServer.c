@@ -124,6 +124,20 @@
 
 #include "package/internal/NameServer.xdc.h"
 
+/* Entries placed at config time, which can't be removed */
+#define ISSTATIC(obj, entry) (((entry) >= (obj)->table) && \
+        ((entry) < (obj)->table + (obj)->numStatic))
+
+static UInt32 NameServer_hash(String name);
+static UInt NameServer_numBuckets(UInt num);
+static Void NameServer_hashInsert(ti_sdo_utils_NameServer_Object *obj,
+        ti_sdo_utils_NameServer_TableEntry *entry);
+static Void NameServer_hashRemove(ti_sdo_utils_NameServer_Object *obj,
+        ti_sdo_utils_NameServer_TableEntry *entry);
+static Void NameServer_invalidateRemotes(String instanceName);
+static Void NameServer_announceRemotes(String instanceName, String name);
+static UInt NameServer_cacheGenIndex(UInt16 procId, Bits32 instanceKey);
+
 #ifdef __ti__
     #pragma FUNC_EXT_CALLED(NameServer_Params_init);
     #pragma FUNC_EXT_CALLED(NameServer_add);
@@ -252,7 +266,20 @@ Ptr NameServer_add(NameServer_Handle handle, String name, Ptr value,
     strncpy(tableEntry->name, name, strlen(name) + 1);
 
     /* Add to the nameList */
-    List_put(nameList, (List_Elem *)tableEntry);
+    if (ti_sdo_utils_NameServer_hashIndex) {
+        tableEntry->hash = NameServer_hash(name);
+
+        /* The list and the index change together */
+        key = GateSwi_enter(NameServer_module->gate);
+        List_put(nameList, (List_Elem *)tableEntry);
+        NameServer_hashInsert(obj, tableEntry);
+        GateSwi_leave(NameServer_module->gate, key);
+    }
+    else {
+        List_put(nameList, (List_Elem *)tableEntry);
+    }
+
+    NameServer_announceRemotes(obj->name, name);
 
     return (tableEntry);
 }
@@ -584,10 +611,37 @@ Int NameServer_remove(NameServer_Handle handle, String name)
             (ti_sdo_utils_NameServer_Object *)handle;
     UInt i;
     IArg key;
+    UInt32 hash;
     Int status = NameServer_E_INVALIDARG;
     ti_sdo_utils_NameServer_TableEntry *tableEntry = NULL;
     List_Handle nameList = ti_sdo_utils_NameServer_Instance_State_nameList(obj);
 
+    if (ti_sdo_utils_NameServer_hashIndex) {
+        hash = NameServer_hash(name);
+
+        key = GateSwi_enter(NameServer_module->gate);
+
+        /* Walk the name's bucket, the static entries can't be removed */
+        tableEntry = obj->buckets[hash & obj->hashMask];
+        while (tableEntry != NULL) {
+            if ((tableEntry->hash == hash) && !ISSTATIC(obj, tableEntry) &&
+                    (strcmp(tableEntry->name, name) == 0)) {
+                NameServer_removeLocal(obj, tableEntry);
+                status = NameServer_S_SUCCESS;
+                break;
+            }
+            tableEntry = tableEntry->hashNext;
+        }
+
+        GateSwi_leave(NameServer_module->gate, key);
+
+        if (status == NameServer_S_SUCCESS) {
+            NameServer_invalidateRemotes(obj->name);
+        }
+
+        return (status);
+    }
+
     /* Skip over the static ones. They are always at the head of the list */
     for (i = 0; i < obj->numStatic; i++) {
         tableEntry = List_next(nameList, (List_Elem *)tableEntry);
@@ -609,6 +663,10 @@ Int NameServer_remove(NameServer_Handle handle, String name)
     /* Leave the gate */
     GateSwi_leave(NameServer_module->gate, key);
 
+    if (status == NameServer_S_SUCCESS) {
+        NameServer_invalidateRemotes(obj->name);
+    }
+
     return (status);
 }
 
@@ -622,6 +680,8 @@ Int NameServer_removeEntry(NameServer_Handle handle, Ptr entry)
 
     NameServer_removeLocal(obj, (ti_sdo_utils_NameServer_TableEntry *)entry);
 
+    NameServer_invalidateRemotes(obj->name);
+
     return (NameServer_S_SUCCESS);
 }
 
@@ -650,6 +710,8 @@ Int ti_sdo_utils_NameServer_Instance_init(
     obj->values        = NULL;
     obj->names         = NULL;
     obj->refCount      = 1;
+    obj->buckets       = NULL;
+    obj->hashMask      = 0;
 
     if (params->tableHeap == NULL) {
         obj->tableHeap = ti_sdo_utils_NameServer_Object_heap();
@@ -670,6 +732,24 @@ Int ti_sdo_utils_NameServer_Instance_init(
     List_construct(List_struct(freeList), NULL);
     List_construct(List_struct(nameList), NULL);
 
+    /* Allocate the (empty) hash index */
+    if (ti_sdo_utils_NameServer_hashIndex) {
+        if (obj->numDynamic == NameServer_ALLOWGROWTH) {
+            obj->hashMask = NameServer_numBuckets(
+                    ti_sdo_utils_NameServer_growthHashBuckets) - 1;
+        }
+        else {
+            obj->hashMask = NameServer_numBuckets(obj->numDynamic) - 1;
+        }
+
+        obj->buckets = Memory_calloc(obj->tableHeap,
+            sizeof(ti_sdo_utils_NameServer_TableEntry *) *
+            (obj->hashMask + 1), 0, eb);
+        if (obj->buckets == NULL) {
+            return (4);
+        }
+    }
+
     /* Allocate the entry table. */
     if (obj->numDynamic != NameServer_ALLOWGROWTH) {
         obj->table = Memory_alloc(obj->tableHeap,
@@ -756,6 +836,12 @@ Void ti_sdo_utils_NameServer_Instance_finalize(
         }
     }
 
+    if (obj->buckets != NULL) {
+        Memory_free(obj->tableHeap, obj->buckets,
+                    sizeof(ti_sdo_utils_NameServer_TableEntry *) *
+                    (obj->hashMask + 1));
+    }
+
     List_destruct(List_struct(freeList));
     List_destruct(List_struct(nameList));
 }
@@ -779,6 +865,9 @@ Void ti_sdo_utils_NameServer_removeLocal(ti_sdo_utils_NameServer_Object *obj,
 
         key = GateSwi_enter(NameServer_module->gate);
         List_remove(nameList, (List_Elem *)entry);
+        if (ti_sdo_utils_NameServer_hashIndex) {
+            NameServer_hashRemove(obj, entry);
+        }
         GateSwi_leave(NameServer_module->gate, key);
 
         if (!(obj->maxValueLen == sizeof(UInt32))) {
@@ -795,6 +884,9 @@ Void ti_sdo_utils_NameServer_removeLocal(ti_sdo_utils_NameServer_Object *obj,
     else {
         key = GateSwi_enter(NameServer_module->gate);
         List_remove(nameList, (List_Elem *)entry);
+        if (ti_sdo_utils_NameServer_hashIndex) {
+            NameServer_hashRemove(obj, entry);
+        }
         GateSwi_leave(NameServer_module->gate, key);
 
         List_put(freeList, (List_Elem *)entry);
@@ -968,6 +1060,137 @@ Void ti_sdo_utils_NameServer_unregisterRemoteDriver(UInt16 procId)
     NameServer_module->nsRemoteHandle.elem[index] = NULL;
 
     Hwi_restore(key);
+
+    /* Nothing cached from the processor can be trusted anymore */
+    ti_sdo_utils_NameServer_flushCached(procId,
+            ti_sdo_utils_NameServer_ALLINSTANCES);
+}
+
+/*
+ *  ======== ti_sdo_utils_NameServer_getCached ========
+ */
+Bool ti_sdo_utils_NameServer_getCached(UInt16 procId, String instanceName,
+        String name, UInt32 *value, Bits32 *gen)
+{
+    ti_sdo_utils_NameServer_CacheEntry *entry;
+    Bool found = FALSE;
+    IArg key;
+    UInt i;
+
+    if (ti_sdo_utils_NameServer_remoteCacheSize == 0) {
+        return (FALSE);
+    }
+
+    /*
+     *  Read first, a flush of the instance after this voids what we look
+     *  up or add.  Entries of this procId and instance all share the
+     *  generation, so comparing with it is enough.
+     */
+    *gen = NameServer_module->cacheGen[NameServer_cacheGenIndex(procId,
+            ti_sdo_utils_NameServer_cacheKey(instanceName))];
+
+    key = GateSwi_enter(NameServer_module->gate);
+
+    for (i = 0; i < ti_sdo_utils_NameServer_remoteCacheSize; i++) {
+        entry = &NameServer_module->cache[i];
+        if ((entry->gen == *gen) && (entry->procId == procId) &&
+                (strcmp(entry->name, name) == 0) &&
+                (strcmp(entry->instanceName, instanceName) == 0)) {
+            *value = entry->value;
+            found = TRUE;
+            break;
+        }
+    }
+
+    GateSwi_leave(NameServer_module->gate, key);
+
+    return (found);
+}
+
+/*
+ *  ======== ti_sdo_utils_NameServer_addCached ========
+ */
+Void ti_sdo_utils_NameServer_addCached(UInt16 procId, String instanceName,
+        String name, UInt32 value, Bits32 gen)
+{
+    ti_sdo_utils_NameServer_CacheEntry *entry;
+    IArg key;
+
+    if ((ti_sdo_utils_NameServer_remoteCacheSize == 0) ||
+            (strlen(instanceName) >= ti_sdo_utils_NameServer_CACHENAMELEN) ||
+            (strlen(name) >= ti_sdo_utils_NameServer_CACHENAMELEN)) {
+        return;
+    }
+
+    key = GateSwi_enter(NameServer_module->gate);
+
+    /*
+     *  Replace the oldest entry.  If the instance was flushed since 'gen'
+     *  was read the entry is stale the moment it's written, and
+     *  getCached never matches it.
+     */
+    entry = &NameServer_module->cache[NameServer_module->cacheNext];
+    if (++NameServer_module->cacheNext ==
+            ti_sdo_utils_NameServer_remoteCacheSize) {
+        NameServer_module->cacheNext = 0;
+    }
+
+    entry->procId = procId;
+    entry->value = value;
+    strcpy(entry->instanceName, instanceName);
+    strcpy(entry->name, name);
+    entry->gen = gen;
+
+    GateSwi_leave(NameServer_module->gate, key);
+}
+
+/*
+ *  ======== ti_sdo_utils_NameServer_cacheKey ========
+ */
+Bits32 ti_sdo_utils_NameServer_cacheKey(String instanceName)
+{
+    return (NameServer_hash(instanceName) & 0xFFFF);
+}
+
+/*
+ *  ======== ti_sdo_utils_NameServer_flushCached ========
+ */
+Void ti_sdo_utils_NameServer_flushCached(UInt16 procId, Bits32 instanceKey)
+{
+    volatile Bits32 *gen;
+    UInt first;
+    UInt num;
+    UInt key;
+    UInt i;
+
+    if (ti_sdo_utils_NameServer_remoteCacheSize == 0) {
+        return;
+    }
+
+    if (instanceKey == ti_sdo_utils_NameServer_ALLINSTANCES) {
+        first = NameServer_cacheGenIndex(procId, 0);
+        num = ti_sdo_utils_NameServer_CACHEGENS;
+    }
+    else {
+        first = NameServer_cacheGenIndex(procId, instanceKey);
+        num = 1;
+    }
+
+    /*
+     *  Entries are only valid for the generation they were added in.
+     *  Only the generations of this procId and instance move, what is
+     *  cached from other processors and instances stays valid.
+     */
+    key = Hwi_disable();
+
+    for (i = first; i < first + num; i++) {
+        gen = &NameServer_module->cacheGen[i];
+        if (++(*gen) == 0) {
+            *gen = 1;
+        }
+    }
+
+    Hwi_restore(key);
 }
 
 /*
@@ -984,10 +1207,31 @@ ti_sdo_utils_NameServer_TableEntry *NameServer_findLocal(
         ti_sdo_utils_NameServer_Object *obj, String name)
 {
     IArg  key;
+    UInt32 hash;
     ti_sdo_utils_NameServer_TableEntry *tableEntry = NULL;
 
     List_Handle nameList = ti_sdo_utils_NameServer_Instance_State_nameList(obj);
 
+    if (ti_sdo_utils_NameServer_hashIndex) {
+        /* Hash outside the gate, then only walk the name's bucket */
+        hash = NameServer_hash(name);
+
+        key = GateSwi_enter(NameServer_module->gate);
+
+        tableEntry = obj->buckets[hash & obj->hashMask];
+        while (tableEntry != NULL) {
+            if ((tableEntry->hash == hash) &&
+                    (strcmp(tableEntry->name, name) == 0)) {
+                break;
+            }
+            tableEntry = tableEntry->hashNext;
+        }
+
+        GateSwi_leave(NameServer_module->gate, key);
+
+        return (tableEntry);
+    }
+
     /* Search the table in a thread safe manner */
     key = GateSwi_enter(NameServer_module->gate);
 
@@ -1042,3 +1286,139 @@ Int ti_sdo_utils_NameServer_postInit(ti_sdo_utils_NameServer_Object *obj)
 
     return (0);
 }
+
+/*
+ *  ======== NameServer_hash ========
+ *  FNV-1a hash of a name.  NameServer.xs hashes the static names with the
+ *  same function.
+ */
+static UInt32 NameServer_hash(String name)
+{
+    UInt32 hash = 2166136261u;
+
+    while (*name != '\0') {
+        hash ^= (UInt8)*name++;
+        hash *= 16777619u;
+    }
+
+    return (hash);
+}
+
+/*
+ *  ======== NameServer_numBuckets ========
+ *  Smallest power of two not less than 'num'.
+ */
+static UInt NameServer_numBuckets(UInt num)
+{
+    UInt buckets = 1;
+
+    while (buckets < num) {
+        buckets <<= 1;
+    }
+
+    return (buckets);
+}
+
+/*
+ *  ======== NameServer_hashInsert ========
+ *  Put an entry at the head of its bucket.  Called in the NameServer gate.
+ */
+static Void NameServer_hashInsert(ti_sdo_utils_NameServer_Object *obj,
+        ti_sdo_utils_NameServer_TableEntry *entry)
+{
+    ti_sdo_utils_NameServer_TableEntry **bucket;
+
+    bucket = &obj->buckets[entry->hash & obj->hashMask];
+    entry->hashNext = *bucket;
+    *bucket = entry;
+}
+
+/*
+ *  ======== NameServer_hashRemove ========
+ *  Unlink an entry from its bucket.  Called in the NameServer gate.
+ */
+static Void NameServer_hashRemove(ti_sdo_utils_NameServer_Object *obj,
+        ti_sdo_utils_NameServer_TableEntry *entry)
+{
+    ti_sdo_utils_NameServer_TableEntry **link;
+
+    link = &obj->buckets[entry->hash & obj->hashMask];
+    while (*link != NULL) {
+        if (*link == entry) {
+            *link = entry->hashNext;
+            break;
+        }
+        link = &(*link)->hashNext;
+    }
+
+    entry->hashNext = NULL;
+}
+
+/*
+ *  ======== NameServer_cacheGenIndex ========
+ *  Index in cacheGen[] of the generation of 'procId' and 'instanceKey'.
+ */
+static UInt NameServer_cacheGenIndex(UInt16 procId, Bits32 instanceKey)
+{
+    UInt index = procId;
+
+    if (ti_sdo_utils_MultiProc_procAddrMode ==
+            ti_sdo_utils_MultiProc_ProcAddrMode_Cluster) {
+        index = procId - MultiProc_getBaseIdOfCluster();
+    }
+
+    Assert_isTrue(index < NameServer_module->nsRemoteHandle.length,
+            ti_sdo_utils_NameServer_A_invArgument);
+
+    return ((index * ti_sdo_utils_NameServer_CACHEGENS) +
+            (instanceKey & (ti_sdo_utils_NameServer_CACHEGENS - 1)));
+}
+
+/*
+ *  ======== NameServer_announceRemotes ========
+ *  Tell the remote processors that a name was added to instance
+ *  'instanceName', so those that remember misses forget it.
+ */
+static Void NameServer_announceRemotes(String instanceName, String name)
+{
+    INameServerRemote_Handle handle;
+    UInt16 i;
+
+    if ((ti_sdo_utils_NameServer_singleProcessor == TRUE) ||
+            (instanceName == NULL)) {
+        return;
+    }
+
+    for (i = 0; i < NameServer_module->nsRemoteHandle.length; i++) {
+        handle = NameServer_module->nsRemoteHandle.elem[i];
+        if (handle != NULL) {
+            INameServerRemote_announce(handle, instanceName, name);
+        }
+    }
+}
+
+/*
+ *  ======== NameServer_invalidateRemotes ========
+ *  Tell the remote processors that a name was removed from instance
+ *  'instanceName', so they drop what they cached from it.  Only done
+ *  with the remote cache enabled, which must then be enabled everywhere.
+ *  Unnamed instances can't be looked up remotely.
+ */
+static Void NameServer_invalidateRemotes(String instanceName)
+{
+    INameServerRemote_Handle handle;
+    UInt16 i;
+
+    if ((ti_sdo_utils_NameServer_singleProcessor == TRUE) ||
+            (ti_sdo_utils_NameServer_remoteCacheSize == 0) ||
+            (instanceName == NULL)) {
+        return;
+    }
+
+    for (i = 0; i < NameServer_module->nsRemoteHandle.length; i++) {
+        handle = NameServer_module->nsRemoteHandle.elem[i];
+        if (handle != NULL) {
+            INameServerRemote_invalidate(handle, instanceName);
+        }
+    }
+}
@@ -105,6 +105,24 @@ function module$static$init(state, mod)
 
     /* Gate for all NameServer critical regions */
     state.gate = GateSwi.create();
+
+    /* Remote cache, all entries free */
+    state.cache.length = NameServer.remoteCacheSize;
+    for (var i = 0; i < state.cache.length; i++) {
+        state.cache[i].gen = 0;
+        state.cache[i].procId = 0;
+        state.cache[i].value = 0;
+        for (var j = 0; j < NameServer.CACHENAMELEN; j++) {
+            state.cache[i].instanceName[j] = 0;
+            state.cache[i].name[j] = 0;
+        }
+    }
+    state.cacheNext = 0;
+    state.cacheGen.length = (NameServer.remoteCacheSize == 0) ? 0 :
+            state.nsRemoteHandle.length * NameServer.CACHEGENS;
+    for (var i = 0; i < state.cacheGen.length; i++) {
+        state.cacheGen[i] = 1;
+    }
 }
 
 /*
@@ -168,6 +186,8 @@ function instance$static$init(obj, name, params)
         obj.table[index].name  = this.metaTable[index].name;
         obj.table[index].len   = this.metaTable[index].len;
         obj.table[index].value = this.metaTable[index].value;
+        obj.table[index].hashNext = null;
+        obj.table[index].hash  = hashName(obj.table[index].name);
         obj.nameList.putMeta(obj.table[index].elem);
     }
 
@@ -190,6 +210,8 @@ function instance$static$init(obj, name, params)
         obj.table[index].name  = NameServer.metaModTable[name][k].name;
         obj.table[index].len   = NameServer.metaModTable[name][k].len;
         obj.table[index].value = NameServer.metaModTable[name][k].value;
+        obj.table[index].hashNext = null;
+        obj.table[index].hash  = hashName(obj.table[index].name);
         obj.nameList.putMeta(obj.table[index].elem);
         index++;
     }
@@ -230,10 +252,77 @@ function instance$static$init(obj, name, params)
             obj.table[j].name  = null;
             obj.table[j].len   = 0;
             obj.table[j].value = 0;
+            obj.table[j].hashNext = null;
+            obj.table[j].hash  = 0;
             obj.freeList.putMeta(obj.table[j].elem);
         }
     }
     Memory.staticPlace(obj.table,  0, params.tableSection);
+
+    /* Index the static entries, the runtime ones are added as they come */
+    if (NameServer.hashIndex == true) {
+        if (params.maxRuntimeEntries == NameServer.ALLOWGROWTH) {
+            obj.buckets.length = numBuckets(numStatic +
+                NameServer.growthHashBuckets);
+        }
+        else {
+            obj.buckets.length = numBuckets(numStatic +
+                params.maxRuntimeEntries);
+        }
+        obj.hashMask = obj.buckets.length - 1;
+
+        for (var b = 0; b < obj.buckets.length; b++) {
+            obj.buckets[b] = null;
+        }
+
+        /* Insert at the head of the bucket, like NameServer_add does */
+        for (var i = 0; i < numStatic; i++) {
+            var b = obj.table[i].hash & obj.hashMask;
+            obj.table[i].hashNext = obj.buckets[b];
+            obj.buckets[b] = obj.table[i];
+        }
+
+        Memory.staticPlace(obj.buckets, 0, params.tableSection);
+    }
+    else {
+        obj.buckets.length = 0;
+        obj.hashMask = 0;
+    }
+}
+
+/*
+ *  ======== hashName ========
+ *  FNV-1a hash of a name, must match NameServer_hash() in NameServer.c.
+ *  The multiply by the FNV prime is done with shifts so the result stays
+ *  exact in a double.
+ */
+function hashName(name)
+{
+    var hash = 2166136261;
+
+    for (var i = 0; i < name.length; i++) {
+        hash = (hash ^ (name.charCodeAt(i) & 0xFF)) >>> 0;
+        hash = (hash + (hash << 1) + (hash << 4) + (hash << 7) +
+                (hash << 8) + (hash << 24)) >>> 0;
+    }
+
+    return (hash);
+}
+
+/*
+ *  ======== numBuckets ========
+ *  Smallest power of two not less than 'num', must match
+ *  NameServer_numBuckets() in NameServer.c.
+ */
+function numBuckets(num)
+{
+    var buckets = 1;
+
+    while (buckets < num) {
+        buckets *= 2;
+    }
+
+    return (buckets);
 }
 
 /*
@@ -90,6 +90,22 @@ Int NameServerRemoteNull_get(NameServerRemoteNull_Object *obj,
     return (NameServer_S_SUCCESS);
 }
 
+/*
+ *  ======== NameServerRemoteNull_invalidate ========
+ */
+Void NameServerRemoteNull_invalidate(NameServerRemoteNull_Object *obj,
+        String instanceName)
+{
+}
+
+/*
+ *  ======== NameServerRemoteNull_announce ========
+ */
+Void NameServerRemoteNull_announce(NameServerRemoteNull_Object *obj,
+        String instanceName, String name)
+{
+}
+
 /*
  *  ======== NameServerRemoteNull_sharedMemReq ========
  */
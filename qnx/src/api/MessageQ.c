@@ -191,6 +191,13 @@ typedef struct {
     MessageQ_QueueIndex queueIndex;
 } MessageQ_Params_Version2;
 
+typedef struct {
+    Int __version;
+    Void *synchronizer;
+    MessageQ_QueueIndex queueIndex;
+    Bool syncRegister;
+} MessageQ_Params_Version3;
+
 /* structure for MessageQ module state */
 typedef struct MessageQ_ModuleObject {
     Int                 refCount;
@@ -350,6 +357,7 @@ Void MessageQ_Params_init(MessageQ_Params *params)
 Void MessageQ_Params_init__S(MessageQ_Params *params, Int version)
 {
     MessageQ_Params_Version2 *params2;
+    MessageQ_Params_Version3 *params3;
 
     switch (version) {
 
@@ -360,6 +368,14 @@ Void MessageQ_Params_init__S(MessageQ_Params *params, Int version)
             params2->queueIndex = MessageQ_ANY;
             break;
 
+        case MessageQ_Params_VERSION_3:
+            params3 = (MessageQ_Params_Version3 *)params;
+            params3->__version = MessageQ_Params_VERSION_3;
+            params3->synchronizer = NULL;
+            params3->queueIndex = MessageQ_ANY;
+            params3->syncRegister = FALSE;
+            break;
+
         default:
             assert(FALSE);
             break;
@@ -398,6 +414,12 @@ MessageQ_Handle MessageQ_create (String name, const MessageQ_Params * pp)
             ps.synchronizer = ((MessageQ_Params_Version2 *)pp)->synchronizer;
             ps.queueIndex = ((MessageQ_Params_Version2 *)pp)->queueIndex;
         }
+        else if (pp->__version == MessageQ_Params_VERSION_3) {
+            ps.__version = ((MessageQ_Params_Version3 *)pp)->__version;
+            ps.synchronizer = ((MessageQ_Params_Version3 *)pp)->synchronizer;
+            ps.queueIndex = ((MessageQ_Params_Version3 *)pp)->queueIndex;
+            ps.syncRegister = ((MessageQ_Params_Version3 *)pp)->syncRegister;
+        }
         else {
             assert(FALSE);
         }
@@ -733,6 +755,25 @@ MessageQ_Msg MessageQ_alloc (UInt16 heapId, UInt32 size)
     return msg;
 }
 
+/* Allocate num messages, all or none. */
+Int MessageQ_allocN (UInt16 heapId, UInt32 size, MessageQ_Msg msgs[],
+                     UInt num)
+{
+    UInt i;
+
+    for (i = 0; i < num; i++) {
+        msgs[i] = MessageQ_alloc (heapId, size);
+        if (msgs[i] == NULL) {
+            while (i > 0) {
+                MessageQ_free (msgs[--i]);
+            }
+            return MessageQ_E_MEMORY;
+        }
+    }
+
+    return MessageQ_S_SUCCESS;
+}
+
 /* Frees the message back to the heap that was used to allocate it. */
 Int MessageQ_free (MessageQ_Msg msg)
 {
@@ -303,6 +303,12 @@ static void NameServerRemote_processMessage(NameServerRemote_Msg * msg, UInt16 p
 
         pthread_mutex_unlock(&NameServer_module->modGate);
     }
+    else if (msg->request == NAMESERVER_ANNOUNCE) {
+        /* remote added a name, we don't cache misses */
+        GT_2trace(curTrace, GT_1CLASS, "NameServer Announce: "
+                  "instanceName: %s, name: %s",
+                  (String)msg->instanceName, (String)msg->name);
+    }
     else {
         GT_3trace(curTrace, GT_1CLASS, "NameServer Reply: instanceName: %s, "
              "name: %s, value: 0x%x", (String)msg->instanceName,